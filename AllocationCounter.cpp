@@ -0,0 +1,125 @@
+/**
+ * @file AllocationCounter.cpp
+ * @brief This file contains the implementation of the AllocationCounter class and the counting
+ * replacements of the global operator new and delete.
+ */
+
+#include "AllocationCounter.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<uint64_t> allocations(0);
+std::atomic<uint64_t> bytes(0);
+
+void* allocate(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* allocateAligned(std::size_t size, std::align_val_t alignment) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    bytes.fetch_add(size, std::memory_order_relaxed);
+    std::size_t align = static_cast<std::size_t>(alignment);
+    return std::aligned_alloc(align, (size + align - 1) / align * align);   // size must be a multiple
+}
+}
+
+AllocationCounter::AllocationCounter() {
+    restart();
+}
+
+void AllocationCounter::restart() {
+    start_allocations_ = getTotalAllocations();
+    start_bytes_ = getTotalBytes();
+}
+
+uint64_t AllocationCounter::getAllocations() const {
+    return getTotalAllocations() - start_allocations_;
+}
+
+uint64_t AllocationCounter::getBytes() const {
+    return getTotalBytes() - start_bytes_;
+}
+
+uint64_t AllocationCounter::getTotalAllocations() {
+    return allocations.load(std::memory_order_relaxed);
+}
+
+uint64_t AllocationCounter::getTotalBytes() {
+    return bytes.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size) {
+    void* memory = allocate(size);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return allocate(size);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+    void* memory = allocateAligned(size, alignment);
+    if (memory == nullptr) {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+    return operator new(size, alignment);
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+    std::free(memory);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file AllocationCounter.hpp
+ * @brief This file contains the declaration of the AllocationCounter class, which counts heap
+ * allocations made through operator new.
+ *
+ * AllocationCounter.cpp replaces the global operator new and delete with versions that count each
+ * allocation before calling malloc. It is not part of the library: only the tools that want the
+ * counts link it, so the kitchen itself pays nothing. A counter reads the process-wide totals when
+ * it starts, so a benchmark can give every phase its own counter.
+ */
+
+#ifndef ALLOCATIONCOUNTER_HPP
+#define ALLOCATIONCOUNTER_HPP
+
+#include <cstdint>
+
+class AllocationCounter {
+public:
+    /**
+     * Default constructor.
+     * Starts counting from the current totals.
+     */
+    AllocationCounter();
+
+    /**
+     * Starts counting again from the current totals.
+     */
+    void restart();
+
+    /**
+     * @return The number of allocations since construction or the last restart().
+     */
+    uint64_t getAllocations() const;
+
+    /**
+     * @return The bytes requested by those allocations.
+     */
+    uint64_t getBytes() const;
+
+    /**
+     * @return The number of allocations made by the process so far, on every thread.
+     */
+    static uint64_t getTotalAllocations();
+
+    /**
+     * @return The bytes requested by those allocations.
+     */
+    static uint64_t getTotalBytes();
+
+private:
+    uint64_t start_allocations_;
+    uint64_t start_bytes_;
+};
+
+#endif // ALLOCATIONCOUNTER_HPP
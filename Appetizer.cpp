@@ -208,4 +208,14 @@ void Appetizer::dietaryAccommodations(const DietaryRequest &request)
         // Set the modified ingredients back, assuming you have a setter or similar method
         setIngredients(ingredients);
     }
-}
\ No newline at end of file
+}
+
+MemoryUsage Appetizer::memoryUsage() const {
+    MemoryUsage usage = Dish::memoryUsage();
+    usage.objects += sizeof(Appetizer) - sizeof(Dish);
+    return usage;
+}
+
+Appetizer* Appetizer::clone() const {
+    return new Appetizer(*this);
+}
@@ -102,6 +102,16 @@ public:
 */
     void dietaryAccommodations(const DietaryRequest &request) override;
 
+    /**
+     * @return The memory used by the appetizer, including its own members.
+     */
+    MemoryUsage memoryUsage() const override;
+
+    /**
+     * @return A copy of the appetizer, which the caller owns.
+     */
+    Appetizer* clone() const override;
+
 private:
     ServingStyle serving_style_; ///< The serving style of the appetizer.
     int spiciness_level_; ///< The spiciness level of the appetizer.
@@ -0,0 +1,115 @@
+/**
+ * @file AsyncEventSink.cpp
+ * @brief This file contains the implementation of the AsyncEventSink class.
+ */
+
+#include "AsyncEventSink.hpp"
+#include <chrono>
+
+namespace {
+// How long the writer sleeps when the ring is empty
+const std::chrono::microseconds IDLE_WAIT(50);
+
+size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+}
+
+AsyncEventSink::AsyncEventSink(std::ostream& out, size_t capacity, OverflowPolicy policy)
+    : out_(out), policy_(policy), slots_(roundUpToPowerOfTwo(capacity < 2 ? 2 : capacity)), mask_(slots_.size() - 1),
+      head_(0), cached_tail_(0), recorded_(0), dropped_(0), blocked_(0), tail_(0), flush_requests_(0),
+      flushes_done_(0), stopping_(false), writer_(&AsyncEventSink::run, this) {
+}
+
+AsyncEventSink::~AsyncEventSink() {
+    flush();
+    stopping_.store(true, std::memory_order_release);
+    writer_.join();
+}
+
+void AsyncEventSink::record(const KitchenEvent& event) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - cached_tail_ > mask_) {
+        cached_tail_ = tail_.load(std::memory_order_acquire);
+        if (head - cached_tail_ > mask_) {
+            if (policy_ == DROP) {
+                ++dropped_;
+                return;
+            }
+            ++blocked_;
+            while (head - cached_tail_ > mask_) {
+                std::this_thread::yield();
+                cached_tail_ = tail_.load(std::memory_order_acquire);
+            }
+        }
+    }
+    slots_[head & mask_] = event;
+    head_.store(head + 1, std::memory_order_release);
+    ++recorded_;
+}
+
+void AsyncEventSink::flush() {
+    uint64_t request = flush_requests_.fetch_add(1, std::memory_order_acq_rel) + 1;
+    while (flushes_done_.load(std::memory_order_acquire) < request) {
+        std::this_thread::yield();
+    }
+}
+
+uint64_t AsyncEventSink::getRecordedCount() const {
+    return recorded_;
+}
+
+uint64_t AsyncEventSink::getDroppedCount() const {
+    return dropped_;
+}
+
+uint64_t AsyncEventSink::getBlockedCount() const {
+    return blocked_;
+}
+
+size_t AsyncEventSink::getCapacity() const {
+    return slots_.size();
+}
+
+AsyncEventSink::OverflowPolicy AsyncEventSink::getPolicy() const {
+    return policy_;
+}
+
+// The writer thread: drains the ring, then serves flush requests, then sleeps until there is more
+void AsyncEventSink::run() {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    bool written = false;   // lines written since the last flush of the stream
+    while (true) {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        if (tail != head) {
+            for (; tail != head; ++tail) {
+                formatEvent(out_, slots_[tail & mask_], false);
+            }
+            tail_.store(tail, std::memory_order_release);
+            written = true;
+            continue;
+        }
+
+        // A flush request covers every event recorded before it, so look at the ring once more
+        uint64_t requested = flush_requests_.load(std::memory_order_acquire);
+        if (head_.load(std::memory_order_acquire) != tail) {
+            continue;
+        }
+        if (written) {
+            out_.flush();
+            written = false;
+        }
+        if (flushes_done_.load(std::memory_order_relaxed) != requested) {
+            flushes_done_.store(requested, std::memory_order_release);
+            continue;
+        }
+        if (stopping_.load(std::memory_order_acquire)) {
+            break;
+        }
+        std::this_thread::sleep_for(IDLE_WAIT);
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ * @file AsyncEventSink.hpp
+ * @brief This file contains the declaration of the AsyncEventSink class, which moves the formatting
+ * and writing of the preparation log off the dispatch thread.
+ *
+ * record() copies the event into a single-producer single-consumer ring and returns; a writer
+ * thread owned by the sink pops the records, formats them with formatEvent() and writes them to the
+ * stream. The text is the same, line for line, as a TextEventSink would write, but the writer only
+ * flushes the stream when the ring runs dry or flush() asks, not after every line. As in
+ * OrderRing, only the dispatch thread writes the head index and only the writer writes the tail
+ * index, so a record costs one release store and no lock.
+ *
+ * The writer reads the station and dish names after record() has returned, so the stations and
+ * dishes of the recorded events must not be renamed or destroyed until flush() has returned.
+ */
+
+#ifndef ASYNCEVENTSINK_HPP
+#define ASYNCEVENTSINK_HPP
+
+#include "EventSink.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+class AsyncEventSink : public EventSink {
+public:
+    /**
+     * What record() does when the writer has fallen a whole ring behind.
+     */
+    enum OverflowPolicy {
+        BLOCK,   // wait for the writer to make room; every event is written
+        DROP     // discard the event and count it; dispatch never waits
+    };
+
+    /**
+     * Parameterized constructor. Starts the writer thread.
+     * @param out The stream that receives the log; it must outlive the sink and must not be written
+     * by anyone else while the sink is alive.
+     * @param capacity The number of events the ring holds; rounded up to a power of two.
+     * @param policy What to do when the ring is full.
+     */
+    AsyncEventSink(std::ostream& out, size_t capacity = 65536, OverflowPolicy policy = BLOCK);
+
+    /**
+     * Destructor.
+     * @post Writes every event still in the ring, flushes the stream and joins the writer thread.
+     */
+    ~AsyncEventSink();
+
+    AsyncEventSink(const AsyncEventSink&) = delete;
+    AsyncEventSink& operator=(const AsyncEventSink&) = delete;
+
+    /**
+     * Queues an event for the writer. Must only be called by one thread at a time.
+     * @param event The event.
+     */
+    void record(const KitchenEvent& event) override;
+
+    /**
+     * Waits until every event recorded so far has been written and the stream flushed.
+     * Must be called by the thread that records.
+     */
+    void flush();
+
+    /**
+     * @return The number of events that were queued.
+     */
+    uint64_t getRecordedCount() const;
+
+    /**
+     * @return The number of events discarded because the ring was full (DROP only).
+     */
+    uint64_t getDroppedCount() const;
+
+    /**
+     * @return The number of events that had to wait for room in the ring (BLOCK only).
+     */
+    uint64_t getBlockedCount() const;
+
+    /**
+     * @return The number of events the ring holds.
+     */
+    size_t getCapacity() const;
+
+    /**
+     * @return The overflow policy.
+     */
+    OverflowPolicy getPolicy() const;
+
+private:
+    void run();
+
+    std::ostream& out_;
+    OverflowPolicy policy_;
+    std::vector<KitchenEvent> slots_;
+    size_t mask_;
+    alignas(64) std::atomic<uint64_t> head_;   // next slot the dispatch thread writes
+    uint64_t cached_tail_;                     // dispatch thread's last view of tail
+    uint64_t recorded_;
+    uint64_t dropped_;
+    uint64_t blocked_;
+    alignas(64) std::atomic<uint64_t> tail_;   // next slot the writer reads
+    alignas(64) std::atomic<uint64_t> flush_requests_;
+    std::atomic<uint64_t> flushes_done_;
+    std::atomic<bool> stopping_;
+    std::thread writer_;
+};
+
+#endif // ASYNCEVENTSINK_HPP
@@ -0,0 +1,96 @@
+/**
+ * @file DemandForecast.cpp
+ * @brief This file contains the implementation of the DemandForecast class.
+ */
+
+#include "DemandForecast.hpp"
+#include "MemoryUsage.hpp"
+#include <cmath>
+
+namespace {
+const double LN2 = 0.6931471805599453;
+}
+
+DemandForecast::DemandForecast(double half_life_seconds) : half_life_seconds_(half_life_seconds) {
+}
+
+void DemandForecast::setHalfLife(double half_life_seconds) {
+    half_life_seconds_ = half_life_seconds;
+}
+
+double DemandForecast::getHalfLife() const {
+    return half_life_seconds_;
+}
+
+void DemandForecast::recordDish(const std::string& dish_name, int64_t now_ms) {
+    add(dishes_[dish_name], 1.0, now_ms);
+}
+
+void DemandForecast::recordIngredient(const KitchenStation* station, IngredientId id, int units, int64_t now_ms) {
+    if (units > 0) {
+        add(ingredients_[station][id], units, now_ms);
+    }
+}
+
+void DemandForecast::forget(const KitchenStation* station) {
+    ingredients_.erase(station);
+}
+
+double DemandForecast::getDishRate(const std::string& dish_name, int64_t now_ms) const {
+    auto found = dishes_.find(dish_name);
+    return found == dishes_.end() ? 0.0 : rate(found->second, now_ms);
+}
+
+double DemandForecast::getIngredientRate(const KitchenStation* station, IngredientId id, int64_t now_ms) const {
+    auto station_estimates = ingredients_.find(station);
+    if (station_estimates == ingredients_.end()) {
+        return 0.0;
+    }
+    auto found = station_estimates->second.find(id);
+    return found == station_estimates->second.end() ? 0.0 : rate(found->second, now_ms);
+}
+
+std::vector<IngredientNeed> DemandForecast::project(double horizon_seconds, int64_t now_ms) const {
+    std::vector<IngredientNeed> needs;
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    for (const auto& station_estimates : ingredients_) {
+        for (const auto& entry : station_estimates.second) {
+            double units = rate(entry.second, now_ms) * horizon_seconds;
+            if (units > 0.0) {
+                needs.push_back(IngredientNeed{station_estimates.first, registry.getName(entry.first), units, 0});
+            }
+        }
+    }
+    return needs;
+}
+
+// Decays the weight to now, then adds the new units
+void DemandForecast::add(Estimator& estimator, double units, int64_t now_ms) const {
+    if (estimator.weight > 0.0 && now_ms > estimator.last_ms) {
+        double elapsed_seconds = (now_ms - estimator.last_ms) / 1000.0;
+        estimator.weight *= std::exp(-LN2 * elapsed_seconds / half_life_seconds_);
+    }
+    estimator.weight += units;
+    if (now_ms > estimator.last_ms) {
+        estimator.last_ms = now_ms;
+    }
+}
+
+double DemandForecast::rate(const Estimator& estimator, int64_t now_ms) const {
+    double weight = estimator.weight;
+    if (now_ms > estimator.last_ms) {
+        weight *= std::exp(-LN2 * ((now_ms - estimator.last_ms) / 1000.0) / half_life_seconds_);
+    }
+    return weight * LN2 / half_life_seconds_;
+}
+
+size_t DemandForecast::memoryUsage() const {
+    size_t bytes = hashBytes(dishes_) + hashBytes(ingredients_);
+    for (const auto& dish : dishes_) {
+        bytes += heapBytes(dish.first);
+    }
+    for (const auto& station_estimates : ingredients_) {
+        bytes += hashBytes(station_estimates.second);
+    }
+    return bytes;
+}
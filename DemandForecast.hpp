@@ -0,0 +1,116 @@
+/**
+ * @file DemandForecast.hpp
+ * @brief This file contains the declaration of the DemandForecast class, exponentially weighted
+ * demand estimators per dish and per (station, ingredient).
+ *
+ * Each estimator is a decayed event count: an event adds its units, and the total halves every
+ * half-life. Dividing by the mean age of the weights (half-life / ln 2) gives a rate in units per
+ * second that follows recent demand and forgets old demand smoothly. Updating an estimator is one
+ * exp() call; nothing else is stored.
+ */
+
+#ifndef DEMANDFORECAST_HPP
+#define DEMANDFORECAST_HPP
+
+#include "IngredientRegistry.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class KitchenStation;
+
+/**
+ * @struct IngredientNeed
+ * @brief The projected use of an ingredient at a station over a horizon.
+ */
+struct IngredientNeed {
+    const KitchenStation* station;
+    std::string ingredient_name;
+    double units;      // projected units used over the horizon
+    int on_hand;       // units the station holds now
+};
+
+class DemandForecast {
+public:
+    /**
+     * Parameterized constructor.
+     * @param half_life_seconds How long it takes for an event's weight to halve.
+     */
+    explicit DemandForecast(double half_life_seconds = 300.0);
+
+    /**
+     * @param half_life_seconds The new half-life. Existing estimates are kept.
+     */
+    void setHalfLife(double half_life_seconds);
+
+    /**
+     * @return The half-life in seconds.
+     */
+    double getHalfLife() const;
+
+    /**
+     * Records a filled order.
+     * @param dish_name The name of the dish.
+     * @param now_ms The current time in milliseconds on a monotonic clock.
+     */
+    void recordDish(const std::string& dish_name, int64_t now_ms);
+
+    /**
+     * Records ingredient use at a station.
+     * @param station The station.
+     * @param id The ingredient.
+     * @param units The units used.
+     * @param now_ms The current time in milliseconds.
+     */
+    void recordIngredient(const KitchenStation* station, IngredientId id, int units, int64_t now_ms);
+
+    /**
+     * Drops the estimates of a station.
+     * @param station The station.
+     */
+    void forget(const KitchenStation* station);
+
+    /**
+     * @param dish_name The name of a dish.
+     * @param now_ms The current time in milliseconds.
+     * @return The estimated orders per second filled for the dish.
+     */
+    double getDishRate(const std::string& dish_name, int64_t now_ms) const;
+
+    /**
+     * @param station The station.
+     * @param id The ingredient.
+     * @param now_ms The current time in milliseconds.
+     * @return The estimated units per second the station uses.
+     */
+    double getIngredientRate(const KitchenStation* station, IngredientId id, int64_t now_ms) const;
+
+    /**
+     * Projects ingredient use at the current rates.
+     * @param horizon_seconds The length of the projection.
+     * @param now_ms The current time in milliseconds.
+     * @return One entry per (station, ingredient) with a non-zero rate. on_hand is left at 0.
+     */
+    std::vector<IngredientNeed> project(double horizon_seconds, int64_t now_ms) const;
+
+    /**
+     * @return The heap bytes held by the estimators, estimated as in MemoryUsage.hpp.
+     */
+    size_t memoryUsage() const;
+
+private:
+    struct Estimator {
+        double weight = 0.0;   // decayed sum of units as of last_ms
+        int64_t last_ms = 0;
+    };
+
+    void add(Estimator& estimator, double units, int64_t now_ms) const;
+    double rate(const Estimator& estimator, int64_t now_ms) const;
+
+    double half_life_seconds_;
+    std::unordered_map<std::string, Estimator> dishes_;
+    std::unordered_map<const KitchenStation*, std::unordered_map<IngredientId, Estimator>> ingredients_;
+};
+
+#endif // DEMANDFORECAST_HPP
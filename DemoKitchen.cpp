@@ -0,0 +1,54 @@
+/**
+ * @file DemoKitchen.cpp
+ * @brief This file contains the implementation of the DemoKitchen class.
+ */
+
+#include "DemoKitchen.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+
+DemoKitchen::DemoKitchen(int pantry_units) {
+    stations_.push_back(new KitchenStation("Grill Station"));
+    stations_.push_back(new KitchenStation("Pasta Station"));
+    stations_.push_back(new KitchenStation("Pastry Station"));
+    for (KitchenStation* station : stations_) {
+        manager_.addStation(station);
+    }
+
+    manager_.assignDishToStation("Grill Station", new MainCourse("Grilled Chicken",
+        {Ingredient("Chicken", 0, 1, 2.0), Ingredient("Spices", 0, 1, 0.5)}, 15, 10.99,
+        Dish::AMERICAN, MainCourse::GRILLED, "Chicken", {{"Fries", MainCourse::STARCHES}}, false));
+    manager_.assignDishToStation("Grill Station", new Appetizer("Chicken Wings",
+        {Ingredient("Chicken", 0, 2, 2.0), Ingredient("Spices", 0, 1, 0.5)}, 10, 7.99,
+        Dish::AMERICAN, Appetizer::FAMILY_STYLE, 3, false));
+    manager_.assignDishToStation("Pasta Station", new MainCourse("Spaghetti Bolognese",
+        {Ingredient("Spaghetti", 0, 1, 1.5), Ingredient("Tomato Sauce", 0, 1, 0.75), Ingredient("Beef", 0, 1, 3.0)}, 20, 12.99,
+        Dish::ITALIAN, MainCourse::BOILED, "Beef", {{"Garlic Bread", MainCourse::BREAD}}, false));
+    manager_.assignDishToStation("Pasta Station", new Appetizer("Bruschetta",
+        {Ingredient("Bread", 0, 1, 0.5), Ingredient("Tomato", 0, 2, 0.25)}, 5, 6.49,
+        Dish::ITALIAN, Appetizer::PLATED, 0, true));
+    manager_.assignDishToStation("Pastry Station", new Dessert("Tiramisu",
+        {Ingredient("Mascarpone", 0, 1, 2.5), Ingredient("Coffee", 0, 1, 0.5), Ingredient("Ladyfingers", 0, 4, 0.2)}, 30, 8.49,
+        Dish::ITALIAN, Dessert::SWEET, 7, false));
+
+    const char* pantry[] = {"Chicken", "Spices", "Spaghetti", "Tomato Sauce", "Beef", "Bread", "Tomato",
+                            "Mascarpone", "Coffee", "Ladyfingers"};
+    for (const char* ingredient : pantry) {
+        manager_.addBackupIngredient(Ingredient(ingredient, pantry_units, 0, 1.0));
+    }
+}
+
+DemoKitchen::~DemoKitchen() {
+    for (KitchenStation* station : stations_) {
+        delete station;
+    }
+}
+
+StationManager& DemoKitchen::getManager() {
+    return manager_;
+}
+
+std::vector<std::string> DemoKitchen::getDishNames() {
+    return {"Grilled Chicken", "Chicken Wings", "Spaghetti Bolognese", "Bruschetta", "Tiramisu"};
+}
@@ -0,0 +1,45 @@
+/**
+ * @file DemoKitchen.hpp
+ * @brief This file contains the declaration of the DemoKitchen class, a small fully stocked kitchen
+ * used by the order server and the benchmarks.
+ */
+
+#ifndef DEMOKITCHEN_HPP
+#define DEMOKITCHEN_HPP
+
+#include "StationManager.hpp"
+
+class DemoKitchen {
+public:
+    /**
+     * Parameterized constructor.
+     * Builds a grill, a pasta and a pastry station with five dishes between them.
+     * @param pantry_units The backup quantity of every ingredient the menu uses.
+     */
+    DemoKitchen(int pantry_units = 1 << 30);
+
+    /**
+     * Destructor.
+     * @post: Deallocates the stations (and through them, their dishes).
+     */
+    ~DemoKitchen();
+
+    DemoKitchen(const DemoKitchen&) = delete;
+    DemoKitchen& operator=(const DemoKitchen&) = delete;
+
+    /**
+     * @return The station manager of the kitchen.
+     */
+    StationManager& getManager();
+
+    /**
+     * @return The names of the dishes on the menu, in catalog ID order.
+     */
+    static std::vector<std::string> getDishNames();
+
+private:
+    StationManager manager_;
+    std::vector<KitchenStation*> stations_;
+};
+
+#endif // DEMOKITCHEN_HPP
@@ -200,4 +200,14 @@ void Dessert::dietaryAccommodations(const DietaryRequest &request)
     }
 
     
-}
\ No newline at end of file
+}
+
+MemoryUsage Dessert::memoryUsage() const {
+    MemoryUsage usage = Dish::memoryUsage();
+    usage.objects += sizeof(Dessert) - sizeof(Dish);
+    return usage;
+}
+
+Dessert* Dessert::clone() const {
+    return new Dessert(*this);
+}
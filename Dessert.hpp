@@ -103,6 +103,16 @@ public:
     */
     void dietaryAccommodations(const DietaryRequest &request) override;
 
+    /**
+     * @return The memory used by the dessert, including its own members.
+     */
+    MemoryUsage memoryUsage() const override;
+
+    /**
+     * @return A copy of the dessert, which the caller owns.
+     */
+    Dessert* clone() const override;
+
 private:
     FlavorProfile flavor_profile_; ///< The flavor profile of the dessert.
     int sweetness_level_; ///< The sweetness level of the dessert.
@@ -1,23 +1,59 @@
 #include "Dish.hpp"
 
+namespace {
+std::vector<RecipeLine> toRecipeLines(const std::vector<Ingredient>& ingredients) {
+    std::vector<RecipeLine> lines;
+    lines.reserve(ingredients.size());
+    for (const Ingredient& ingredient : ingredients) {
+        lines.push_back(toRecipeLine(ingredient));
+    }
+    return lines;
+}
+}
+
+RecipeLine toRecipeLine(const Ingredient& ingredient) {
+    return RecipeLine{IngredientRegistry::instance().intern(ingredient.name), ingredient.required_quantity};
+}
+
+StockLine toStockLine(const Ingredient& ingredient) {
+    return StockLine{IngredientRegistry::instance().intern(ingredient.name), ingredient.quantity, ingredient.getPriceMoney()};
+}
+
+Ingredient toIngredient(const RecipeLine& line) {
+    return Ingredient(IngredientRegistry::instance().getName(line.id), 0, line.required, Money());
+}
+
+Ingredient toIngredient(const StockLine& line) {
+    return Ingredient(IngredientRegistry::instance().getName(line.id), line.quantity, 0, line.price);
+}
+
 // Default Constructor
 Dish::Dish() 
-    : name_("UNKNOWN"), ingredients_({}), prep_time_(0), price_(0.0), cuisine_type_(CuisineType::OTHER) {
+    : name_("UNKNOWN"), recipe_(), prep_time_(0), price_(), cuisine_type_(CuisineType::OTHER) {
 }
 
 // Parameterized Constructor
 Dish::Dish(const std::string& name, const std::vector<Ingredient>& ingredients, int prep_time, double price, CuisineType cuisine_type)
-    : ingredients_(ingredients), prep_time_(prep_time), price_(price), cuisine_type_(cuisine_type) {
+    : recipe_(toRecipeLines(ingredients)), prep_time_(prep_time), price_(Money::fromDollars(price)), cuisine_type_(cuisine_type) {
     setName(name);  // Use setName to validate the name
 }
 
 // Accessor Functions
-std::string Dish::getName() const {
+const std::string& Dish::getName() const {
     return name_;
 }
 
 std::vector<Ingredient> Dish::getIngredients() const {
-    return ingredients_;
+    std::vector<Ingredient> ingredients;
+    ingredients.reserve(recipe_.size());
+    for (const RecipeLine& line : recipe_) {
+        ingredients.push_back(toIngredient(line));
+    }
+    return ingredients;
+}
+
+const std::vector<RecipeLine>& Dish::getRecipeLines() const {
+    return recipe_;
 }
 
 int Dish::getPrepTime() const {
@@ -25,6 +61,10 @@ int Dish::getPrepTime() const {
 }
 
 double Dish::getPrice() const {
+    return price_.toDollars();
+}
+
+Money Dish::getPriceMoney() const {
     return price_;
 }
 
@@ -50,7 +90,11 @@ void Dish::setName(const std::string& name) {
 }
 
 void Dish::setIngredients(const std::vector<Ingredient>& ingredients) {
-    ingredients_ = ingredients;
+    recipe_ = toRecipeLines(ingredients);
+}
+
+void Dish::setRecipeLines(const std::vector<RecipeLine>& recipe) {
+    recipe_ = recipe;
 }
 
 void Dish::setPrepTime(const int& prep_time) {
@@ -58,6 +102,10 @@ void Dish::setPrepTime(const int& prep_time) {
 }
 
 void Dish::setPrice(const double& price) {
+    price_ = Money::fromDollars(price);
+}
+
+void Dish::setPrice(const Money& price) {
     price_ = price;
 }
 
@@ -98,4 +146,16 @@ bool Dish::operator==(const Dish& rhs) const {
 
 bool Dish::operator!=(const Dish& rhs) const {
     return !(*this == rhs);
-}
\ No newline at end of file
+}
+
+MemoryUsage Dish::memoryUsage() const {
+    MemoryUsage usage;
+    usage.objects = sizeof(Dish);
+    usage.strings = heapBytes(name_);
+    usage.ingredients = heapBytes(recipe_);   // Names live once in the IngredientRegistry
+    return usage;
+}
+
+Dish* Dish::clone() const {
+    return nullptr;
+}
@@ -6,6 +6,10 @@
 #include <iostream>
 #include <iomanip> // For std::fixed and std::setprecision
 #include <cctype>  // For std::isalpha, std::isspace
+#include "Money.hpp"
+#include "MemoryUsage.hpp"
+#include "IngredientRegistry.hpp"
+#include "Inventory.hpp"
 
 /**
  * Struct representing an ingredient.
@@ -20,7 +24,53 @@ struct Ingredient {
     Ingredient() : name("UNKNOWN"), quantity(0), required_quantity(0), price(0.0) {}
     Ingredient(const std::string& name, const int& quantity, const int& required_quantity, const double& price)
         : name(name), quantity(quantity), required_quantity(required_quantity), price(price) {}
+    Ingredient(const std::string& name, const int& quantity, const int& required_quantity, const Money& price)
+        : name(name), quantity(quantity), required_quantity(required_quantity), price(price.toDollars()) {}
+
+    // Price per unit, rounded to the nearest cent
+    Money getPriceMoney() const { return Money::fromDollars(price); }
+};
+
+// Converts a price in dollars to whole cents, rounded to the nearest cent
+inline long priceToCents(double price) {
+    return static_cast<long>(Money::fromDollars(price).getCents());
+}
+
+/**
+ * Compact recipe line used inside Dish: the ingredient's registry ID and the quantity required.
+ * 8 bytes with no heap storage, against 48 bytes plus the name's buffer for an Ingredient.
+ */
+struct RecipeLine {
+    IngredientId id;
+    int required;
 };
+
+/**
+ * Compact stock line used inside KitchenStation and the StationManager pantry: the ingredient's
+ * registry ID, the quantity in stock and the unit price. 16 bytes with no heap storage.
+ */
+typedef InventoryLine<IngredientId, int> StockLine;
+
+/**
+ * Stock of ingredients by registry ID, as held by a station: a few lines, scanned.
+ */
+typedef Inventory<IngredientId, int> IngredientStock;
+
+/**
+ * Stock of ingredients by registry ID, as held by a StationManager pantry, which tends to hold
+ * most registered ingredients: indexed by ID (see inventory_bench).
+ */
+typedef Inventory<IngredientId, int, DenseLookup> PantryStock;
+
+/**
+ * Conversions at the API boundary. A recipe line keeps only the name and required_quantity of an
+ * Ingredient, and a stock line only the name, quantity and price; the other fields read back as 0.
+ */
+RecipeLine toRecipeLine(const Ingredient& ingredient);
+StockLine toStockLine(const Ingredient& ingredient);
+Ingredient toIngredient(const RecipeLine& line);
+Ingredient toIngredient(const StockLine& line);
+
 class Dish {
 public:
     virtual ~Dish() = default;
@@ -53,7 +103,8 @@ public:
     /**
      * Parameterized constructor.
      * @param name A reference to the name of the dish.
-     * @param ingredients A reference to a list of ingredients (default is an empty list).
+     * @param ingredients A reference to a list of ingredients (default is an empty list); only their
+     * names and required quantities are kept.
      * @param prep_time The preparation time in minutes (default is 0).
      * @param price The price of the dish (default is 0.0).
      * @param cuisine_type The cuisine type of the dish (a CuisineType enum) with default value OTHER.
@@ -63,25 +114,37 @@ public:
 
     // Accessors
     /**
-     * @return The name of the dish.
+     * @return The name of the dish, without copying.
      */
-    std::string getName() const;
+    const std::string& getName() const;
 
     /**
-     * @return The list of ingredients used in the dish.
+     * @return The list of ingredients used in the dish, rebuilt from the recipe lines. Only name and
+     * required_quantity are stored, so quantity and price read back as 0 whatever the dish was
+     * built with.
      */
     std::vector<Ingredient> getIngredients() const;
 
+    /**
+     * @return The recipe in compact form, one line per ingredient, without copying.
+     */
+    const std::vector<RecipeLine>& getRecipeLines() const;
+
     /**
      * @return The preparation time in minutes.
      */
     int getPrepTime() const;
 
     /**
-     * @return The price of the dish.
+     * @return The price of the dish in dollars.
      */
     double getPrice() const;
 
+    /**
+     * @return The exact price of the dish.
+     */
+    Money getPriceMoney() const;
+
     /**
      * @return The cuisine type of the dish in string form.
      */
@@ -98,10 +161,18 @@ public:
     /**
      * Sets the list of ingredients.
      * @param ingredients A reference to the new list of ingredients.
-     * @post Sets the private member `ingredients_` to the value of the parameter.
+     * @post Sets the private member `recipe_` to the compact form of the parameter, which keeps
+     * each ingredient's name and required_quantity and drops its quantity and price.
      */
     void setIngredients(const std::vector<Ingredient>& ingredients);
 
+    /**
+     * Sets the recipe from compact lines whose IDs are already interned.
+     * @param recipe A reference to the new recipe.
+     * @post Sets the private member `recipe_` to the value of the parameter.
+     */
+    void setRecipeLines(const std::vector<RecipeLine>& recipe);
+
     /**
      * Sets the preparation time.
      * @param prep_time The new preparation time in minutes.
@@ -116,6 +187,13 @@ public:
      */
     void setPrice(const double& price);
 
+    /**
+     * Sets the price of the dish.
+     * @param price The new price of the dish.
+     * @post Sets the private member `price_` to the value of the parameter.
+     */
+    void setPrice(const Money& price);
+
     /**
      * Sets the cuisine type of the dish.
      * @param cuisine_type The new cuisine type of the dish (a CuisineType enum).
@@ -163,11 +241,24 @@ public:
     */
     virtual void dietaryAccommodations(const DietaryRequest& request) = 0;
 
+    /**
+     * @return The memory used by the dish: the object, its name and its ingredients.
+     * Subclasses add their own members.
+     */
+    virtual MemoryUsage memoryUsage() const;
+
+    /**
+     * Copies the dish, e.g. to adjust one order without changing the menu dish.
+     * @return A new dish equal to this one, which the caller owns; nullptr if the subclass
+     * does not support copying.
+     */
+    virtual Dish* clone() const;
+
 private:
     std::string name_;
-    std::vector<Ingredient> ingredients_;
+    std::vector<RecipeLine> recipe_;
     int prep_time_;
-    double price_;
+    Money price_;
     CuisineType cuisine_type_;
 
     // Helper function to check if the name is valid
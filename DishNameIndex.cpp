@@ -0,0 +1,125 @@
+/**
+ * @file DishNameIndex.cpp
+ * @brief This file contains the implementation of the DishNameIndex class.
+ */
+
+#include "DishNameIndex.hpp"
+#include "MemoryUsage.hpp"
+#include <algorithm>
+
+DishNameIndex::DishNameIndex() : entries_(), positions_(), order_(), ordered_(0), reorder_(false), order_mutex_() {
+}
+
+std::string DishNameIndex::foldCase(const std::string& text) {
+    std::string folded(text);
+    for (char& c : folded) {
+        if (c >= 'A' && c <= 'Z') {
+            c = c - 'A' + 'a';
+        }
+    }
+    return folded;
+}
+
+bool DishNameIndex::lessEntry(uint32_t index1, uint32_t index2) const {
+    const Entry& entry1 = entries_[index1];
+    const Entry& entry2 = entries_[index2];
+    int order = entry1.key.compare(entry2.key);
+    return order < 0 || (order == 0 && entry1.match.dish_name < entry2.match.dish_name);
+}
+
+// Brings order_ up to date: the names appended since the last call are sorted and merged in.
+// Concurrent complete() calls each pass through the lock before reading order_.
+void DishNameIndex::refresh() const {
+    std::lock_guard<std::mutex> guard(order_mutex_);
+    auto less = [this](uint32_t index1, uint32_t index2) { return lessEntry(index1, index2); };
+    if (reorder_) {
+        order_.clear();
+        ordered_ = 0;
+        reorder_ = false;
+    }
+    if (ordered_ == entries_.size()) {
+        return;
+    }
+    size_t merged = order_.size();
+    for (size_t i = ordered_; i < entries_.size(); ++i) {
+        order_.push_back(static_cast<uint32_t>(i));
+    }
+    std::sort(order_.begin() + merged, order_.end(), less);
+    std::inplace_merge(order_.begin(), order_.begin() + merged, order_.end(), less);
+    ordered_ = entries_.size();
+}
+
+bool DishNameIndex::add(const std::string& dish_name, const KitchenStation* station) {
+    auto found = positions_.find(dish_name);
+    if (found == positions_.end()) {
+        found = positions_.emplace(dish_name, static_cast<uint32_t>(entries_.size())).first;
+        entries_.push_back(Entry{foldCase(dish_name), Match{dish_name, {}}}); // Ordered at the next complete()
+    }
+    std::vector<const KitchenStation*>& stations = entries_[found->second].match.stations;
+    if (std::find(stations.begin(), stations.end(), station) != stations.end()) {
+        return false;
+    }
+    stations.push_back(station);
+    return true;
+}
+
+bool DishNameIndex::remove(const std::string& dish_name, const KitchenStation* station) {
+    auto found = positions_.find(dish_name);
+    if (found == positions_.end()) {
+        return false;
+    }
+    std::vector<const KitchenStation*>& stations = entries_[found->second].match.stations;
+    auto assigned = std::find(stations.begin(), stations.end(), station);
+    if (assigned == stations.end()) {
+        return false;
+    }
+    stations.erase(assigned);
+    if (stations.empty()) {
+        uint32_t position = found->second;
+        positions_.erase(found);
+        if (position + 1 != entries_.size()) { // Move the last entry into the gap
+            entries_[position] = std::move(entries_.back());
+            positions_[entries_[position].match.dish_name] = position;
+        }
+        entries_.pop_back();
+        reorder_ = true;
+    }
+    return true;
+}
+
+std::vector<DishNameIndex::Match> DishNameIndex::complete(const std::string& prefix, size_t limit) const {
+    refresh();
+    std::string key = foldCase(prefix);
+    auto position = std::lower_bound(order_.begin(), order_.end(), key, [this](uint32_t index, const std::string& k) {
+        return entries_[index].key < k;
+    });
+    std::vector<Match> matches;
+    for (; position != order_.end() && matches.size() < limit; ++position) {
+        const Entry& entry = entries_[*position];
+        if (entry.key.compare(0, key.size(), key) != 0) {
+            break;
+        }
+        matches.push_back(entry.match);
+    }
+    return matches;
+}
+
+size_t DishNameIndex::size() const {
+    return entries_.size();
+}
+
+void DishNameIndex::clear() {
+    entries_.clear();
+    positions_.clear();
+    order_.clear();
+    ordered_ = 0;
+    reorder_ = false;
+}
+
+size_t DishNameIndex::memoryUsage() const {
+    size_t bytes = heapBytes(entries_) + heapBytes(order_) + hashBytes(positions_);
+    for (const Entry& entry : entries_) {
+        bytes += heapBytes(entry.key) + 2 * heapBytes(entry.match.dish_name) + heapBytes(entry.match.stations); // The map holds a copy of the name
+    }
+    return bytes;
+}
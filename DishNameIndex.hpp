@@ -0,0 +1,102 @@
+/**
+ * @file DishNameIndex.hpp
+ * @brief This file contains the declaration of the DishNameIndex class, a prefix index over dish
+ * names for autocomplete.
+ *
+ * Each entry records a dish name, its lower-case form and the stations that serve the dish. A
+ * hash map finds an entry by exact name, so adding or removing an assignment is one lookup, and a
+ * new name is appended rather than inserted in order. The first complete() after a change sorts
+ * the entries appended since the last one and merges them into an order array sorted by the
+ * lower-case form, so every name with a given prefix sits in one contiguous run that a binary search
+ * finds; building an index of N names therefore costs O(N log N). Removing a name reorders
+ * everything at the next complete(). The const complete() rebuilds the order under a mutex, so
+ * several threads may call it at once; an index must still not be read while it is being changed.
+ */
+
+#ifndef DISHNAMEINDEX_HPP
+#define DISHNAMEINDEX_HPP
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class KitchenStation;
+
+class DishNameIndex {
+public:
+    /**
+     * @struct Match
+     * @brief One autocomplete result.
+     */
+    struct Match {
+        std::string dish_name;
+        std::vector<const KitchenStation*> stations;   // in the order they were assigned the dish
+    };
+
+    /**
+     * Default constructor.
+     * Initializes an empty index.
+     */
+    DishNameIndex();
+
+    /**
+     * Records that a station serves a dish.
+     * @param dish_name The name of the dish.
+     * @param station The station that serves it.
+     * @return True if the assignment was new; false if it was already recorded.
+     */
+    bool add(const std::string& dish_name, const KitchenStation* station);
+
+    /**
+     * Forgets that a station serves a dish. The name is dropped once no station serves it.
+     * @param dish_name The name of the dish.
+     * @param station The station.
+     * @return True if the assignment was recorded; false otherwise.
+     */
+    bool remove(const std::string& dish_name, const KitchenStation* station);
+
+    /**
+     * Finds the dishes whose names start with a prefix, ignoring ASCII case.
+     * @param prefix The typed prefix. An empty prefix matches every dish.
+     * @param limit The maximum number of matches to return.
+     * @return The first `limit` matching names in case-insensitive alphabetical order (the top k
+     * are the alphabetically first k, not a ranking by popularity).
+     */
+    std::vector<Match> complete(const std::string& prefix, size_t limit) const;
+
+    /**
+     * @return The number of distinct dish names in the index.
+     */
+    size_t size() const;
+
+    /**
+     * Removes every entry.
+     */
+    void clear();
+
+    /**
+     * @return The heap bytes held by the index, estimated as in MemoryUsage.hpp.
+     */
+    size_t memoryUsage() const;
+
+private:
+    struct Entry {
+        std::string key;    // lower-case name; the sort key
+        Match match;
+    };
+
+    static std::string foldCase(const std::string& text);
+    bool lessEntry(uint32_t index1, uint32_t index2) const;
+    void refresh() const;
+
+    std::vector<Entry> entries_;                           // in the order names were added, except after removals
+    std::unordered_map<std::string, uint32_t> positions_;  // dish name -> index in entries_
+    mutable std::vector<uint32_t> order_;                  // indices into entries_, sorted by (key, dish_name)
+    mutable size_t ordered_;                               // entries_[0, ordered_) are in order_
+    mutable bool reorder_;                                 // a removal moved entries; rebuild order_ from scratch
+    mutable std::mutex order_mutex_;                       // guards the three members above in refresh()
+};
+
+#endif // DISHNAMEINDEX_HPP
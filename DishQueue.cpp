@@ -0,0 +1,76 @@
+/**
+ * @file DishQueue.cpp
+ * @brief This file contains the implementation of the DishQueue class.
+ */
+
+#include "DishQueue.hpp"
+
+DishQueue::DishQueue() : head_(0), count_(0) {
+}
+
+void DishQueue::push(Dish* dish) {
+    if (count_ == slots_.size()) {
+        grow(slots_.empty() ? 16 : 2 * slots_.size());
+    }
+    slots_[(head_ + count_) & (slots_.size() - 1)] = dish;
+    ++count_;
+}
+
+Dish* DishQueue::front() const {
+    return slots_[head_];
+}
+
+void DishQueue::pop() {
+    head_ = (head_ + 1) & (slots_.size() - 1);
+    --count_;
+}
+
+Dish* DishQueue::at(size_t position) const {
+    return slots_[(head_ + position) & (slots_.size() - 1)];
+}
+
+size_t DishQueue::size() const {
+    return count_;
+}
+
+bool DishQueue::empty() const {
+    return count_ == 0;
+}
+
+void DishQueue::clear() {
+    head_ = 0;
+    count_ = 0;
+}
+
+void DishQueue::reserve(size_t capacity) {
+    if (capacity <= slots_.size()) {
+        return;
+    }
+    size_t rounded = 16;
+    while (rounded < capacity) {
+        rounded *= 2;
+    }
+    grow(rounded);
+}
+
+size_t DishQueue::capacity() const {
+    return slots_.size();
+}
+
+std::queue<Dish*> DishQueue::toQueue() const {
+    std::queue<Dish*> dishes;
+    for (size_t i = 0; i < count_; ++i) {
+        dishes.push(at(i));
+    }
+    return dishes;
+}
+
+// Moves the dishes, oldest first, to the start of a ring of the given power-of-two capacity
+void DishQueue::grow(size_t capacity) {
+    std::vector<Dish*> slots(capacity, nullptr);
+    for (size_t i = 0; i < count_; ++i) {
+        slots[i] = at(i);
+    }
+    slots_.swap(slots);
+    head_ = 0;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file DishQueue.hpp
+ * @brief This file contains the declaration of the DishQueue class, the FIFO of dish pointers
+ * that StationManager dispatches from.
+ *
+ * The queue is a ring over one array whose capacity is a power of two. It only allocates when it
+ * grows past its capacity and never shrinks, so once it has held the largest backlog (or after
+ * reserve()), pushing and popping orders does not touch the heap. A std::deque, by contrast,
+ * allocates and frees a chunk every 64 pointers that pass through it.
+ */
+
+#ifndef DISHQUEUE_HPP
+#define DISHQUEUE_HPP
+
+#include <cstddef>
+#include <queue>
+#include <vector>
+
+class Dish;
+
+class DishQueue {
+public:
+    /**
+     * Default constructor.
+     * Initializes an empty queue without storage.
+     */
+    DishQueue();
+
+    /**
+     * Appends a dish, growing the ring if it is full.
+     * @param dish The dish to append.
+     */
+    void push(Dish* dish);
+
+    /**
+     * @pre The queue is not empty.
+     * @return The oldest dish.
+     */
+    Dish* front() const;
+
+    /**
+     * Removes the oldest dish.
+     * @pre The queue is not empty.
+     */
+    void pop();
+
+    /**
+     * @param position A position from the front, below size().
+     * @return The dish at that position.
+     */
+    Dish* at(size_t position) const;
+
+    /**
+     * @return The number of dishes in the queue.
+     */
+    size_t size() const;
+
+    /**
+     * @return True if the queue holds no dishes.
+     */
+    bool empty() const;
+
+    /**
+     * Removes every dish, keeping the storage.
+     */
+    void clear();
+
+    /**
+     * Grows the ring so that it holds at least `capacity` dishes without allocating.
+     * @param capacity The number of dishes.
+     */
+    void reserve(size_t capacity);
+
+    /**
+     * @return The number of dishes the ring holds before it must grow.
+     */
+    size_t capacity() const;
+
+    /**
+     * @return A copy as a std::queue, oldest dish first.
+     */
+    std::queue<Dish*> toQueue() const;
+
+private:
+    void grow(size_t capacity);
+
+    std::vector<Dish*> slots_;   // size is zero or a power of two
+    size_t head_;                // position of the oldest dish
+    size_t count_;
+};
+
+#endif // DISHQUEUE_HPP
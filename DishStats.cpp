@@ -0,0 +1,227 @@
+/**
+ * @file DishStats.cpp
+ * @brief This file contains the implementation of the DishStats class.
+ */
+
+#include "DishStats.hpp"
+#include "MemoryUsage.hpp"
+#include <algorithm>
+
+namespace {
+const size_t SHARD_CACHE_SIZE = 4;
+
+std::atomic<uint64_t> next_stats_id(1);
+
+// Each thread remembers its shard for the last few DishStats it recorded into
+struct ShardCacheEntry {
+    uint64_t owner;
+    void* shard;
+};
+thread_local ShardCacheEntry shard_cache[SHARD_CACHE_SIZE];
+thread_local size_t shard_cache_next = 0;
+}
+
+DishStats::DishStats() : id_(next_stats_id.fetch_add(1)) {
+}
+
+DishStats::~DishStats() = default;
+
+void DishStats::record(const std::string& dish_name, bool prepared) {
+    Shard& shard = localShard();
+    uint64_t key = hashName(dish_name);
+    if (shard.known.insert(key).second) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        names_.emplace(key, dish_name);
+    }
+    add(shard.streams[ORDERED], key);
+    if (!prepared) {
+        add(shard.streams[FAILED], key);
+    }
+}
+
+std::vector<DishStats::HeavyHitter> DishStats::getTopOrdered(size_t k) const {
+    return getTop(ORDERED, k);
+}
+
+std::vector<DishStats::HeavyHitter> DishStats::getTopFailed(size_t k) const {
+    return getTop(FAILED, k);
+}
+
+uint64_t DishStats::estimateOrdered(const std::string& dish_name) const {
+    return estimate(ORDERED, dish_name);
+}
+
+uint64_t DishStats::estimateFailed(const std::string& dish_name) const {
+    return estimate(FAILED, dish_name);
+}
+
+uint64_t DishStats::getTotalOrdered() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t total = 0;
+    for (const auto& entry : shards_) {
+        total += entry.second->streams[ORDERED].total.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+uint64_t DishStats::getTotalFailed() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t total = 0;
+    for (const auto& entry : shards_) {
+        total += entry.second->streams[FAILED].total.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+// FNV-1a
+uint64_t DishStats::hashName(const std::string& dish_name) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : dish_name) {
+        hash = (hash ^ c) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+size_t DishStats::sketchColumn(uint64_t key, size_t row) {
+    static const uint64_t SEEDS[SKETCH_DEPTH] = {
+        0x9e3779b97f4a7c15ULL, 0xc2b2ae3d27d4eb4fULL, 0x165667b19e3779f9ULL, 0xd6e8feb86659fd93ULL};
+    uint64_t mixed = (key ^ (key >> 29)) * SEEDS[row];
+    return static_cast<size_t>(mixed >> 32) % SKETCH_WIDTH;
+}
+
+// Counts one event; only the thread that owns the stream calls this, so plain load/store pairs suffice
+void DishStats::add(Stream& stream, uint64_t key) {
+    stream.total.store(stream.total.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    for (size_t row = 0; row < SKETCH_DEPTH; ++row) {
+        std::atomic<uint32_t>& cell = stream.sketch[row][sketchColumn(key, row)];
+        cell.store(cell.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+
+    Counter* minimum = nullptr;
+    for (size_t i = 0; i < stream.used; ++i) {
+        Counter& counter = stream.top[i];
+        if (counter.key.load(std::memory_order_relaxed) == key) {
+            counter.count.store(counter.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+        if (minimum == nullptr || counter.count.load(std::memory_order_relaxed) < minimum->count.load(std::memory_order_relaxed)) {
+            minimum = &counter;
+        }
+    }
+    if (stream.used < TOP_CAPACITY) {
+        Counter& counter = stream.top[stream.used++];
+        counter.key.store(key, std::memory_order_relaxed);
+        counter.error.store(0, std::memory_order_relaxed);
+        counter.count.store(1, std::memory_order_release);
+        return;
+    }
+    // Space-saving: the new key takes over the smallest counter and inherits its count as error
+    uint64_t floor = minimum->count.load(std::memory_order_relaxed);
+    minimum->key.store(key, std::memory_order_relaxed);
+    minimum->error.store(floor, std::memory_order_relaxed);
+    minimum->count.store(floor + 1, std::memory_order_release);
+}
+
+DishStats::Shard& DishStats::localShard() {
+    for (const ShardCacheEntry& entry : shard_cache) {
+        if (entry.owner == id_) {
+            return *static_cast<Shard*>(entry.shard);
+        }
+    }
+    Shard* shard;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        std::unique_ptr<Shard>& slot = shards_[std::this_thread::get_id()];
+        if (!slot) {
+            slot = std::make_unique<Shard>();
+        }
+        shard = slot.get();
+    }
+    shard_cache[shard_cache_next] = ShardCacheEntry{id_, shard};
+    shard_cache_next = (shard_cache_next + 1) % SHARD_CACHE_SIZE;
+    return *shard;
+}
+
+// Merges the threads' space-saving tables. A key missing from a full table may have been evicted
+// there, so it is charged that table's smallest count as extra count and error.
+std::vector<DishStats::HeavyHitter> DishStats::getTop(StreamKind kind, size_t k) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    struct Merged {
+        uint64_t count;
+        uint64_t error;
+        uint64_t covered_floor;   // floors of the full tables that hold the key
+    };
+    std::unordered_map<uint64_t, Merged> merged;
+    uint64_t floor_total = 0;   // floors of all full tables
+    for (const auto& entry : shards_) {
+        const Stream& stream = entry.second->streams[kind];
+        uint64_t counts[TOP_CAPACITY];
+        uint64_t floor = UINT64_MAX;
+        size_t used = 0;
+        for (size_t i = 0; i < TOP_CAPACITY; ++i) {
+            counts[i] = stream.top[i].count.load(std::memory_order_acquire);
+            if (counts[i] != 0) {
+                ++used;
+                floor = std::min(floor, counts[i]);
+            }
+        }
+        bool full = used == TOP_CAPACITY;
+        if (full) {
+            floor_total += floor;
+        }
+        for (size_t i = 0; i < TOP_CAPACITY; ++i) {
+            if (counts[i] == 0) {
+                continue;
+            }
+            Merged& total = merged[stream.top[i].key.load(std::memory_order_relaxed)];
+            total.count += counts[i];
+            total.error += stream.top[i].error.load(std::memory_order_relaxed);
+            total.covered_floor += full ? floor : 0;
+        }
+    }
+    for (auto& entry : merged) {
+        uint64_t missed = floor_total - entry.second.covered_floor;
+        entry.second.count += missed;
+        entry.second.error += missed;
+    }
+
+    std::vector<HeavyHitter> top;
+    for (const auto& entry : merged) {
+        auto name = names_.find(entry.first);
+        top.push_back(HeavyHitter{name == names_.end() ? "UNKNOWN" : name->second, entry.second.count, entry.second.error});
+    }
+    std::sort(top.begin(), top.end(), [](const HeavyHitter& a, const HeavyHitter& b) {
+        return a.count > b.count || (a.count == b.count && a.dish_name < b.dish_name);
+    });
+    if (top.size() > k) {
+        top.resize(k);
+    }
+    return top;
+}
+
+uint64_t DishStats::estimate(StreamKind kind, const std::string& dish_name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t key = hashName(dish_name);
+    uint64_t best = UINT64_MAX;
+    for (size_t row = 0; row < SKETCH_DEPTH; ++row) {
+        size_t column = sketchColumn(key, row);
+        uint64_t sum = 0;
+        for (const auto& entry : shards_) {
+            sum += entry.second->streams[kind].sketch[row][column].load(std::memory_order_relaxed);
+        }
+        best = std::min(best, sum);
+    }
+    return shards_.empty() ? 0 : best;
+}
+
+size_t DishStats::memoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t bytes = hashBytes(shards_) + hashBytes(names_);
+    for (const auto& shard : shards_) {
+        bytes += sizeof(Shard) + hashBytes(shard.second->known);
+    }
+    for (const auto& name : names_) {
+        bytes += heapBytes(name.second);
+    }
+    return bytes;
+}
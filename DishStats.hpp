@@ -0,0 +1,135 @@
+/**
+ * @file DishStats.hpp
+ * @brief This file contains the declaration of the DishStats class, bounded-memory streaming
+ * statistics on ordered and failed dishes.
+ *
+ * Each stream (orders, failures) keeps two sketches:
+ *   - a space-saving table of TOP_CAPACITY counters, which finds the most frequent dishes. A
+ *     reported count never underestimates, and overestimates by at most the reported error;
+ *   - a count-min sketch (SKETCH_DEPTH rows of SKETCH_WIDTH counters), which estimates the count
+ *     of any dish, again never underestimating.
+ *
+ * Every thread that records events gets its own sketches, written only by that thread with relaxed
+ * atomic stores, so recording takes no lock and, after a thread's first sighting of a dish, does
+ * not allocate. Readers merge all threads' sketches. A read that races with recording may see a
+ * counter one event behind.
+ */
+
+#ifndef DISHSTATS_HPP
+#define DISHSTATS_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+class DishStats {
+public:
+    static const size_t TOP_CAPACITY = 64;
+    static const size_t SKETCH_DEPTH = 4;
+    static const size_t SKETCH_WIDTH = 1024;
+
+    /**
+     * @struct HeavyHitter
+     * @brief One entry of a top-K report.
+     */
+    struct HeavyHitter {
+        std::string dish_name;
+        uint64_t count;   // upper bound on the true count
+        uint64_t error;   // the true count is at least count - error
+    };
+
+    DishStats();
+    ~DishStats();
+    DishStats(const DishStats&) = delete;
+    DishStats& operator=(const DishStats&) = delete;
+
+    /**
+     * Records one dispatch attempt.
+     * @param dish_name The name of the dish.
+     * @param prepared True if the dish was prepared; false if it failed.
+     */
+    void record(const std::string& dish_name, bool prepared);
+
+    /**
+     * @param k The number of dishes to report, at most TOP_CAPACITY.
+     * @return The k most-ordered dishes, most frequent first.
+     */
+    std::vector<HeavyHitter> getTopOrdered(size_t k) const;
+
+    /**
+     * @param k The number of dishes to report, at most TOP_CAPACITY.
+     * @return The k most-failed dishes, most frequent first.
+     */
+    std::vector<HeavyHitter> getTopFailed(size_t k) const;
+
+    /**
+     * @param dish_name The name of a dish.
+     * @return An upper bound on the number of times the dish was ordered.
+     */
+    uint64_t estimateOrdered(const std::string& dish_name) const;
+
+    /**
+     * @param dish_name The name of a dish.
+     * @return An upper bound on the number of times the dish failed.
+     */
+    uint64_t estimateFailed(const std::string& dish_name) const;
+
+    /**
+     * @return The exact number of recorded orders.
+     */
+    uint64_t getTotalOrdered() const;
+
+    /**
+     * @return The exact number of recorded failures.
+     */
+    uint64_t getTotalFailed() const;
+
+    /**
+     * @return The heap bytes held by the shards and names, estimated as in MemoryUsage.hpp.
+     */
+    size_t memoryUsage() const;
+
+private:
+    enum StreamKind { ORDERED, FAILED };
+
+    // One space-saving counter; count == 0 marks an unused slot
+    struct Counter {
+        std::atomic<uint64_t> key;
+        std::atomic<uint64_t> count;
+        std::atomic<uint64_t> error;
+    };
+
+    struct Stream {
+        Counter top[TOP_CAPACITY];
+        std::atomic<uint32_t> sketch[SKETCH_DEPTH][SKETCH_WIDTH];
+        std::atomic<uint64_t> total;
+        size_t used;   // slots of top in use; only read by the owning thread
+    };
+
+    // The sketches of one recording thread. Allocated value-initialized, so every counter starts at zero.
+    struct Shard {
+        Stream streams[2];
+        std::unordered_set<uint64_t> known;   // keys whose name was registered; owner only
+    };
+
+    static uint64_t hashName(const std::string& dish_name);
+    static size_t sketchColumn(uint64_t key, size_t row);
+    static void add(Stream& stream, uint64_t key);
+
+    Shard& localShard();
+    std::vector<HeavyHitter> getTop(StreamKind kind, size_t k) const;
+    uint64_t estimate(StreamKind kind, const std::string& dish_name) const;
+
+    const uint64_t id_;   // tells this instance apart in the per-thread shard cache
+    mutable std::mutex mutex_;   // guards shards_ and names_, not the counters
+    std::unordered_map<std::thread::id, std::unique_ptr<Shard>> shards_;
+    std::unordered_map<uint64_t, std::string> names_;
+};
+
+#endif // DISHSTATS_HPP
@@ -0,0 +1,116 @@
+/**
+ * @file DispatchEngine.cpp
+ * @brief This file contains the implementation of the dispatch engines.
+ */
+
+#include "DispatchEngine.hpp"
+
+DishQueue& DispatchEngine::getQueue(StationManager& manager) {
+    return manager.dish_queue_;
+}
+
+void DispatchEngine::bookDish(StationManager& manager, Dish* dish, bool prepared, Money cost_before, std::vector<bool>* results) {
+    manager.bookDish(dish, prepared, cost_before, results);
+}
+
+const char* ReferenceEngine::getName() const {
+    return "reference";
+}
+
+void ReferenceEngine::dispatch(StationManager& manager, EventSink& events, std::vector<bool>* results) {
+    manager.processAllDishes(events, results);
+}
+
+const char* IndexedEngine::getName() const {
+    return "indexed";
+}
+
+void IndexedEngine::dispatch(StationManager& manager, EventSink& events, std::vector<bool>* results) {
+    if (manager.getPublishedMenu() || !manager.getRecipeBook().empty() || !manager.getSubstitutionGraph().empty() ||
+        manager.getProfiler() != nullptr) {
+        manager.processAllDishes(events, results);
+        return;
+    }
+
+    // Stations and plans can change between dispatches, so both are rebuilt; the storage is kept
+    stations_.clear();
+    for (Node<KitchenStation*>* node = manager.getHeadNode(); node != nullptr; node = node->getNext()) {
+        stations_.push_back(node->getItem());
+    }
+    plans_.clear();
+    served_.clear();
+
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    DishQueue& queue = getQueue(manager);
+    size_t remaining = queue.size();
+    while (remaining-- > 0) {
+        Dish* dish = queue.front();
+        queue.pop();
+        events.record(KitchenEvent{KitchenEvent::PREPARING, 0, 0, nullptr, dish});
+        size_t plan = planFor(dish);
+        bool prepared = false;
+        Money cost_before = Money::fromCents(manager.getCostOfGoodsCents());
+
+        for (size_t i = 0; i < stations_.size() && !prepared; ++i) {
+            KitchenStation* station = stations_[i];
+            events.record(KitchenEvent{KitchenEvent::ATTEMPTING, 0, 0, station, dish});
+            const Dish* served = served_[plan + i];
+            if (served == nullptr) {
+                events.record(KitchenEvent{KitchenEvent::NOT_AVAILABLE, 0, 0, station, dish});
+                continue;
+            }
+            if (station->prepareLines(served->getRecipeLines())) { // Fails only when the stock is short
+                events.record(KitchenEvent{KitchenEvent::PREPARED, 0, 0, station, dish});
+                prepared = true;
+                continue;
+            }
+
+            events.record(KitchenEvent{KitchenEvent::INSUFFICIENT, 0, 0, station, dish});
+            bool replenished = true;
+            for (const RecipeLine& line : dish->getRecipeLines()) { // The queued dish's recipe, as in the reference
+                int replenish_quantity = line.required - station->getStockQuantity(line.id);
+                if (replenish_quantity > 0 &&
+                    !manager.replenishStationIngredientFromBackup(station->getName(), registry.getName(line.id), replenish_quantity)) {
+                    replenished = false;
+                    break;
+                }
+            }
+            if (!replenished) {
+                events.record(KitchenEvent{KitchenEvent::UNABLE_TO_REPLENISH, 0, 0, station, dish});
+                continue;
+            }
+            events.record(KitchenEvent{KitchenEvent::REPLENISHED, 0, 0, station, dish});
+            prepared = station->prepareLines(served->getRecipeLines());
+            events.record(KitchenEvent{prepared ? KitchenEvent::PREPARED : KitchenEvent::UNABLE_TO_PREPARE, 0, 0, station, dish});
+        }
+
+        bookDish(manager, dish, prepared, cost_before, results);
+        if (!prepared) {
+            events.record(KitchenEvent{KitchenEvent::NOT_PREPARED, 0, 0, nullptr, dish});
+            queue.push(dish);
+        }
+    }
+    events.record(KitchenEvent{KitchenEvent::ALL_PROCESSED, 0, 0, nullptr, nullptr});
+}
+
+// Returns the offset in served_ of the dish's plan: for each station, the first dish it serves
+// under the dish's name (the one canCompleteOrder() and prepareDish() would use), or null
+size_t IndexedEngine::planFor(const Dish* dish) {
+    auto found = plans_.find(dish);
+    if (found != plans_.end()) {
+        return found->second;
+    }
+    size_t plan = served_.size();
+    for (KitchenStation* station : stations_) {
+        const Dish* served = nullptr;
+        for (const Dish* candidate : station->getDishes()) {
+            if (candidate->getName() == dish->getName()) {
+                served = candidate;
+                break;
+            }
+        }
+        served_.push_back(served);
+    }
+    plans_.emplace(dish, plan);
+    return plan;
+}
@@ -0,0 +1,74 @@
+/**
+ * @file DispatchEngine.hpp
+ * @brief This file contains the declaration of the DispatchEngine interface, for interchangeable
+ * implementations of StationManager::processAllDishes(), and of the engines themselves.
+ *
+ * Every engine must keep the semantics of processAllDishes(): each queued dish tries the stations
+ * in list order and goes to the first one that can make it (greedy); a station that is short is
+ * topped up from the backup one ingredient at a time, and what was moved before a shortfall stays
+ * moved (partial replenishment); dishes that no station can make go back to the queue behind the
+ * others, in their original order. It must also send the same events, in the same order, and book
+ * each dish's result, statistics and sale the same way. dispatch_diff checks engines against
+ * ReferenceEngine on generated kitchens.
+ */
+
+#ifndef DISPATCHENGINE_HPP
+#define DISPATCHENGINE_HPP
+
+#include "StationManager.hpp"
+#include <unordered_map>
+#include <vector>
+
+class DispatchEngine {
+public:
+    virtual ~DispatchEngine() = default;
+
+    /**
+     * @return A short name for reports, e.g. "reference".
+     */
+    virtual const char* getName() const = 0;
+
+    /**
+     * Processes every dish in the manager's queue, as manager.processAllDishes(events, results) does.
+     * @param manager The kitchen.
+     * @param events The sink that receives the events.
+     * @param results If not null, receives one entry per processed dish, in queue order.
+     */
+    virtual void dispatch(StationManager& manager, EventSink& events, std::vector<bool>* results = nullptr) = 0;
+
+protected:
+    // Access for engines to the parts of a StationManager that processAllDishes() uses privately
+    static DishQueue& getQueue(StationManager& manager);
+    static void bookDish(StationManager& manager, Dish* dish, bool prepared, Money cost_before, std::vector<bool>* results);
+};
+
+/**
+ * StationManager::processAllDishes() itself; the oracle the other engines are compared against.
+ */
+class ReferenceEngine : public DispatchEngine {
+public:
+    const char* getName() const override;
+    void dispatch(StationManager& manager, EventSink& events, std::vector<bool>* results = nullptr) override;
+};
+
+/**
+ * Resolves, once per dispatch and per queued dish, which dish each station serves under that
+ * name, then checks and deducts the served dish's compact recipe lines directly. This saves the
+ * per-station name comparisons of the reference and the name lookups of canCompleteOrder() and
+ * prepareDish(). A kitchen that uses a published menu, sub-recipes, substitutions or the profiler
+ * is handed to processAllDishes(), which implements them.
+ */
+class IndexedEngine : public DispatchEngine {
+public:
+    const char* getName() const override;
+    void dispatch(StationManager& manager, EventSink& events, std::vector<bool>* results = nullptr) override;
+
+private:
+    size_t planFor(const Dish* dish);
+
+    std::vector<KitchenStation*> stations_;               // in list order
+    std::unordered_map<const Dish*, size_t> plans_;       // queued dish -> offset of its plan in served_
+    std::vector<const Dish*> served_;                     // per plan, the dish each station serves, or null
+};
+
+#endif // DISPATCHENGINE_HPP
@@ -0,0 +1,103 @@
+/**
+ * @file EventSink.cpp
+ * @brief This file contains the implementation of the event sinks.
+ */
+
+#include "EventSink.hpp"
+#include "Dish.hpp"
+#include "KitchenStation.hpp"
+
+namespace {
+// Ends a line as std::endl does, or without the flush
+void endLine(std::ostream& out, bool flush) {
+    out.put('\n');
+    if (flush) {
+        out.flush();
+    }
+}
+}
+
+void formatEvent(std::ostream& out, const KitchenEvent& event, bool flush) {
+    switch (event.kind) {
+    case KitchenEvent::PREPARING:
+        out << "PREPARING DISH: " << event.dish->getName();
+        endLine(out, flush);
+        break;
+    case KitchenEvent::ATTEMPTING:
+        out << event.station->getName() << " attempting to prepare " << event.dish->getName() << "...";
+        endLine(out, flush);
+        break;
+    case KitchenEvent::NOT_AVAILABLE:
+        out << event.station->getName() << ": Dish not available. Moving to next station...";
+        endLine(out, flush);
+        break;
+    case KitchenEvent::INSUFFICIENT:
+        out << event.station->getName() << ": Insufficient ingredients. Replenishing ingredients...";
+        endLine(out, flush);
+        break;
+    case KitchenEvent::REPLENISHED:
+        out << event.station->getName() << ": Ingredients replenished.";
+        endLine(out, flush);
+        break;
+    case KitchenEvent::SUBSTITUTED: {
+        IngredientRegistry& registry = IngredientRegistry::instance();
+        out << event.station->getName() << ": Substituted " << registry.getName(event.substitute)
+            << " for " << registry.getName(event.original) << ".";
+        endLine(out, flush);
+        break;
+    }
+    case KitchenEvent::PREPARED:
+        out << event.station->getName() << ": Successfully prepared " << event.dish->getName() << ".";
+        endLine(out, flush);
+        break;
+    case KitchenEvent::UNABLE_TO_PREPARE:
+        out << event.station->getName() << ": Unable to prepare " << event.dish->getName() << ".";
+        endLine(out, flush);
+        break;
+    case KitchenEvent::UNABLE_TO_REPLENISH:
+        out << event.station->getName() << ": Unable to replenish ingredients. Failed to prepare "
+            << event.dish->getName() << ".";
+        endLine(out, flush);
+        break;
+    case KitchenEvent::NOT_PREPARED:
+        out << event.dish->getName() << " was not prepared.";
+        endLine(out, flush);
+        break;
+    case KitchenEvent::ALL_PROCESSED:
+        out << "\n\nAll dishes have been processed.";
+        endLine(out, flush);
+        break;
+    }
+}
+
+void NullEventSink::record(const KitchenEvent&) {
+}
+
+void BinaryEventSink::record(const KitchenEvent& event) {
+    events_.push_back(event);
+}
+
+const std::vector<KitchenEvent>& BinaryEventSink::getEvents() const {
+    return events_;
+}
+
+void BinaryEventSink::reserve(size_t count) {
+    events_.reserve(count);
+}
+
+void BinaryEventSink::clear() {
+    events_.clear();
+}
+
+void BinaryEventSink::replay(std::ostream& out) const {
+    for (const KitchenEvent& event : events_) {
+        formatEvent(out, event);
+    }
+}
+
+TextEventSink::TextEventSink(std::ostream& out) : out_(out) {
+}
+
+void TextEventSink::record(const KitchenEvent& event) {
+    formatEvent(out_, event);
+}
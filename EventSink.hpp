@@ -0,0 +1,131 @@
+/**
+ * @file EventSink.hpp
+ * @brief This file contains the declaration of KitchenEvent, the record of one step of
+ * StationManager::processAllDishes(), and the sinks that receive the records.
+ *
+ * An event is a fixed-size record of pointers and IDs, so emitting one costs neither formatting
+ * nor allocation. What happens next is the sink's choice: NullEventSink drops the events,
+ * BinaryEventSink keeps the records for later inspection, and TextEventSink formats each one into
+ * the preparation log that processAllDishes(std::ostream&) has always written. AsyncEventSink
+ * (AsyncEventSink.hpp) hands the records to a writer thread that formats the same log.
+ */
+
+#ifndef EVENTSINK_HPP
+#define EVENTSINK_HPP
+
+#include "IngredientRegistry.hpp"
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+class Dish;
+class KitchenStation;
+
+/**
+ * Struct representing one step of dish processing. `station` is null for the dish-level events
+ * (PREPARING, NOT_PREPARED) and both pointers are null for ALL_PROCESSED; `original` and
+ * `substitute` are only set for SUBSTITUTED.
+ */
+struct KitchenEvent {
+    enum Kind : uint8_t {
+        PREPARING,             // "PREPARING DISH: <dish>"
+        ATTEMPTING,            // "<station> attempting to prepare <dish>..."
+        NOT_AVAILABLE,         // "<station>: Dish not available. Moving to next station..."
+        INSUFFICIENT,          // "<station>: Insufficient ingredients. Replenishing ingredients..."
+        REPLENISHED,           // "<station>: Ingredients replenished."
+        SUBSTITUTED,           // "<station>: Substituted <substitute> for <original>."
+        PREPARED,              // "<station>: Successfully prepared <dish>."
+        UNABLE_TO_PREPARE,     // "<station>: Unable to prepare <dish>."
+        UNABLE_TO_REPLENISH,   // "<station>: Unable to replenish ingredients. Failed to prepare <dish>."
+        NOT_PREPARED,          // "<dish> was not prepared."
+        ALL_PROCESSED          // "\n\nAll dishes have been processed."
+    };
+
+    Kind kind;
+    IngredientId original;
+    IngredientId substitute;
+    const KitchenStation* station;
+    const Dish* dish;
+};
+
+/**
+ * Writes the log line of an event, exactly as processAllDishes() prints it.
+ * @param out The stream to write to.
+ * @param event The event; its station and dish must still exist.
+ * @param flush True to flush after the line, as std::endl does; false to leave it buffered.
+ */
+void formatEvent(std::ostream& out, const KitchenEvent& event, bool flush = true);
+
+/**
+ * Receives the events of StationManager::processAllDishes().
+ */
+class EventSink {
+public:
+    virtual ~EventSink() = default;
+
+    /**
+     * Receives one event, in processing order.
+     * @param event The event.
+     */
+    virtual void record(const KitchenEvent& event) = 0;
+};
+
+/**
+ * Discards every event.
+ */
+class NullEventSink : public EventSink {
+public:
+    void record(const KitchenEvent& event) override;
+};
+
+/**
+ * Keeps every event as a record. clear() keeps the storage, so a sink that is reused across runs
+ * stops allocating once it has held the longest run.
+ */
+class BinaryEventSink : public EventSink {
+public:
+    void record(const KitchenEvent& event) override;
+
+    /**
+     * @return The events received since the last clear(), oldest first.
+     */
+    const std::vector<KitchenEvent>& getEvents() const;
+
+    /**
+     * Makes room for `count` events without allocating.
+     * @param count The number of events.
+     */
+    void reserve(size_t count);
+
+    /**
+     * Removes every event, keeping the storage.
+     */
+    void clear();
+
+    /**
+     * Formats the events in order, as TextEventSink would have.
+     * @param out The stream to write to.
+     */
+    void replay(std::ostream& out) const;
+
+private:
+    std::vector<KitchenEvent> events_;
+};
+
+/**
+ * Formats each event into the preparation log as it arrives.
+ */
+class TextEventSink : public EventSink {
+public:
+    /**
+     * @param out The stream that receives the log; it must outlive the sink.
+     */
+    explicit TextEventSink(std::ostream& out);
+
+    void record(const KitchenEvent& event) override;
+
+private:
+    std::ostream& out_;
+};
+
+#endif // EVENTSINK_HPP
@@ -0,0 +1,207 @@
+/**
+ * @file IngredientIndex.cpp
+ * @brief This file contains the implementation of the IngredientIndex class.
+ */
+
+#include "IngredientIndex.hpp"
+#include "MemoryUsage.hpp"
+#include "KitchenStation.hpp"
+#include <algorithm>
+#include <unordered_set>
+
+namespace {
+const size_t NO_SLOT = static_cast<size_t>(-1);
+}
+
+void IngredientIndex::addDish(const KitchenStation& station, const Dish& dish) {
+    if (findPair(station, dish) != NO_SLOT) {
+        return;
+    }
+    size_t slot;
+    if (free_slots_.empty()) {
+        slot = pairs_.size();
+        pairs_.push_back(Pair());
+    } else {
+        slot = free_slots_.back();
+        free_slots_.pop_back();
+    }
+    Pair& pair = pairs_[slot];
+    pair.station = &station;
+    pair.dish = &dish;
+    pair.dish_name = dish.getName();
+    by_dish_[&dish].push_back(slot);
+    ++dishes_[pair.dish_name].stations;
+    indexRecipe(slot);
+}
+
+bool IngredientIndex::removeDish(const KitchenStation& station, const Dish& dish) {
+    size_t slot = findPair(station, dish);
+    if (slot == NO_SLOT) {
+        return false;
+    }
+    unindexRecipe(slot);
+    Pair& pair = pairs_[slot];
+    auto state = dishes_.find(pair.dish_name);
+    if (--state->second.stations == 0) {
+        dishes_.erase(state);
+    }
+    std::vector<size_t>& slots = by_dish_[&dish];
+    slots.erase(std::find(slots.begin(), slots.end(), slot));
+    if (slots.empty()) {
+        by_dish_.erase(&dish);
+    }
+    pair = Pair();
+    free_slots_.push_back(slot);
+    return true;
+}
+
+void IngredientIndex::reindexDish(const Dish& dish) {
+    auto found = by_dish_.find(&dish);
+    if (found == by_dish_.end()) {
+        return;
+    }
+    for (size_t slot : found->second) {
+        unindexRecipe(slot);
+        indexRecipe(slot);
+    }
+}
+
+void IngredientIndex::setInStock(const KitchenStation& station, IngredientId id, bool in_stock) {
+    auto station_uses = uses_.find(&station);
+    if (station_uses == uses_.end()) {
+        return;
+    }
+    auto found = station_uses->second.find(id);
+    if (found == station_uses->second.end()) {
+        return;
+    }
+    for (size_t slot : found->second) {
+        Pair& pair = pairs_[slot];
+        if (in_stock) {
+            if (--pair.missing == 0) {
+                setAvailable(pair.dish_name, 1);
+            }
+        } else if (pair.missing++ == 0) {
+            setAvailable(pair.dish_name, -1);
+        }
+    }
+}
+
+std::vector<IngredientIndex::Use> IngredientIndex::getUses(IngredientId id) const {
+    std::vector<Use> uses;
+    for (const auto& station_uses : uses_) {
+        auto found = station_uses.second.find(id);
+        if (found == station_uses.second.end()) {
+            continue;
+        }
+        for (size_t slot : found->second) {
+            // A recipe that lists the ingredient twice has two entries; report the pair once
+            Use use{pairs_[slot].station, pairs_[slot].dish};
+            if (uses.empty() || uses.back().dish != use.dish || uses.back().station != use.station) {
+                uses.push_back(use);
+            }
+        }
+    }
+    return uses;
+}
+
+bool IngredientIndex::isEightySixed(const std::string& dish_name) const {
+    auto found = dishes_.find(dish_name);
+    return found != dishes_.end() && found->second.available == 0;
+}
+
+std::vector<std::string> IngredientIndex::getEightySixed() const {
+    std::vector<std::string> names;
+    for (const auto& entry : dishes_) {
+        if (entry.second.available == 0) {
+            names.push_back(entry.first);
+        }
+    }
+    return names;
+}
+
+size_t IngredientIndex::findPair(const KitchenStation& station, const Dish& dish) const {
+    auto found = by_dish_.find(&dish);
+    if (found == by_dish_.end()) {
+        return NO_SLOT;
+    }
+    for (size_t slot : found->second) {
+        if (pairs_[slot].station == &station) {
+            return slot;
+        }
+    }
+    return NO_SLOT;
+}
+
+// Reads the dish's recipe and the station's stock, and links the pair under each ingredient
+void IngredientIndex::indexRecipe(size_t slot) {
+    Pair& pair = pairs_[slot];
+    std::unordered_set<IngredientId> held;
+    for (const StockLine& line : pair.station->getStockLines()) {
+        if (line.quantity > 0) {
+            held.insert(line.id);
+        }
+    }
+
+    StationUses& station_uses = uses_[pair.station];
+    pair.recipe.clear();
+    pair.missing = 0;
+    for (const RecipeLine& line : pair.dish->getRecipeLines()) {
+        IngredientId id = line.id;
+        pair.recipe.push_back(id);
+        station_uses[id].push_back(slot);
+        if (held.find(id) == held.end()) {
+            ++pair.missing;
+        }
+    }
+    if (pair.missing == 0) {
+        setAvailable(pair.dish_name, 1);
+    }
+}
+
+void IngredientIndex::unindexRecipe(size_t slot) {
+    Pair& pair = pairs_[slot];
+    if (pair.missing == 0) {
+        setAvailable(pair.dish_name, -1);
+    }
+    StationUses& station_uses = uses_[pair.station];
+    for (IngredientId id : pair.recipe) {
+        std::vector<size_t>& slots = station_uses[id];
+        slots.erase(std::find(slots.begin(), slots.end(), slot));
+        if (slots.empty()) {
+            station_uses.erase(id);
+        }
+    }
+    if (station_uses.empty()) {
+        uses_.erase(pair.station);
+    }
+    pair.recipe.clear();
+    pair.missing = 0;
+}
+
+void IngredientIndex::setAvailable(const std::string& dish_name, int delta) {
+    dishes_[dish_name].available += delta;
+}
+
+size_t IngredientIndex::memoryUsage() const {
+    size_t bytes = heapBytes(pairs_) + heapBytes(free_slots_);
+    for (const Pair& pair : pairs_) {
+        bytes += heapBytes(pair.dish_name) + heapBytes(pair.recipe);
+    }
+    bytes += hashBytes(uses_);
+    for (const auto& station_uses : uses_) {
+        bytes += hashBytes(station_uses.second);
+        for (const auto& slots : station_uses.second) {
+            bytes += heapBytes(slots.second);
+        }
+    }
+    bytes += hashBytes(by_dish_);
+    for (const auto& slots : by_dish_) {
+        bytes += heapBytes(slots.second);
+    }
+    bytes += hashBytes(dishes_);
+    for (const auto& dish : dishes_) {
+        bytes += heapBytes(dish.first);
+    }
+    return bytes;
+}
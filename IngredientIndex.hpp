@@ -0,0 +1,111 @@
+/**
+ * @file IngredientIndex.hpp
+ * @brief This file contains the declaration of the IngredientIndex class, an inverted index from
+ * ingredient IDs to the (station, dish) pairs whose recipe uses them, with the resulting "86" list.
+ *
+ * Each (station, dish) pair counts how many recipe lines the station is missing (holds no positive
+ * stock of). A pair is available when that count is zero, and a dish is 86'd when at least one
+ * station serves it and none of its pairs is available. A stock-out or restock at a station only
+ * touches the pairs at that station that use the ingredient.
+ */
+
+#ifndef INGREDIENTINDEX_HPP
+#define INGREDIENTINDEX_HPP
+
+#include "IngredientRegistry.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class Dish;
+class KitchenStation;
+
+class IngredientIndex {
+public:
+    /**
+     * @struct Use
+     * @brief A station that serves a dish whose recipe uses an ingredient.
+     */
+    struct Use {
+        const KitchenStation* station;
+        const Dish* dish;
+    };
+
+    /**
+     * Indexes a dish served by a station.
+     * @param station The station. Its current stock decides which recipe lines are missing.
+     * @param dish The dish.
+     */
+    void addDish(const KitchenStation& station, const Dish& dish);
+
+    /**
+     * Removes a dish served by a station from the index.
+     * @param station The station.
+     * @param dish The dish.
+     * @return True if the pair was indexed; false otherwise.
+     */
+    bool removeDish(const KitchenStation& station, const Dish& dish);
+
+    /**
+     * Re-reads a dish's recipe at every station that serves it, after the recipe changed.
+     * @param dish The dish.
+     */
+    void reindexDish(const Dish& dish);
+
+    /**
+     * Records that a station's stock of an ingredient ran out or came back.
+     * @param station The station.
+     * @param id The ingredient.
+     * @param in_stock True if the station now holds the ingredient; false if it ran out.
+     */
+    void setInStock(const KitchenStation& station, IngredientId id, bool in_stock);
+
+    /**
+     * @param id An ingredient.
+     * @return The (station, dish) pairs whose recipe uses the ingredient.
+     */
+    std::vector<Use> getUses(IngredientId id) const;
+
+    /**
+     * @param dish_name The name of a dish.
+     * @return True if at least one station serves the dish and every such station is missing an ingredient.
+     */
+    bool isEightySixed(const std::string& dish_name) const;
+
+    /**
+     * @return The names of all 86'd dishes, in no particular order.
+     */
+    std::vector<std::string> getEightySixed() const;
+
+    /**
+     * @return The heap bytes held by the index, estimated as in MemoryUsage.hpp.
+     */
+    size_t memoryUsage() const;
+
+private:
+    struct Pair {
+        const KitchenStation* station;
+        const Dish* dish;
+        std::string dish_name;
+        std::vector<IngredientId> recipe;   // one entry per recipe line
+        int missing;                        // recipe lines the station holds no stock of
+    };
+    struct DishState {
+        int stations;    // pairs serving the dish
+        int available;   // of which missing == 0
+    };
+    typedef std::unordered_map<IngredientId, std::vector<size_t>> StationUses;   // ingredient -> pair slots
+
+    size_t findPair(const KitchenStation& station, const Dish& dish) const;
+    void indexRecipe(size_t slot);
+    void unindexRecipe(size_t slot);
+    void setAvailable(const std::string& dish_name, int delta);
+
+    std::vector<Pair> pairs_;               // slots; a slot with a null dish is free
+    std::vector<size_t> free_slots_;
+    std::unordered_map<const KitchenStation*, StationUses> uses_;
+    std::unordered_map<const Dish*, std::vector<size_t>> by_dish_;
+    std::unordered_map<std::string, DishState> dishes_;
+};
+
+#endif // INGREDIENTINDEX_HPP
@@ -0,0 +1,44 @@
+/**
+ * @file IngredientRegistry.cpp
+ * @brief This file contains the implementation of the IngredientRegistry class.
+ */
+
+#include "IngredientRegistry.hpp"
+
+IngredientRegistry& IngredientRegistry::instance() {
+    static IngredientRegistry registry;
+    return registry;
+}
+
+IngredientId IngredientRegistry::intern(const std::string& ingredient_name) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = ids_.find(ingredient_name);
+    if (found != ids_.end()) {
+        return found->second;
+    }
+    IngredientId id = static_cast<IngredientId>(names_.size());
+    names_.push_back(ingredient_name);
+    ids_.emplace(ingredient_name, id);
+    return id;
+}
+
+bool IngredientRegistry::find(const std::string& ingredient_name, IngredientId& id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto found = ids_.find(ingredient_name);
+    if (found == ids_.end()) {
+        return false;
+    }
+    id = found->second;
+    return true;
+}
+
+const std::string& IngredientRegistry::getName(IngredientId id) const {
+    static const std::string UNKNOWN = "UNKNOWN";
+    std::lock_guard<std::mutex> lock(mutex_);
+    return id < names_.size() ? names_[id] : UNKNOWN;
+}
+
+size_t IngredientRegistry::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return names_.size();
+}
@@ -0,0 +1,66 @@
+/**
+ * @file IngredientRegistry.hpp
+ * @brief This file contains the declaration of the IngredientRegistry class, which gives every
+ * ingredient name a small integer ID.
+ *
+ * IDs are dense (0, 1, 2, ...) and never reused, so they can index arrays and serve as hash keys
+ * that are cheaper to compare than names. The registry is shared by the whole process, so the
+ * same name has the same ID in every kitchen.
+ */
+
+#ifndef INGREDIENTREGISTRY_HPP
+#define INGREDIENTREGISTRY_HPP
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+typedef uint32_t IngredientId;
+
+class IngredientRegistry {
+public:
+    /**
+     * @return The process-wide registry.
+     */
+    static IngredientRegistry& instance();
+
+    /**
+     * Looks up the ID of a name, registering the name if it is new.
+     * @param ingredient_name The name of an ingredient.
+     * @return The ID of the name.
+     */
+    IngredientId intern(const std::string& ingredient_name);
+
+    /**
+     * Looks up the ID of a name without registering it.
+     * @param ingredient_name The name of an ingredient.
+     * @param id Receives the ID if the name is registered.
+     * @return True if the name is registered; false otherwise.
+     */
+    bool find(const std::string& ingredient_name, IngredientId& id) const;
+
+    /**
+     * @param id An ID returned by intern().
+     * @return The name registered under the ID, or "UNKNOWN" if there is none. Names are never
+     * moved or removed, so the reference stays valid for the life of the process.
+     */
+    const std::string& getName(IngredientId id) const;
+
+    /**
+     * @return The number of registered names.
+     */
+    size_t size() const;
+
+private:
+    IngredientRegistry() = default;
+    IngredientRegistry(const IngredientRegistry&) = delete;
+    IngredientRegistry& operator=(const IngredientRegistry&) = delete;
+
+    mutable std::mutex mutex_;
+    std::unordered_map<std::string, IngredientId> ids_;
+    std::deque<std::string> names_;   // names_[id]
+};
+
+#endif // INGREDIENTREGISTRY_HPP
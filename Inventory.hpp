@@ -0,0 +1,448 @@
+/**
+ * @file Inventory.hpp
+ * @brief This file contains the declaration of Inventory, a stock of quantities by key: the "find
+ * by key, add or subtract, erase at zero" logic shared by a station's stock and a kitchen's pantry.
+ *
+ * An Inventory keeps one line (key, quantity, unit price) per key, in the order the keys were first
+ * added; a line whose quantity reaches zero by subtraction is erased, the rest keeping their order.
+ * Two policies choose the rest:
+ *
+ * - Lookup: how a key is found among the lines.
+ *   LinearLookup scans them and stores nothing else (the default; best for the few lines a station
+ *   holds). DenseLookup indexes a table by the key itself, for small dense keys such as
+ *   IngredientIds. OpenHashLookup keeps an open-addressing hash table of positions. SortedLookup
+ *   keeps (key, position) pairs sorted by key and binary-searches them.
+ * - Locking: NoLocking (the default) or MutexLocking, which makes every member function except
+ *   find() and getLines() atomic, so one inventory can be shared between threads.
+ *
+ * inventory_bench compares the policies.
+ */
+
+#ifndef INVENTORY_HPP
+#define INVENTORY_HPP
+
+#include "Money.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * One line of an Inventory.
+ */
+template <typename Key, typename Qty>
+struct InventoryLine {
+    Key id;
+    Qty quantity;
+    Money price;   // Unit price
+};
+
+/**
+ * What an Inventory operation did to a line.
+ */
+template <typename Qty>
+struct InventoryChange {
+    Qty before;    // Quantity before the operation (0 for a new line)
+    Qty after;     // Quantity after it (0 if the line was erased)
+    Money price;   // The line's unit price
+};
+
+/**
+ * Lookup policy that scans the lines.
+ */
+template <typename Key>
+class LinearLookup {
+public:
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    template <typename Line>
+    size_t find(const std::vector<Line>& lines, Key key) const {
+        for (size_t i = 0; i < lines.size(); ++i) {
+            if (lines[i].id == key) {
+                return i;
+            }
+        }
+        return NOT_FOUND;
+    }
+
+    template <typename Line>
+    void inserted(const std::vector<Line>&) {
+    }
+
+    template <typename Line>
+    void erased(const std::vector<Line>&, size_t, Key) {
+    }
+
+    void clear() {
+    }
+
+    size_t getHeapBytes() const {
+        return 0;
+    }
+};
+
+/**
+ * Lookup policy for small non-negative integer keys: a table indexed by key holds each line's
+ * position plus one (0 for none), so a lookup is one load. The table grows to the largest key seen.
+ */
+template <typename Key>
+class DenseLookup {
+public:
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    template <typename Line>
+    size_t find(const std::vector<Line>&, Key key) const {
+        size_t index = static_cast<size_t>(key);
+        if (index >= slots_.size() || slots_[index] == 0) {
+            return NOT_FOUND;
+        }
+        return slots_[index] - 1;
+    }
+
+    template <typename Line>
+    void inserted(const std::vector<Line>& lines) {
+        size_t index = static_cast<size_t>(lines.back().id);
+        if (index >= slots_.size()) {
+            slots_.resize(index + 1, 0);
+        }
+        slots_[index] = static_cast<uint32_t>(lines.size());
+    }
+
+    template <typename Line>
+    void erased(const std::vector<Line>& lines, size_t position, Key key) {
+        slots_[static_cast<size_t>(key)] = 0;
+        for (size_t i = position; i < lines.size(); ++i) { // The lines after it moved down by one
+            slots_[static_cast<size_t>(lines[i].id)] = static_cast<uint32_t>(i + 1);
+        }
+    }
+
+    void clear() {
+        std::fill(slots_.begin(), slots_.end(), 0); // Keeps the table
+    }
+
+    size_t getHeapBytes() const {
+        return slots_.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    std::vector<uint32_t> slots_;
+};
+
+/**
+ * Lookup policy keeping an open-addressing (linear probing) hash table of line positions, at most
+ * half full. Erasing a line shifts the later lines' positions, so the table is then rebuilt in place.
+ */
+template <typename Key, typename Hash = std::hash<Key>>
+class OpenHashLookup {
+public:
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    OpenHashLookup() : slots_(), shift_(64) {
+    }
+
+    template <typename Line>
+    size_t find(const std::vector<Line>& lines, Key key) const {
+        if (slots_.empty()) {
+            return NOT_FOUND;
+        }
+        size_t mask = slots_.size() - 1;
+        for (size_t slot = home(key);; slot = (slot + 1) & mask) {
+            uint32_t entry = slots_[slot];
+            if (entry == 0) {
+                return NOT_FOUND;
+            }
+            if (lines[entry - 1].id == key) {
+                return entry - 1;
+            }
+        }
+    }
+
+    template <typename Line>
+    void inserted(const std::vector<Line>& lines) {
+        if (2 * lines.size() > slots_.size()) {
+            size_t capacity = slots_.empty() ? 16 : 2 * slots_.size();
+            slots_.assign(capacity, 0);
+            shift_ = 64;
+            for (size_t size = capacity; size > 1; size >>= 1) {
+                --shift_;
+            }
+            rebuild(lines);
+            return;
+        }
+        place(lines.back().id, lines.size());
+    }
+
+    template <typename Line>
+    void erased(const std::vector<Line>& lines, size_t, Key) {
+        std::fill(slots_.begin(), slots_.end(), 0);
+        rebuild(lines);
+    }
+
+    void clear() {
+        std::fill(slots_.begin(), slots_.end(), 0);
+    }
+
+    size_t getHeapBytes() const {
+        return slots_.capacity() * sizeof(uint32_t);
+    }
+
+private:
+    std::vector<uint32_t> slots_;   // Position of a line plus one, or 0 for an empty slot
+    int shift_;                     // 64 - log2(slots_.size())
+
+    // Fibonacci hashing spreads sequential keys such as IngredientIds over the table
+    size_t home(Key key) const {
+        return static_cast<size_t>((static_cast<uint64_t>(Hash()(key)) * 0x9E3779B97F4A7C15ull) >> shift_);
+    }
+
+    void place(Key key, size_t entry) {
+        size_t mask = slots_.size() - 1;
+        size_t slot = home(key);
+        while (slots_[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        slots_[slot] = static_cast<uint32_t>(entry);
+    }
+
+    template <typename Line>
+    void rebuild(const std::vector<Line>& lines) {
+        for (size_t i = 0; i < lines.size(); ++i) {
+            place(lines[i].id, i + 1);
+        }
+    }
+};
+
+/**
+ * Lookup policy keeping (key, position) pairs sorted by key, found by binary search.
+ */
+template <typename Key>
+class SortedLookup {
+public:
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    template <typename Line>
+    size_t find(const std::vector<Line>&, Key key) const {
+        auto found = lowerBound(key);
+        return found != entries_.end() && found->first == key ? found->second : NOT_FOUND;
+    }
+
+    template <typename Line>
+    void inserted(const std::vector<Line>& lines) {
+        Key key = lines.back().id;
+        entries_.insert(lowerBound(key), std::make_pair(key, static_cast<uint32_t>(lines.size() - 1)));
+    }
+
+    template <typename Line>
+    void erased(const std::vector<Line>&, size_t position, Key key) {
+        entries_.erase(lowerBound(key));
+        for (std::pair<Key, uint32_t>& entry : entries_) {
+            if (entry.second > position) {
+                --entry.second;
+            }
+        }
+    }
+
+    void clear() {
+        entries_.clear();
+    }
+
+    size_t getHeapBytes() const {
+        return entries_.capacity() * sizeof(std::pair<Key, uint32_t>);
+    }
+
+private:
+    std::vector<std::pair<Key, uint32_t>> entries_;
+
+    typename std::vector<std::pair<Key, uint32_t>>::const_iterator lowerBound(Key key) const {
+        return std::lower_bound(entries_.begin(), entries_.end(), key,
+                                [](const std::pair<Key, uint32_t>& entry, Key wanted) { return entry.first < wanted; });
+    }
+
+    typename std::vector<std::pair<Key, uint32_t>>::iterator lowerBound(Key key) {
+        return std::lower_bound(entries_.begin(), entries_.end(), key,
+                                [](const std::pair<Key, uint32_t>& entry, Key wanted) { return entry.first < wanted; });
+    }
+};
+
+/**
+ * Locking policy for an inventory used by one thread at a time.
+ */
+struct NoLocking {
+    void lock() {
+    }
+    void unlock() {
+    }
+};
+
+/**
+ * Locking policy for an inventory shared between threads.
+ */
+typedef std::mutex MutexLocking;
+
+/**
+ * A stock of Qty units per Key, each line with its own unit price.
+ */
+template <typename Key, typename Qty, template <typename> class Lookup = LinearLookup, typename Locking = NoLocking>
+class Inventory {
+public:
+    typedef InventoryLine<Key, Qty> Line;
+    typedef InventoryChange<Qty> Change;
+
+    Inventory() : lines_(), lookup_(), lock_() {
+    }
+
+    /**
+     * Adds units of a key. An existing line keeps its own unit price.
+     * @param key The key.
+     * @param quantity The units added.
+     * @param price The unit price, used if the key is new.
+     * @return The change to the key's line.
+     */
+    Change add(Key key, Qty quantity, Money price) {
+        std::lock_guard<Locking> guard(lock_);
+        size_t position = lookup_.find(lines_, key);
+        if (position == Lookup<Key>::NOT_FOUND) {
+            lines_.push_back(Line{key, quantity, price});
+            lookup_.inserted(lines_);
+            return Change{Qty(), quantity, price};
+        }
+        Line& line = lines_[position];
+        Qty before = line.quantity;
+        line.quantity += quantity;
+        return Change{before, line.quantity, line.price};
+    }
+
+    /**
+     * Subtracts units of a key without checking they are there; a line reaching exactly zero is erased.
+     * @param key The key.
+     * @param quantity The units subtracted.
+     * @param change Receives the change to the key's line.
+     * @return True if the key had a line; false otherwise (nothing changes).
+     */
+    bool subtract(Key key, Qty quantity, Change& change) {
+        std::lock_guard<Locking> guard(lock_);
+        size_t position = lookup_.find(lines_, key);
+        if (position == Lookup<Key>::NOT_FOUND) {
+            return false;
+        }
+        remove(position, quantity, change);
+        return true;
+    }
+
+    /**
+     * Takes units of a key if all of them are there.
+     * @param key The key.
+     * @param quantity The units wanted.
+     * @param change Receives the change to the key's line; if nothing was taken, change.before is
+     * the quantity held (0 if none).
+     * @return True if the units were taken; false otherwise (nothing changes).
+     */
+    bool take(Key key, Qty quantity, Change& change) {
+        std::lock_guard<Locking> guard(lock_);
+        size_t position = lookup_.find(lines_, key);
+        if (position == Lookup<Key>::NOT_FOUND || lines_[position].quantity < quantity) {
+            Qty held = position == Lookup<Key>::NOT_FOUND ? Qty() : lines_[position].quantity;
+            change = Change{held, held, position == Lookup<Key>::NOT_FOUND ? Money() : lines_[position].price};
+            return false;
+        }
+        remove(position, quantity, change);
+        return true;
+    }
+
+    /**
+     * Takes up to a number of units of a key.
+     * @param key The key.
+     * @param quantity The most units to take.
+     * @param change Receives the change to the key's line; change.before - change.after were taken.
+     * @return True if the key had a line; false otherwise (nothing changes).
+     */
+    bool takeUpTo(Key key, Qty quantity, Change& change) {
+        std::lock_guard<Locking> guard(lock_);
+        size_t position = lookup_.find(lines_, key);
+        if (position == Lookup<Key>::NOT_FOUND) {
+            return false;
+        }
+        remove(position, lines_[position].quantity < quantity ? lines_[position].quantity : quantity, change);
+        return true;
+    }
+
+    /**
+     * @return The units held of a key (0 if none).
+     */
+    Qty getQuantity(Key key) const {
+        std::lock_guard<Locking> guard(lock_);
+        size_t position = lookup_.find(lines_, key);
+        return position == Lookup<Key>::NOT_FOUND ? Qty() : lines_[position].quantity;
+    }
+
+    /**
+     * @return The key's line, or nullptr; valid until the inventory next changes. Not synchronized.
+     */
+    const Line* find(Key key) const {
+        size_t position = lookup_.find(lines_, key);
+        return position == Lookup<Key>::NOT_FOUND ? nullptr : &lines_[position];
+    }
+
+    /**
+     * @return The lines, in the order their keys were first added, without copying. Not synchronized.
+     */
+    const std::vector<Line>& getLines() const {
+        return lines_;
+    }
+
+    /**
+     * @return A copy of the lines, taken atomically.
+     */
+    std::vector<Line> snapshot() const {
+        std::lock_guard<Locking> guard(lock_);
+        return lines_;
+    }
+
+    size_t size() const {
+        std::lock_guard<Locking> guard(lock_);
+        return lines_.size();
+    }
+
+    bool empty() const {
+        std::lock_guard<Locking> guard(lock_);
+        return lines_.empty();
+    }
+
+    /**
+     * Removes every line, keeping the storage.
+     */
+    void clear() {
+        std::lock_guard<Locking> guard(lock_);
+        lines_.clear();
+        lookup_.clear();
+    }
+
+    /**
+     * @return The bytes of the lines' and the lookup's storage.
+     */
+    size_t getHeapBytes() const {
+        std::lock_guard<Locking> guard(lock_);
+        return lines_.capacity() * sizeof(Line) + lookup_.getHeapBytes();
+    }
+
+private:
+    std::vector<Line> lines_;
+    Lookup<Key> lookup_;
+    mutable Locking lock_;
+
+    void remove(size_t position, Qty quantity, Change& change) {
+        Line& line = lines_[position];
+        change = Change{line.quantity, line.quantity - quantity, line.price};
+        line.quantity = change.after;
+        if (change.after == Qty()) {
+            Key key = line.id;
+            lines_.erase(lines_.begin() + position);
+            lookup_.erased(lines_, position, key);
+        }
+    }
+};
+
+#endif // INVENTORY_HPP
@@ -0,0 +1,233 @@
+/**
+ * @file KitchenFederation.cpp
+ * @brief This file contains the implementation of the KitchenFederation class.
+ */
+
+#include "KitchenFederation.hpp"
+#include <algorithm>
+#include <map>
+
+KitchenFederation::KitchenFederation(RoutingPolicy policy, int batch_quantity)
+    : policy_(policy), batch_quantity_(batch_quantity > 0 ? batch_quantity : 1),
+      transfer_count_(0), units_transferred_(0) {
+}
+
+KitchenFederation::~KitchenFederation() {
+    for (StationManager* kitchen : kitchens_) {
+        kitchen->setBackupSupplier(nullptr);
+    }
+}
+
+int KitchenFederation::addKitchen(const std::string& name, StationManager* kitchen) {
+    if (kitchen == nullptr) {
+        return -1;
+    }
+    names_.push_back(name);
+    kitchens_.push_back(kitchen);
+    kitchen->setBackupSupplier(this);
+    refreshRoutes();
+    return kitchens_.size() - 1;
+}
+
+void KitchenFederation::refreshRoutes() {
+    routes_.clear();
+    next_route_.clear();
+    for (size_t i = 0; i < kitchens_.size(); ++i) {
+        for (Dish* dish : kitchens_[i]->getMenu()) {
+            routes_[dish->getName()].push_back(i);
+        }
+    }
+}
+
+int KitchenFederation::routeOrder(Dish* dish, int home) {
+    if (dish == nullptr) {
+        return -1;
+    }
+    auto found = routes_.find(dish->getName());
+    if (found == routes_.end()) {
+        return -1;
+    }
+    const std::vector<int>& candidates = found->second;
+
+    int chosen = candidates.front();
+    switch (policy_) {
+        case HOME_FIRST:
+            for (int kitchen : candidates) {
+                if (kitchen == home) {
+                    chosen = kitchen;
+                    break;
+                }
+            }
+            break;
+        case ROUND_ROBIN: {
+            size_t& cursor = next_route_[found->first];
+            chosen = candidates[cursor % candidates.size()];
+            ++cursor;
+            break;
+        }
+        case LEAST_LOADED:
+            for (int kitchen : candidates) {
+                if (kitchens_[kitchen]->getDishQueueSize() < kitchens_[chosen]->getDishQueueSize()) {
+                    chosen = kitchen;
+                }
+            }
+            break;
+    }
+
+    kitchens_[chosen]->addDishToQueue(dish);
+    return chosen;
+}
+
+void KitchenFederation::processAllKitchens(std::ostream& out, std::vector<bool>* results) {
+    for (StationManager* kitchen : kitchens_) {
+        kitchen->processAllDishes(out, results);
+    }
+}
+
+int KitchenFederation::executeTransfer(const Transfer& transfer) {
+    if (transfer.from < 0 || transfer.from >= static_cast<int>(kitchens_.size()) ||
+        transfer.to < 0 || transfer.to >= static_cast<int>(kitchens_.size()) || transfer.from == transfer.to) {
+        return 0;
+    }
+    StationManager* donor = kitchens_[transfer.from];
+    StationManager* receiver = kitchens_[transfer.to];
+
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    int moved = 0;
+    for (const Ingredient& line : transfer.lines) {
+        IngredientId id;
+        const StockLine* held = registry.find(line.name, id) ? donor->findBackupLine(id) : nullptr;
+        if (held == nullptr) {
+            continue;
+        }
+        Money price = held->price; // Read before the withdrawal, which removes a depleted line
+        int taken = donor->withdrawBackupIngredient(line.name, line.quantity);
+        if (taken > 0) {
+            receiver->addBackupIngredient(Ingredient(line.name, taken, 0, price));
+            moved += taken;
+        }
+    }
+    if (moved > 0) {
+        ++transfer_count_;
+        units_transferred_ += moved;
+    }
+    return moved;
+}
+
+std::vector<KitchenFederation::Transfer> KitchenFederation::planRebalance(int low_watermark) const {
+    // backup quantity of every ingredient in every kitchen
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    std::map<std::string, std::vector<int>> stock;
+    for (size_t i = 0; i < kitchens_.size(); ++i) {
+        for (const StockLine& line : kitchens_[i]->getBackupLines()) {
+            std::vector<int>& quantities = stock[registry.getName(line.id)];
+            quantities.resize(kitchens_.size(), 0);
+            quantities[i] += line.quantity;
+        }
+    }
+
+    std::map<std::pair<int, int>, Transfer> plan;
+    for (auto& entry : stock) {
+        std::vector<int>& quantities = entry.second;
+        for (size_t to = 0; to < quantities.size(); ++to) {
+            while (quantities[to] < low_watermark) {
+                // Take from the kitchen with the largest surplus above the watermark
+                int from = -1;
+                for (size_t i = 0; i < quantities.size(); ++i) {
+                    if (quantities[i] > low_watermark && (from < 0 || quantities[i] > quantities[from])) {
+                        from = i;
+                    }
+                }
+                if (from < 0) {
+                    break;
+                }
+                int amount = std::min(low_watermark - quantities[to], quantities[from] - low_watermark);
+                quantities[from] -= amount;
+                quantities[to] += amount;
+
+                Transfer& transfer = plan[std::make_pair(from, static_cast<int>(to))];
+                transfer.from = from;
+                transfer.to = to;
+                transfer.lines.push_back(Ingredient(entry.first, amount, 0, 0.0));
+            }
+        }
+    }
+
+    std::vector<Transfer> transfers;
+    for (auto& entry : plan) {
+        transfers.push_back(entry.second);
+    }
+    return transfers;
+}
+
+bool KitchenFederation::requestBackup(StationManager& requester, const std::string& ingredient_name, int quantity) {
+    int to = indexOf(requester);
+    if (to < 0 || quantity <= 0) {
+        return false;
+    }
+
+    IngredientId id;
+    if (!IngredientRegistry::instance().find(ingredient_name, id)) {
+        return false; // No kitchen has ever stocked it
+    }
+    int from = -1;
+    int best = 0;
+    for (size_t i = 0; i < kitchens_.size(); ++i) {
+        int available = static_cast<int>(i) == to ? 0 : backupQuantity(i, id);
+        if (available > best) {
+            best = available;
+            from = i;
+        }
+    }
+    if (from < 0 || best < quantity) {
+        return false;
+    }
+
+    // Move a whole batch (or the donor's half, if smaller) so the next shortfall is already covered
+    int amount = quantity;
+    if (amount < batch_quantity_) {
+        amount = std::min(batch_quantity_, std::max(quantity, best / 2));
+    }
+    Transfer transfer{from, to, {Ingredient(ingredient_name, amount, 0, 0.0)}};
+    return executeTransfer(transfer) >= quantity;
+}
+
+int KitchenFederation::getKitchenCount() const {
+    return kitchens_.size();
+}
+
+StationManager* KitchenFederation::getKitchen(int index) const {
+    if (index < 0 || index >= static_cast<int>(kitchens_.size())) {
+        return nullptr;
+    }
+    return kitchens_[index];
+}
+
+std::string KitchenFederation::getKitchenName(int index) const {
+    if (index < 0 || index >= static_cast<int>(names_.size())) {
+        return "";
+    }
+    return names_[index];
+}
+
+unsigned long KitchenFederation::getTransferCount() const {
+    return transfer_count_;
+}
+
+unsigned long KitchenFederation::getUnitsTransferred() const {
+    return units_transferred_;
+}
+
+int KitchenFederation::indexOf(const StationManager& kitchen) const {
+    for (size_t i = 0; i < kitchens_.size(); ++i) {
+        if (kitchens_[i] == &kitchen) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+int KitchenFederation::backupQuantity(int kitchen, IngredientId id) const {
+    const StockLine* line = kitchens_[kitchen]->findBackupLine(id);
+    return line == nullptr ? 0 : line->quantity;
+}
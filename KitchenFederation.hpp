@@ -0,0 +1,156 @@
+/**
+ * @file KitchenFederation.hpp
+ * @brief This file contains the declaration of the KitchenFederation class, which routes orders across
+ * several kitchens and moves pantry stock between them.
+ *
+ * Every member kitchen keeps its own stations, queue and backup stock. The federation installs
+ * itself as each kitchen's BackupSupplier, so when a kitchen's backup runs short during
+ * replenishStationIngredientFromBackup() the shortfall is transferred from a sister kitchen.
+ * Transfers move whole batches (at least the configured batch size) so that a kitchen which
+ * runs dry does not go back to its sisters for every dish.
+ */
+
+#ifndef KITCHENFEDERATION_HPP
+#define KITCHENFEDERATION_HPP
+
+#include "StationManager.hpp"
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class KitchenFederation : public BackupSupplier {
+public:
+    /**
+     * @enum RoutingPolicy
+     * @brief Describes how an order picks a kitchen among those that serve the dish.
+     */
+    enum RoutingPolicy {
+        HOME_FIRST,     // The order's home kitchen if it serves the dish, otherwise the first kitchen that does
+        ROUND_ROBIN,    // Rotate through the kitchens that serve the dish
+        LEAST_LOADED    // The kitchen that serves the dish with the shortest queue
+    };
+
+    /**
+     * Struct representing a batch of pantry stock moving between two kitchens.
+     */
+    struct Transfer {
+        int from;                        // Donor kitchen index
+        int to;                          // Receiving kitchen index
+        std::vector<Ingredient> lines;   // Ingredients and quantities to move
+    };
+
+    /**
+     * Parameterized constructor.
+     * @param policy The routing policy for routeOrder().
+     * @param batch_quantity The smallest number of units moved when a kitchen runs short.
+     */
+    KitchenFederation(RoutingPolicy policy = HOME_FIRST, int batch_quantity = 64);
+
+    /**
+     * Destructor.
+     * @post: Removes the federation as the backup supplier of every member kitchen.
+     */
+    ~KitchenFederation();
+
+    KitchenFederation(const KitchenFederation&) = delete;
+    KitchenFederation& operator=(const KitchenFederation&) = delete;
+
+    /**
+     * Adds a kitchen to the federation.
+     * @param name The name of the kitchen.
+     * @param kitchen The kitchen's station manager. The caller keeps ownership.
+     * @post: The federation is the kitchen's backup supplier and the dish routes are rebuilt.
+     * @return The index of the kitchen, or -1 if kitchen is null.
+     */
+    int addKitchen(const std::string& name, StationManager* kitchen);
+
+    /**
+     * Rebuilds the dish-to-kitchen routes from the kitchens' menus.
+     * @post: Must be called after dishes are assigned to stations of a member kitchen.
+     */
+    void refreshRoutes();
+
+    /**
+     * Queues an order at the kitchen chosen by the routing policy.
+     * @param dish A pointer to the dish to prepare.
+     * @param home The index of the order's home kitchen (used by HOME_FIRST).
+     * @return The index of the kitchen that received the order, or -1 if no kitchen serves the dish.
+     */
+    int routeOrder(Dish* dish, int home = 0);
+
+    /**
+     * Processes the queue of every member kitchen.
+     * @param out The stream that receives the preparation logs.
+     * @param results If not null, receives the per-dish results of every kitchen, kitchen by kitchen.
+     */
+    void processAllKitchens(std::ostream& out, std::vector<bool>* results = nullptr);
+
+    /**
+     * Moves a batch of stock from one kitchen's backup to another's.
+     * @param transfer The transfer to execute.
+     * @post: Each line moves as many units as the donor has, up to the requested quantity.
+     * @return The total number of units moved.
+     */
+    int executeTransfer(const Transfer& transfer);
+
+    /**
+     * Plans transfers that bring every kitchen's backup of every ingredient up to a low watermark,
+     * taking stock from the kitchens that have the most of it. One transfer is planned per
+     * donor/receiver pair, covering all of its ingredients.
+     * @param low_watermark The backup quantity every kitchen should have of every ingredient any kitchen stocks.
+     * @return The planned transfers (not yet executed).
+     */
+    std::vector<Transfer> planRebalance(int low_watermark) const;
+
+    /**
+     * Takes the shortfall, rounded up to the batch quantity, from the sister kitchen with the most stock.
+     * @param requester The kitchen whose backup ran short. It must be a member.
+     * @param ingredient_name The name of the missing ingredient.
+     * @param quantity The number of units the kitchen is short.
+     * @return True if at least `quantity` units were moved; false otherwise.
+     */
+    bool requestBackup(StationManager& requester, const std::string& ingredient_name, int quantity) override;
+
+    /**
+     * @return The number of member kitchens.
+     */
+    int getKitchenCount() const;
+
+    /**
+     * @param index The index of a member kitchen.
+     * @return The kitchen's station manager, or nullptr if the index is invalid.
+     */
+    StationManager* getKitchen(int index) const;
+
+    /**
+     * @param index The index of a member kitchen.
+     * @return The kitchen's name, or an empty string if the index is invalid.
+     */
+    std::string getKitchenName(int index) const;
+
+    /**
+     * @return The number of transfers executed so far.
+     */
+    unsigned long getTransferCount() const;
+
+    /**
+     * @return The number of units moved between kitchens so far.
+     */
+    unsigned long getUnitsTransferred() const;
+
+private:
+    int indexOf(const StationManager& kitchen) const;
+    int backupQuantity(int kitchen, IngredientId id) const;
+
+    RoutingPolicy policy_;
+    int batch_quantity_;
+    std::vector<std::string> names_;
+    std::vector<StationManager*> kitchens_;
+    std::unordered_map<std::string, std::vector<int>> routes_;   // dish name -> kitchens that serve it
+    std::unordered_map<std::string, size_t> next_route_;          // round-robin cursor per dish
+    unsigned long transfer_count_;
+    unsigned long units_transferred_;
+};
+
+#endif // KITCHENFEDERATION_HPP
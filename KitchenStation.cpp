@@ -1,11 +1,11 @@
 #include "KitchenStation.hpp"
 
 KitchenStation::KitchenStation() 
-    : station_name_("UNKNOWN"), dishes_({}), ingredients_stock_({}) {
+    : station_name_("UNKNOWN"), dishes_({}), stock_(), observer_(nullptr), inventory_value_() {
 }
 
 KitchenStation::KitchenStation(const std::string& station_name) 
-    : station_name_(station_name), dishes_({}), ingredients_stock_({}) {
+    : station_name_(station_name), dishes_({}), stock_(), observer_(nullptr), inventory_value_() {
 }
 
 KitchenStation::~KitchenStation() {
@@ -13,7 +13,7 @@ KitchenStation::~KitchenStation() {
         delete dish;
     }
 }
-std::string KitchenStation::getName() const {
+const std::string& KitchenStation::getName() const {
     return station_name_;
 }
 void KitchenStation::setName(const std::string& station_name) {
@@ -21,14 +21,50 @@ void KitchenStation::setName(const std::string& station_name) {
 }
 
 // get dishes
-std::vector<Dish*> KitchenStation::getDishes() const
+const std::vector<Dish*>& KitchenStation::getDishes() const
 {
     return dishes_;
 }
 // get ingredients stock
 std::vector<Ingredient> KitchenStation::getIngredientsStock() const
 {
-    return ingredients_stock_;
+    std::vector<Ingredient> ingredients;
+    ingredients.reserve(stock_.size());
+    for (const StockLine& line : stock_.getLines()) {
+        ingredients.push_back(toIngredient(line));
+    }
+    return ingredients;
+}
+
+const std::vector<StockLine>& KitchenStation::getStockLines() const {
+    return stock_.getLines();
+}
+
+int KitchenStation::getStockQuantity(const std::string& ingredient_name) const {
+    IngredientId id;
+    if (!IngredientRegistry::instance().find(ingredient_name, id)) {
+        return 0;
+    }
+    return getStockQuantity(id);
+}
+
+int KitchenStation::getStockQuantity(IngredientId id) const {
+    return stock_.getQuantity(id);
+}
+
+long KitchenStation::getInventoryValueCents() const {
+    return static_cast<long>(inventory_value_.getCents());
+}
+
+MemoryUsage KitchenStation::memoryUsage() const {
+    MemoryUsage usage;
+    usage.objects = sizeof(KitchenStation) + heapBytes(dishes_);
+    usage.strings = heapBytes(station_name_);
+    usage.ingredients = stock_.getHeapBytes();
+    for (const Dish* dish : dishes_) {
+        usage += dish->memoryUsage();
+    }
+    return usage;
 }
 
 bool KitchenStation::assignDishToStation(Dish* dish) {
@@ -40,6 +76,9 @@ bool KitchenStation::assignDishToStation(Dish* dish) {
     }
     else {  
         dishes_.push_back(dish);
+        if (observer_ != nullptr) {
+            observer_->onDishAssigned(*this, *dish);
+        }
         return true;
     }
 }
@@ -54,104 +93,105 @@ bool KitchenStation::isPresent(const std::string& dish_name) const {
 }
 
 void KitchenStation::replenishStationIngredients(const Ingredient& ingredient) {
-    //check if ingredient is already in stock
-    for (Ingredient& stock_ingredient : ingredients_stock_) {
-        if (stock_ingredient.name == ingredient.name) {
-            // std::cout<< "Found ingredient "<< stock_ingredient.name << std::endl;
-            // std::cout<< "We have "<< stock_ingredient.quantity << " of "<< stock_ingredient.name << std::endl;
-            // std::cout<< "We are adding "<< ingredient.quantity << " of "<< ingredient.name << std::endl;
-            stock_ingredient.quantity += ingredient.quantity;
-            // std::cout<< "We now have "<< stock_ingredient.quantity << " of "<< stock_ingredient.name << std::endl;
-            return;
-        }
-    }
-    ingredients_stock_.push_back(ingredient);
+    replenishStationIngredients(toStockLine(ingredient));
+}
+
+void KitchenStation::replenishStationIngredients(const StockLine& added) {
+    IngredientStock::Change change = stock_.add(added.id, added.quantity, added.price); // An existing line keeps its price
+    notifyStockChanged(added.id, change.before, change.after, change.price * added.quantity);
 }
 
 bool KitchenStation::canCompleteOrder(const std::string& dish_name) const {
     for (Dish* dish : dishes_) {
-        // std::cout<< "Dish name: "<< dish->getName()<<std::endl;
         if (dish->getName() == dish_name) {
-            // std::cout << "Checking if we can complete order for " << dish_name << std::endl;
-            for (Ingredient ingredient : dish->getIngredients()) {
-                // std::cout << "Checking for ingredient " << ingredient.name << std::endl;
-                bool found = false;
-                for (Ingredient stock_ingredient : ingredients_stock_) {
-                    if (stock_ingredient.name == ingredient.name) {
-                        // std::cout<< "Found ingredient "<< stock_ingredient.name << " and we have "<< stock_ingredient.quantity << std::endl;
-                        if (stock_ingredient.quantity >= ingredient.required_quantity) {
-                            // std::cout<<"YAY We need "<< ingredient.required_quantity << " of "<< ingredient.name << " and we have "<< stock_ingredient.quantity << std::endl;
-                            // std::cout << "Found enough quantity of " << stock_ingredient.name << std::endl;
-                            found = true;
-                        }
-                        else {
-                            // std::cout << "Did not find enough quantity of " << stock_ingredient.name << std::endl;
-                            // std::cout<<"NO We need "<< ingredient.required_quantity << " of "<< ingredient.name << " and we have "<< stock_ingredient.quantity << std::endl;
-                            return false;
-                        }
-                    }
-                }
-                if (!found) {
-                    // std::cout<< "Did not find " << ingredient.name << std::endl;
-                    return false;
-                }
-            }
-            return true;
+            return canCompleteLines(dish->getRecipeLines());
         }
     }
     return false;
 }
 
-bool KitchenStation::prepareDish(const std::string& dish_name) {
-    if (!canCompleteOrder(dish_name)) {
-        return false;
+bool KitchenStation::canCompleteRecipe(const std::vector<Ingredient>& recipe) const {
+    for (const Ingredient& ingredient : recipe) {
+        IngredientId id;
+        if (!IngredientRegistry::instance().find(ingredient.name, id)) {
+            return false; // Never stocked anywhere
+        }
+        const StockLine* line = stock_.find(id);
+        if (line == nullptr || line->quantity < ingredient.required_quantity) {
+            return false;
+        }
     }
-    else{
-        //std::cout<< "Preparing dish: "<< dish_name << std::endl;
+    return true;
+}
+
+bool KitchenStation::canCompleteLines(const std::vector<RecipeLine>& recipe) const {
+    for (const RecipeLine& required : recipe) {
+        const StockLine* line = stock_.find(required.id);
+        if (line == nullptr || line->quantity < required.required) {
+            return false;
+        }
     }
+    return true;
+}
+
+bool KitchenStation::prepareDish(const std::string& dish_name) {
     for (Dish* dish : dishes_) {
         if (dish->getName() == dish_name) {
-            // Check if we have all the ingredients and the right quantity before doing anything else
-            for (Ingredient ingredient : dish->getIngredients()) {
-                bool found = false;
-                for (Ingredient& stock_ingredient : ingredients_stock_) {
-                    if (stock_ingredient.name == ingredient.name) {
-                        // Check if we have enough stock
-                        if (stock_ingredient.quantity >= ingredient.quantity) {
-                            found = true;
-                            break; // breaks out of the inner loop, so we check the next ingredient
-                        }
-                    }
-                }
-                if (!found) { // one of the ingredients is missing or not enough
-                    return false;
-                }
-                // If we reach this point, we have all the ingredients in stock. Hooray!
-            }
-            // Deduct the ingredients from stock
-            for (Ingredient ingredient : dish->getIngredients()) {
-                for (Ingredient& stock_ingredient : ingredients_stock_) {
-                    if (stock_ingredient.name == ingredient.name) {
-                        stock_ingredient.quantity -= ingredient.required_quantity;
-                        // if we have 0 quantity of an ingredient, we should remove it from stock
-                        if (stock_ingredient.quantity == 0) {
-                            removeIngredient(stock_ingredient.name);
-                        }
-                    }
-                }
-            }
-            return true;
+            return canCompleteLines(dish->getRecipeLines()) && deductLines(dish->getRecipeLines());
         }
     }
     return false; 
 }
 
-bool KitchenStation::removeIngredient(const std::string& ingredient_name) {
-    for (size_t i = 0; i < ingredients_stock_.size(); i++) {
-        if (ingredients_stock_[i].name == ingredient_name) {
-            ingredients_stock_.erase(ingredients_stock_.begin() + i);
-            return true;
-        }
+bool KitchenStation::prepareRecipe(const std::vector<Ingredient>& recipe) {
+    if (!canCompleteRecipe(recipe)) {
+        return false;
     }
-    return false;
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    for (const Ingredient& ingredient : recipe) {
+        IngredientId id;
+        registry.find(ingredient.name, id); // Registered, since the stock holds it
+        deductStock(id, ingredient.required_quantity);
+    }
+    return true;
+}
+
+// Deducts a recipe the stock was checked to cover
+bool KitchenStation::prepareLines(const std::vector<RecipeLine>& recipe) {
+    return canCompleteLines(recipe) && deductLines(recipe);
+}
+
+bool KitchenStation::deductLines(const std::vector<RecipeLine>& recipe) {
+    for (const RecipeLine& required : recipe) {
+        deductStock(required.id, required.required);
+    }
+    return true;
+}
+
+void KitchenStation::deductStock(IngredientId id, int required) {
+    IngredientStock::Change change;
+    // if we have 0 quantity of an ingredient, the inventory removes it from stock
+    if (stock_.subtract(id, required, change)) {
+        notifyStockChanged(id, change.before, change.after, -(change.price * required));
+    }
+}
+
+// Updates the inventory value and reports the change, plus a stock-out or restock when the quantity crosses zero
+void KitchenStation::notifyStockChanged(IngredientId id, int before, int after, Money value_delta) {
+    inventory_value_ += value_delta;
+    if (observer_ == nullptr) {
+        return;
+    }
+    observer_->onStockChanged(*this, id, after - before, static_cast<long>(value_delta.getCents()));
+    if ((before > 0) != (after > 0)) {
+        observer_->onStockAvailability(*this, id, after > 0);
+    }
+}
+
+void KitchenStation::setObserver(StationObserver* observer) {
+    observer_ = observer;
+}
+
+StationObserver* KitchenStation::getObserver() const {
+    return observer_;
 }
\ No newline at end of file
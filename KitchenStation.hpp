@@ -1,4 +1,5 @@
 #ifndef KITCHENSTATION_HPP
+#define KITCHENSTATION_HPP
 
 #include <iostream>
 #include <vector>
@@ -7,34 +8,77 @@
 #include <cctype>
 #include "Dish.hpp"
 
+class KitchenStation;
+
+// Interface notified when a station's dishes or stock change
+class StationObserver {
+    public:
+        virtual ~StationObserver() = default;
+        // called after a dish was assigned to the station
+        virtual void onDishAssigned(const KitchenStation& station, const Dish& dish) = 0;
+        // called after the stock of an ingredient changed by delta units (negative when used),
+        // changing the station's inventory value by value_delta_cents
+        virtual void onStockChanged(const KitchenStation& station, IngredientId id, int delta, long value_delta_cents) = 0;
+        // called after the station ran out of an ingredient (in_stock false) or holds it again (in_stock true)
+        virtual void onStockAvailability(const KitchenStation& station, IngredientId id, bool in_stock) = 0;
+};
+
 class KitchenStation {
 
     private:
         std::string station_name_;
         std::vector<Dish*> dishes_;
-        std::vector<Ingredient> ingredients_stock_;
+        IngredientStock stock_;   // compact stock lines; names live in the IngredientRegistry
+        StationObserver* observer_;
+        Money inventory_value_;   // sum of quantity * unit price over the stock
 
         bool isPresent(const std::string& dish_name) const;
-        bool removeIngredient(const std::string& ingredient_name);
+        bool deductLines(const std::vector<RecipeLine>& recipe);
+        void deductStock(IngredientId id, int required);
+        void notifyStockChanged(IngredientId id, int before, int after, Money value_delta);
 
     public:
         KitchenStation();
         KitchenStation(const std::string& station_name);
         ~KitchenStation();
 
-        // get name of station
-        std::string getName() const;
+        // get name of station, without copying
+        const std::string& getName() const;
         // set name of station
         void setName(const std::string& station_name);
-        // get dishes
-        std::vector<Dish*> getDishes() const;
-        // get ingredients stock
+        // get dishes, without copying
+        const std::vector<Dish*>& getDishes() const;
+        // get ingredients stock, converted from the compact stock lines
         std::vector<Ingredient> getIngredientsStock() const;
+        // get the compact stock lines, without copying
+        const std::vector<StockLine>& getStockLines() const;
+        // get the quantity in stock of an ingredient (0 if none)
+        int getStockQuantity(const std::string& ingredient_name) const;
+        int getStockQuantity(IngredientId id) const;
+        // get the value of the stock in cents (each line valued at its own unit price), kept up to date on every change
+        long getInventoryValueCents() const;
+        // get the memory used by the station, its stock and its dishes
+        MemoryUsage memoryUsage() const;
 
         bool assignDishToStation(Dish* dish);
         void replenishStationIngredients(const Ingredient& ingredient);
+        // replenish from a stock line, without converting a name
+        void replenishStationIngredients(const StockLine& added);
         bool canCompleteOrder(const std::string& dish_name) const;
         bool prepareDish(const std::string& dish_name);
+        // check stock against a recipe given directly rather than by assigned dish name
+        bool canCompleteRecipe(const std::vector<Ingredient>& recipe) const;
+        // prepare a recipe given directly rather than by assigned dish name
+        bool prepareRecipe(const std::vector<Ingredient>& recipe);
+        // check stock against compact recipe lines, e.g. an assigned dish's getRecipeLines()
+        bool canCompleteLines(const std::vector<RecipeLine>& recipe) const;
+        // prepare compact recipe lines, without looking the dish up by name
+        bool prepareLines(const std::vector<RecipeLine>& recipe);
+
+        // set the observer notified of dish and stock changes (nullptr for none)
+        void setObserver(StationObserver* observer);
+        // get the observer
+        StationObserver* getObserver() const;
 
 };
 
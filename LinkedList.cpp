@@ -256,4 +256,14 @@ Node<T> *LinkedList<T>::getHeadNode() const
 } //end getHeadNode
 
 
+template<class T>
+MemoryUsage LinkedList<T>::memoryUsage() const
+{
+   MemoryUsage usage;
+   usage.objects = sizeof(LinkedList<T>);
+   usage.nodes = item_count_ * sizeof(Node<T>);
+   return usage;
+} //end memoryUsage
+
+
 //  End of implementation file.
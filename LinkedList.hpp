@@ -15,6 +15,7 @@
 
 #include "Node.hpp"
 #include "PrecondViolatedExcep.hpp"
+#include "MemoryUsage.hpp"
 #include <iostream>
 
 template<class T>
@@ -67,6 +68,9 @@ public:
 
     Node<T> *getHeadNode() const;
 
+    /**@return the memory used by the list object and its nodes, not by what the items point to */
+    MemoryUsage memoryUsage() const;
+
 
 
 
@@ -262,4 +262,19 @@ std::string MainCourse::cookingMethodToString(const CookingMethod &cooking_metho
         case RAW:
             return "RAW";
     }
-}
\ No newline at end of file
+}
+
+MemoryUsage MainCourse::memoryUsage() const {
+    MemoryUsage usage = Dish::memoryUsage();
+    usage.objects += sizeof(MainCourse) - sizeof(Dish);
+    usage.strings += heapBytes(protein_type_);
+    usage.ingredients += heapBytes(side_dishes_);
+    for (const SideDish& side_dish : side_dishes_) {
+        usage.strings += heapBytes(side_dish.name);
+    }
+    return usage;
+}
+
+MainCourse* MainCourse::clone() const {
+    return new MainCourse(*this);
+}
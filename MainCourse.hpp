@@ -136,6 +136,16 @@ public:
     */
     void dietaryAccommodations(const DietaryRequest &request) override;
 
+    /**
+     * @return The memory used by the main course, including its protein type and side dishes.
+     */
+    MemoryUsage memoryUsage() const override;
+
+    /**
+     * @return A copy of the main course, which the caller owns.
+     */
+    MainCourse* clone() const override;
+
 private:
     // Helper function to convert cooking method to string
     std::string cookingMethodToString(const CookingMethod &cooking_method) const;
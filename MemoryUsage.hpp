@@ -0,0 +1,106 @@
+/**
+ * @file MemoryUsage.hpp
+ * @brief This file contains the MemoryUsage breakdown reported by memoryUsage() methods, and
+ * helpers that estimate the heap storage of standard containers.
+ *
+ * The estimates follow libstdc++: a string keeps up to 15 characters inside the object, a deque
+ * allocates 512-byte chunks, and a hash container allocates one node per element (the element
+ * plus a next pointer and a cached hash) and one pointer per bucket. Allocator overhead is not
+ * counted, so the figures are a lower bound that tracks layout changes rather than an exact RSS.
+ */
+
+#ifndef MEMORYUSAGE_HPP
+#define MEMORYUSAGE_HPP
+
+#include <cstddef>
+#include <deque>
+#include <queue>
+#include <string>
+#include <vector>
+
+/**
+ * @struct MemoryUsage
+ * @brief Bytes used by an object and everything it owns, by kind.
+ */
+struct MemoryUsage {
+    size_t objects = 0;       // the objects themselves, plus arrays of pointers to them
+    size_t nodes = 0;         // linked list nodes
+    size_t strings = 0;       // string characters stored outside the string objects
+    size_t ingredients = 0;   // recipe, stock and side dish vectors
+    size_t queue = 0;         // dish queue storage
+    size_t pantry = 0;        // backup ingredient storage, including its strings
+    size_t indexes = 0;       // lookup tables, statistics and caches kept next to the data
+
+    /**
+     * @return The sum of every field.
+     */
+    size_t total() const {
+        return objects + nodes + strings + ingredients + queue + pantry + indexes;
+    }
+
+    MemoryUsage& operator+=(const MemoryUsage& other) {
+        objects += other.objects;
+        nodes += other.nodes;
+        strings += other.strings;
+        ingredients += other.ingredients;
+        queue += other.queue;
+        pantry += other.pantry;
+        indexes += other.indexes;
+        return *this;
+    }
+};
+
+/**
+ * @return The bytes a string stores outside itself; 0 while it fits in the object.
+ */
+inline size_t heapBytes(const std::string& text) {
+    return text.capacity() > std::string().capacity() ? text.capacity() + 1 : 0;
+}
+
+/**
+ * @return The bytes of a vector's buffer, not counting what the elements own.
+ */
+template<class T>
+size_t heapBytes(const std::vector<T>& items) {
+    return items.capacity() * sizeof(T);
+}
+
+/**
+ * @return The bytes of the chunks and chunk map of a deque of `count` elements, not counting what
+ * the elements own.
+ */
+template<class T>
+size_t dequeBytes(size_t count) {
+    const size_t CHUNK = 512;
+    size_t per_chunk = sizeof(T) < CHUNK ? CHUNK / sizeof(T) : 1;
+    size_t chunks = count / per_chunk + 1;
+    size_t map_slots = chunks + 2 < 8 ? 8 : chunks + 2;
+    return chunks * per_chunk * sizeof(T) + map_slots * sizeof(T*);
+}
+
+/**
+ * @return The bytes of a deque's chunks and chunk map, not counting what the elements own.
+ */
+template<class T>
+size_t heapBytes(const std::deque<T>& items) {
+    return dequeBytes<T>(items.size());
+}
+
+/**
+ * @return The bytes of a deque-backed queue's storage, not counting what the elements own.
+ */
+template<class T>
+size_t heapBytes(const std::queue<T>& items) {
+    return dequeBytes<T>(items.size());
+}
+
+/**
+ * @return The bytes of a hash container's nodes and buckets, not counting what the elements own.
+ */
+template<class HashContainer>
+size_t hashBytes(const HashContainer& table) {
+    size_t node = sizeof(typename HashContainer::value_type) + 2 * sizeof(void*);   // element, next, hash
+    return table.bucket_count() * sizeof(void*) + table.size() * node;
+}
+
+#endif // MEMORYUSAGE_HPP
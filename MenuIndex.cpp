@@ -0,0 +1,278 @@
+/**
+ * @file MenuIndex.cpp
+ * @brief This file contains the implementation of the MenuIndex class.
+ */
+
+#include "MenuIndex.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "Dessert.hpp"
+#include <algorithm>
+#include <climits>
+
+namespace {
+const size_t BUCKET = 1024;              // ranks between cumulative bitmaps
+const int CUISINE_COUNT = Dish::OTHER + 1;
+const int COURSE_COUNT = MenuIndex::OTHER_COURSE + 1;
+
+Dish::CuisineType cuisineOf(const Dish& dish) {
+    static const char* names[] = {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH"};
+    std::string cuisine = dish.getCuisineType();
+    for (int i = 0; i < Dish::OTHER; ++i) {
+        if (cuisine == names[i]) {
+            return static_cast<Dish::CuisineType>(i);
+        }
+    }
+    return Dish::OTHER;
+}
+
+void setBit(std::vector<uint64_t>& bitmap, size_t row) {
+    bitmap[row >> 6] |= uint64_t(1) << (row & 63);
+}
+
+void andInto(std::vector<uint64_t>& result, const std::vector<uint64_t>& other) {
+    uint64_t* out = result.data();
+    const uint64_t* in = other.data();
+    for (size_t i = 0, n = result.size(); i < n; ++i) {
+        out[i] &= in[i];
+    }
+}
+
+void andNotInto(std::vector<uint64_t>& result, const std::vector<uint64_t>& other) {
+    uint64_t* out = result.data();
+    const uint64_t* in = other.data();
+    for (size_t i = 0, n = result.size(); i < n; ++i) {
+        out[i] &= ~in[i];
+    }
+}
+}
+
+// Query
+
+MenuIndex::Query::Query()
+    : cuisine_(-1), course_(-1), vegetarian_(0), gluten_free_(0), contains_nuts_(0),
+      has_price_(false), has_prep_time_(false), has_spiciness_(false), has_sweetness_(false),
+      price_low_(0), price_high_(0), prep_low_(0), prep_high_(0),
+      spicy_low_(0), spicy_high_(0), sweet_low_(0), sweet_high_(0) {
+}
+
+MenuIndex::Query& MenuIndex::Query::cuisine(Dish::CuisineType cuisine_type) {
+    cuisine_ = cuisine_type;
+    return *this;
+}
+
+MenuIndex::Query& MenuIndex::Query::course(Course course) {
+    course_ = course;
+    return *this;
+}
+
+MenuIndex::Query& MenuIndex::Query::priceBetween(double low, double high) {
+    has_price_ = true;
+    price_low_ = Money::fromDollars(low).getCents();
+    price_high_ = Money::fromDollars(high).getCents();
+    return *this;
+}
+
+MenuIndex::Query& MenuIndex::Query::prepTimeBetween(int low, int high) {
+    has_prep_time_ = true;
+    prep_low_ = low;
+    prep_high_ = high;
+    return *this;
+}
+
+MenuIndex::Query& MenuIndex::Query::vegetarian(bool vegetarian) {
+    vegetarian_ = vegetarian ? 1 : 2;
+    return *this;
+}
+
+MenuIndex::Query& MenuIndex::Query::glutenFree(bool gluten_free) {
+    gluten_free_ = gluten_free ? 1 : 2;
+    return *this;
+}
+
+MenuIndex::Query& MenuIndex::Query::containsNuts(bool contains_nuts) {
+    contains_nuts_ = contains_nuts ? 1 : 2;
+    return *this;
+}
+
+MenuIndex::Query& MenuIndex::Query::spicinessBetween(int low, int high) {
+    has_spiciness_ = true;
+    spicy_low_ = low;
+    spicy_high_ = high;
+    return *this;
+}
+
+MenuIndex::Query& MenuIndex::Query::sweetnessBetween(int low, int high) {
+    has_sweetness_ = true;
+    sweet_low_ = low;
+    sweet_high_ = high;
+    return *this;
+}
+
+// MenuIndex
+
+MenuIndex::MenuIndex() : rows_(0), words_(0) {
+}
+
+MenuIndex::MenuIndex(const std::vector<Dish*>& dishes) : rows_(0), words_(0) {
+    build(dishes);
+}
+
+void MenuIndex::build(const std::vector<Dish*>& dishes) {
+    dishes_ = dishes;
+    rows_ = dishes.size();
+    words_ = (rows_ + 63) / 64;
+
+    Bitmap empty(words_, 0);
+    all_ = empty;
+    by_cuisine_.assign(CUISINE_COUNT, empty);
+    by_course_.assign(COURSE_COUNT, empty);
+    vegetarian_ = gluten_free_ = contains_nuts_ = empty;
+
+    std::vector<long> prices(rows_), prep_times(rows_), spiciness(rows_, 0), sweetness(rows_, 0);
+    for (size_t row = 0; row < rows_; ++row) {
+        const Dish* dish = dishes_[row];
+        setBit(all_, row);
+        setBit(by_cuisine_[cuisineOf(*dish)], row);
+        prices[row] = dish->getPriceMoney().getCents();
+        prep_times[row] = dish->getPrepTime();
+
+        if (const Appetizer* appetizer = dynamic_cast<const Appetizer*>(dish)) {
+            setBit(by_course_[APPETIZER], row);
+            if (appetizer->isVegetarian()) {
+                setBit(vegetarian_, row);
+            }
+            spiciness[row] = appetizer->getSpicinessLevel();
+        } else if (const MainCourse* main_course = dynamic_cast<const MainCourse*>(dish)) {
+            setBit(by_course_[MAIN_COURSE], row);
+            if (main_course->isGlutenFree()) {
+                setBit(gluten_free_, row);
+            }
+        } else if (const Dessert* dessert = dynamic_cast<const Dessert*>(dish)) {
+            setBit(by_course_[DESSERT], row);
+            if (dessert->containsNuts()) {
+                setBit(contains_nuts_, row);
+            }
+            sweetness[row] = dessert->getSweetnessLevel();
+        } else {
+            setBit(by_course_[OTHER_COURSE], row);
+        }
+    }
+
+    buildNumeric(price_, prices, all_);
+    buildNumeric(prep_time_, prep_times, all_);
+    buildNumeric(spiciness_, spiciness, by_course_[APPETIZER]);
+    buildNumeric(sweetness_, sweetness, by_course_[DESSERT]);
+}
+
+void MenuIndex::buildNumeric(NumericIndex& index, const std::vector<long>& values, const Bitmap& present) {
+    index.present = present;
+    index.sorted.clear();
+    for (size_t row = 0; row < rows_; ++row) {
+        if (present[row >> 6] & (uint64_t(1) << (row & 63))) {
+            index.sorted.push_back(std::make_pair(values[row], static_cast<uint32_t>(row)));
+        }
+    }
+    std::sort(index.sorted.begin(), index.sorted.end());
+
+    index.below.clear();
+    Bitmap running(words_, 0);
+    for (size_t rank = 0; rank <= index.sorted.size(); ++rank) {
+        if (rank % BUCKET == 0) {
+            index.below.push_back(running);
+        }
+        if (rank < index.sorted.size()) {
+            setBit(running, index.sorted[rank].second);
+        }
+    }
+}
+
+// Sets out to the rows whose value is less than `value`
+void MenuIndex::rowsBelow(const NumericIndex& index, long value, Bitmap& out) const {
+    size_t rank = std::lower_bound(index.sorted.begin(), index.sorted.end(), std::make_pair(value, uint32_t(0))) -
+                  index.sorted.begin();
+    size_t bucket = rank / BUCKET;
+    out = index.below[bucket];
+    for (size_t i = bucket * BUCKET; i < rank; ++i) {
+        setBit(out, index.sorted[i].second);
+    }
+}
+
+void MenuIndex::rangeFilter(const NumericIndex& index, long low, long high, Bitmap& result, Bitmap& scratch) const {
+    andInto(result, index.present);
+    if (high < LONG_MAX) {
+        rowsBelow(index, high + 1, scratch);
+        andInto(result, scratch);
+    }
+    rowsBelow(index, low, scratch);
+    andNotInto(result, scratch);
+}
+
+void MenuIndex::flagFilter(int wanted, const Bitmap& set, const Bitmap& applicable, Bitmap& result) const {
+    andInto(result, applicable);
+    if (wanted == 1) {
+        andInto(result, set);
+    } else {
+        andNotInto(result, set);
+    }
+}
+
+void MenuIndex::evaluate(const Query& query, Bitmap& result) const {
+    result = all_;
+    Bitmap scratch;
+    if (query.cuisine_ >= 0 && query.cuisine_ < CUISINE_COUNT) {
+        andInto(result, by_cuisine_[query.cuisine_]);
+    }
+    if (query.course_ >= 0 && query.course_ < COURSE_COUNT) {
+        andInto(result, by_course_[query.course_]);
+    }
+    if (query.vegetarian_ != 0) {
+        flagFilter(query.vegetarian_, vegetarian_, by_course_[APPETIZER], result);
+    }
+    if (query.gluten_free_ != 0) {
+        flagFilter(query.gluten_free_, gluten_free_, by_course_[MAIN_COURSE], result);
+    }
+    if (query.contains_nuts_ != 0) {
+        flagFilter(query.contains_nuts_, contains_nuts_, by_course_[DESSERT], result);
+    }
+    if (query.has_price_) {
+        rangeFilter(price_, query.price_low_, query.price_high_, result, scratch);
+    }
+    if (query.has_prep_time_) {
+        rangeFilter(prep_time_, query.prep_low_, query.prep_high_, result, scratch);
+    }
+    if (query.has_spiciness_) {
+        rangeFilter(spiciness_, query.spicy_low_, query.spicy_high_, result, scratch);
+    }
+    if (query.has_sweetness_) {
+        rangeFilter(sweetness_, query.sweet_low_, query.sweet_high_, result, scratch);
+    }
+}
+
+std::vector<Dish*> MenuIndex::select(const Query& query) const {
+    Bitmap result;
+    evaluate(query, result);
+    std::vector<Dish*> dishes;
+    for (size_t word = 0; word < words_; ++word) {
+        uint64_t bits = result[word];
+        while (bits != 0) {
+            dishes.push_back(dishes_[word * 64 + __builtin_ctzll(bits)]);
+            bits &= bits - 1;
+        }
+    }
+    return dishes;
+}
+
+size_t MenuIndex::count(const Query& query) const {
+    Bitmap result;
+    evaluate(query, result);
+    size_t total = 0;
+    for (uint64_t bits : result) {
+        total += __builtin_popcountll(bits);
+    }
+    return total;
+}
+
+size_t MenuIndex::size() const {
+    return rows_;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file MenuIndex.hpp
+ * @brief This file contains the declaration of the MenuIndex class, a column-oriented copy of a menu
+ * with bitmap and sorted indexes for filtering it.
+ *
+ * Each dish is a row. Building the index reads every attribute once (including the dynamic_cast to
+ * Appetizer, MainCourse or Dessert), so queries never call a virtual accessor. Categorical
+ * attributes (cuisine, course, flags) have one bitmap per value. Numeric attributes (price, prep time,
+ * spiciness, sweetness) have a sorted index plus cumulative bitmaps at fixed rank intervals, so a
+ * range costs two bitmap copies and at most two partial buckets of bit sets. A query is a
+ * conjunction of predicates evaluated 64 rows at a time with word-wide AND.
+ *
+ * A predicate on a course-specific attribute (vegetarian, gluten free, contains nuts, spiciness,
+ * sweetness) only matches dishes of that course.
+ */
+
+#ifndef MENUINDEX_HPP
+#define MENUINDEX_HPP
+
+#include "Dish.hpp"
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class MenuIndex {
+public:
+    /**
+     * @enum Course
+     * @brief The concrete kind of a dish.
+     */
+    enum Course { APPETIZER, MAIN_COURSE, DESSERT, OTHER_COURSE };
+
+    /**
+     * Class representing a conjunctive filter. Each setter adds one predicate and returns the query,
+     * so predicates can be chained: MenuIndex::Query().cuisine(Dish::ITALIAN).priceBetween(5, 15).
+     */
+    class Query {
+    public:
+        Query();
+        Query& cuisine(Dish::CuisineType cuisine_type);
+        Query& course(Course course);
+        Query& priceBetween(double low, double high);
+        Query& prepTimeBetween(int low, int high);
+        Query& vegetarian(bool vegetarian);
+        Query& glutenFree(bool gluten_free);
+        Query& containsNuts(bool contains_nuts);
+        Query& spicinessBetween(int low, int high);
+        Query& sweetnessBetween(int low, int high);
+
+    private:
+        friend class MenuIndex;
+        int cuisine_;         // -1 = unused
+        int course_;          // -1 = unused
+        // A flag predicate: 0 = unused, 1 = must be set, 2 = must be clear
+        int vegetarian_;
+        int gluten_free_;
+        int contains_nuts_;
+        bool has_price_, has_prep_time_, has_spiciness_, has_sweetness_;
+        long price_low_, price_high_;
+        long prep_low_, prep_high_;
+        long spicy_low_, spicy_high_;
+        long sweet_low_, sweet_high_;
+    };
+
+    /**
+     * Default constructor.
+     * Initializes an empty index.
+     */
+    MenuIndex();
+
+    /**
+     * Parameterized constructor.
+     * @param dishes The dishes to index. The index keeps the pointers; the dishes must outlive it.
+     */
+    explicit MenuIndex(const std::vector<Dish*>& dishes);
+
+    /**
+     * Rebuilds the index.
+     * @param dishes The dishes to index.
+     * @post: Attribute changes made to the dishes after this call are not seen until the next rebuild.
+     */
+    void build(const std::vector<Dish*>& dishes);
+
+    /**
+     * @param query The filter to apply.
+     * @return The matching dishes, in the order they were indexed.
+     */
+    std::vector<Dish*> select(const Query& query) const;
+
+    /**
+     * @param query The filter to apply.
+     * @return The number of matching dishes.
+     */
+    size_t count(const Query& query) const;
+
+    /**
+     * @return The number of indexed dishes.
+     */
+    size_t size() const;
+
+private:
+    typedef std::vector<uint64_t> Bitmap;
+
+    // A sorted index over one numeric column with cumulative bitmaps every BUCKET ranks
+    struct NumericIndex {
+        std::vector<std::pair<long, uint32_t>> sorted;   // (value, row), ascending
+        std::vector<Bitmap> below;                       // below[b]: rows with rank < b * BUCKET
+        Bitmap present;                                  // rows that have this attribute
+    };
+
+    void evaluate(const Query& query, Bitmap& result) const;
+    void buildNumeric(NumericIndex& index, const std::vector<long>& values, const Bitmap& present);
+    void rowsBelow(const NumericIndex& index, long value, Bitmap& out) const;
+    void rangeFilter(const NumericIndex& index, long low, long high, Bitmap& result, Bitmap& scratch) const;
+    void flagFilter(int wanted, const Bitmap& set, const Bitmap& applicable, Bitmap& result) const;
+
+    size_t rows_;
+    size_t words_;
+    std::vector<Dish*> dishes_;
+    Bitmap all_;
+    std::vector<Bitmap> by_cuisine_;
+    std::vector<Bitmap> by_course_;
+    Bitmap vegetarian_;
+    Bitmap gluten_free_;
+    Bitmap contains_nuts_;
+    NumericIndex price_;
+    NumericIndex prep_time_;
+    NumericIndex spiciness_;
+    NumericIndex sweetness_;
+};
+
+#endif // MENUINDEX_HPP
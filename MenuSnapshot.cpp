@@ -0,0 +1,145 @@
+/**
+ * @file MenuSnapshot.cpp
+ * @brief This file contains the implementation of the MenuSnapshot class.
+ */
+
+#include "MenuSnapshot.hpp"
+#include "StationManager.hpp"
+
+namespace {
+std::vector<RecipeLine> toRecipeLines(const std::vector<Ingredient>& recipe) {
+    std::vector<RecipeLine> lines;
+    lines.reserve(recipe.size());
+    for (const Ingredient& ingredient : recipe) {
+        lines.push_back(toRecipeLine(ingredient));
+    }
+    return lines;
+}
+
+bool sameLines(const std::vector<RecipeLine>& a, const std::vector<RecipeLine>& b) {
+    if (a.size() != b.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].id != b[i].id || a[i].required != b[i].required) {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+MenuSnapshot::MenuSnapshot() : version_(0) {
+}
+
+std::shared_ptr<MenuSnapshot> MenuSnapshot::capture(const StationManager& manager) {
+    std::shared_ptr<MenuSnapshot> snapshot = std::make_shared<MenuSnapshot>();
+    snapshot->version_ = 1;
+    Node<KitchenStation*>* station_node = manager.getHeadNode();
+    while (station_node != nullptr) {
+        KitchenStation* station = station_node->getItem();
+        StationRecipes& recipes = snapshot->stations_[station];
+        for (Dish* dish : station->getDishes()) {
+            if (recipes.emplace(dish->getName(), dish->getIngredients()).second) {
+                snapshot->addDistinct(dish->getName(), dish->getRecipeLines());
+            }
+        }
+        station_node = station_node->getNext();
+    }
+    return snapshot;
+}
+
+std::shared_ptr<MenuSnapshot> MenuSnapshot::nextVersion() const {
+    std::shared_ptr<MenuSnapshot> next = std::make_shared<MenuSnapshot>(*this);
+    next->version_ = version_ + 1;
+    return next;
+}
+
+void MenuSnapshot::assign(const KitchenStation* station, const std::string& dish_name, const std::vector<Ingredient>& recipe) {
+    StationRecipes& recipes = stations_[station];
+    auto found = recipes.find(dish_name);
+    if (found != recipes.end()) {
+        removeDistinct(dish_name, toRecipeLines(found->second));
+    }
+    recipes[dish_name] = recipe;
+    addDistinct(dish_name, toRecipeLines(recipe));
+}
+
+bool MenuSnapshot::unassign(const KitchenStation* station, const std::string& dish_name) {
+    auto found = stations_.find(station);
+    if (found == stations_.end()) {
+        return false;
+    }
+    auto recipe = found->second.find(dish_name);
+    if (recipe == found->second.end()) {
+        return false;
+    }
+    removeDistinct(dish_name, toRecipeLines(recipe->second));
+    found->second.erase(recipe);
+    return true;
+}
+
+const std::vector<Ingredient>* MenuSnapshot::findRecipe(const KitchenStation* station, const std::string& dish_name) const {
+    auto found_station = stations_.find(station);
+    if (found_station == stations_.end()) {
+        return nullptr;
+    }
+    auto found_dish = found_station->second.find(dish_name);
+    if (found_dish == found_station->second.end()) {
+        return nullptr;
+    }
+    return &found_dish->second;
+}
+
+bool MenuSnapshot::servesDish(const std::string& dish_name) const {
+    return distinct_.find(dish_name) != distinct_.end();
+}
+
+const std::vector<MenuSnapshot::DistinctRecipe>* MenuSnapshot::findDistinctRecipes(const std::string& dish_name) const {
+    auto found = distinct_.find(dish_name);
+    return found == distinct_.end() ? nullptr : &found->second;
+}
+
+// Counts one more station using a recipe for the dish
+void MenuSnapshot::addDistinct(const std::string& dish_name, const std::vector<RecipeLine>& lines) {
+    std::vector<DistinctRecipe>& recipes = distinct_[dish_name];
+    for (DistinctRecipe& recipe : recipes) {
+        if (sameLines(recipe.lines, lines)) {
+            ++recipe.stations;
+            return;
+        }
+    }
+    recipes.push_back(DistinctRecipe{lines, 1});
+}
+
+// Counts one station fewer using a recipe for the dish; the dish is dropped with its last station
+void MenuSnapshot::removeDistinct(const std::string& dish_name, const std::vector<RecipeLine>& lines) {
+    auto found = distinct_.find(dish_name);
+    if (found == distinct_.end()) {
+        return;
+    }
+    std::vector<DistinctRecipe>& recipes = found->second;
+    for (size_t i = 0; i < recipes.size(); ++i) {
+        if (sameLines(recipes[i].lines, lines)) {
+            if (--recipes[i].stations == 0) {
+                recipes.erase(recipes.begin() + i);
+            }
+            break;
+        }
+    }
+    if (recipes.empty()) {
+        distinct_.erase(found);
+    }
+}
+
+unsigned long MenuSnapshot::getVersion() const {
+    return version_;
+}
+
+size_t MenuSnapshot::getAssignmentCount() const {
+    size_t count = 0;
+    for (const auto& entry : stations_) {
+        count += entry.second.size();
+    }
+    return count;
+}
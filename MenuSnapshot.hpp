@@ -0,0 +1,118 @@
+/**
+ * @file MenuSnapshot.hpp
+ * @brief This file contains the declaration of the MenuSnapshot class, an immutable version of the
+ * menu: which station serves which dish, and with which recipe.
+ *
+ * A StationManager with a published snapshot dispatches against the snapshot instead of the
+ * stations' live dish lists. A reload copies the current version, edits the copy and publishes it
+ * with one atomic pointer swap, so dispatch never waits for a reload. Each dish in
+ * processAllDishes() holds the version it started with until it is done, and a version is freed
+ * when the last dish using it finishes (read-copy-update with shared_ptr reference counts).
+ *
+ * Each version also keeps, per dish, the distinct recipes of the stations serving it with their
+ * ingredients interned, so admission checks stock with one lookup instead of walking the stations.
+ * They are updated by assign() and unassign() on the unpublished copy, so a published version is
+ * never written to.
+ */
+
+#ifndef MENUSNAPSHOT_HPP
+#define MENUSNAPSHOT_HPP
+
+#include "Dish.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class KitchenStation;
+class StationManager;
+
+class MenuSnapshot {
+public:
+    /**
+     * @struct DistinctRecipe
+     * @brief A recipe one or more stations use for a dish.
+     */
+    struct DistinctRecipe {
+        std::vector<RecipeLine> lines;
+        int stations;   // stations that use this recipe
+    };
+
+    /**
+     * Default constructor.
+     * Initializes an empty menu with version 0.
+     */
+    MenuSnapshot();
+
+    /**
+     * Captures the dishes currently assigned to the manager's stations.
+     * @param manager The station manager to read. Its stations must not change during the call.
+     * @return A new snapshot whose version is 1.
+     */
+    static std::shared_ptr<MenuSnapshot> capture(const StationManager& manager);
+
+    /**
+     * Copies this snapshot for editing.
+     * @return A mutable copy whose version is one greater than this one.
+     */
+    std::shared_ptr<MenuSnapshot> nextVersion() const;
+
+    /**
+     * Assigns a dish to a station, or replaces the recipe if the station already serves it.
+     * @param station The station that serves the dish.
+     * @param dish_name The name of the dish.
+     * @param recipe The ingredients (with required quantities) the station uses for the dish.
+     */
+    void assign(const KitchenStation* station, const std::string& dish_name, const std::vector<Ingredient>& recipe);
+
+    /**
+     * Removes a dish from a station.
+     * @param station The station.
+     * @param dish_name The name of the dish.
+     * @return True if the station served the dish; false otherwise.
+     */
+    bool unassign(const KitchenStation* station, const std::string& dish_name);
+
+    /**
+     * Looks up the recipe a station uses for a dish.
+     * @param station The station.
+     * @param dish_name The name of the dish.
+     * @return The recipe, or nullptr if the station does not serve the dish in this version.
+     */
+    const std::vector<Ingredient>* findRecipe(const KitchenStation* station, const std::string& dish_name) const;
+
+    /**
+     * @param dish_name The name of a dish.
+     * @return True if at least one station serves the dish in this version.
+     */
+    bool servesDish(const std::string& dish_name) const;
+
+    /**
+     * Looks up the recipes of a dish across the stations serving it, each listed once.
+     * @param dish_name The name of the dish.
+     * @return The distinct recipes, or nullptr if no station serves the dish in this version.
+     */
+    const std::vector<DistinctRecipe>* findDistinctRecipes(const std::string& dish_name) const;
+
+    /**
+     * @return The version number of this snapshot.
+     */
+    unsigned long getVersion() const;
+
+    /**
+     * @return The number of (station, dish) assignments in this snapshot.
+     */
+    size_t getAssignmentCount() const;
+
+private:
+    typedef std::unordered_map<std::string, std::vector<Ingredient>> StationRecipes;
+
+    void addDistinct(const std::string& dish_name, const std::vector<RecipeLine>& lines);
+    void removeDistinct(const std::string& dish_name, const std::vector<RecipeLine>& lines);
+
+    unsigned long version_;
+    std::unordered_map<const KitchenStation*, StationRecipes> stations_;
+    std::unordered_map<std::string, std::vector<DistinctRecipe>> distinct_;   // dish name -> recipes of the stations serving it
+};
+
+#endif // MENUSNAPSHOT_HPP
@@ -0,0 +1,54 @@
+/**
+ * @file Money.cpp
+ * @brief This file contains the implementation of the Money class.
+ */
+
+#include "Money.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <thread>
+
+Money Money::fromDollars(double dollars) {
+    return Money(std::llround(dollars * 100.0));
+}
+
+Money Money::sum(const Money* amounts, size_t count) {
+    int64_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += amounts[i].cents_;
+    }
+    return Money(total);
+}
+
+Money Money::parallelSum(const std::vector<Money>& amounts, unsigned thread_count) {
+    if (thread_count <= 1 || amounts.size() < thread_count) {
+        return sum(amounts.data(), amounts.size());
+    }
+    std::vector<Money> partials(thread_count);
+    std::vector<std::thread> threads;
+    size_t chunk = (amounts.size() + thread_count - 1) / thread_count;
+    for (unsigned t = 0; t < thread_count; ++t) {
+        size_t begin = std::min(amounts.size(), t * chunk);
+        size_t end = std::min(amounts.size(), begin + chunk);
+        threads.emplace_back([&amounts, &partials, t, begin, end]() {
+            partials[t] = sum(amounts.data() + begin, end - begin);
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    return sum(partials.data(), partials.size());
+}
+
+std::ostream& operator<<(std::ostream& out, Money amount) {
+    int64_t cents = amount.getCents();
+    if (cents < 0) {
+        out << '-';
+        cents = -cents;
+    }
+    char fill = out.fill('0');
+    out << cents / 100 << '.' << std::setw(2) << cents % 100;
+    out.fill(fill);
+    return out;
+}
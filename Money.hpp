@@ -0,0 +1,90 @@
+/**
+ * @file Money.hpp
+ * @brief This file contains the declaration of the Money class, an amount of money in whole cents.
+ *
+ * Amounts are 64-bit integers, so adding any number of them is exact and gives the same result in
+ * any order. A total split across threads or vector lanes therefore matches the serial total
+ * bit for bit, which a sum of doubles does not. Conversions from double round to the nearest cent
+ * once, at the edge.
+ */
+
+#ifndef MONEY_HPP
+#define MONEY_HPP
+
+#include <cstdint>
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+class Money {
+public:
+    /**
+     * Default constructor.
+     * Initializes a zero amount.
+     */
+    Money() : cents_(0) {}
+
+    /**
+     * @param cents An amount in cents.
+     * @return The amount.
+     */
+    static Money fromCents(int64_t cents) { return Money(cents); }
+
+    /**
+     * @param dollars An amount in dollars.
+     * @return The amount, rounded to the nearest cent.
+     */
+    static Money fromDollars(double dollars);
+
+    /**
+     * @return The amount in cents.
+     */
+    int64_t getCents() const { return cents_; }
+
+    /**
+     * @return The amount in dollars.
+     */
+    double toDollars() const { return cents_ / 100.0; }
+
+    Money operator+(Money rhs) const { return Money(cents_ + rhs.cents_); }
+    Money operator-(Money rhs) const { return Money(cents_ - rhs.cents_); }
+    Money operator-() const { return Money(-cents_); }
+    Money operator*(int64_t quantity) const { return Money(cents_ * quantity); }
+    Money operator/(int64_t divisor) const { return Money(cents_ / divisor); }   // truncates toward zero
+    Money& operator+=(Money rhs) { cents_ += rhs.cents_; return *this; }
+    Money& operator-=(Money rhs) { cents_ -= rhs.cents_; return *this; }
+    bool operator==(Money rhs) const { return cents_ == rhs.cents_; }
+    bool operator!=(Money rhs) const { return cents_ != rhs.cents_; }
+    bool operator<(Money rhs) const { return cents_ < rhs.cents_; }
+    bool operator<=(Money rhs) const { return cents_ <= rhs.cents_; }
+    bool operator>(Money rhs) const { return cents_ > rhs.cents_; }
+    bool operator>=(Money rhs) const { return cents_ >= rhs.cents_; }
+
+    /**
+     * Adds up amounts in one pass the compiler can vectorize.
+     * @param amounts The first amount.
+     * @param count The number of amounts.
+     * @return The exact total.
+     */
+    static Money sum(const Money* amounts, size_t count);
+
+    /**
+     * Adds up amounts on several threads.
+     * @param amounts The amounts.
+     * @param thread_count The number of threads to split the work over (at least 1).
+     * @return The exact total; the same as sum() for any thread count.
+     */
+    static Money parallelSum(const std::vector<Money>& amounts, unsigned thread_count);
+
+private:
+    explicit Money(int64_t cents) : cents_(cents) {}
+
+    int64_t cents_;
+};
+
+/**
+ * Writes an amount as dollars with two decimals, e.g. "12.50" or "-0.05".
+ */
+std::ostream& operator<<(std::ostream& out, Money amount);
+
+#endif // MONEY_HPP
@@ -0,0 +1,166 @@
+/**
+ * @file OrderRing.cpp
+ * @brief This file contains the implementation of the OrderRing class.
+ */
+
+#include "OrderRing.hpp"
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace {
+const uint32_t RING_MAGIC = 0x4f524452; // "ORDR"
+const uint32_t MAX_CAPACITY = 1u << 31;  // Largest power of two in a uint32_t
+}
+
+OrderRing* OrderRing::create(const std::string& name, uint32_t capacity) {
+    if (capacity > MAX_CAPACITY) {
+        return nullptr; // Rounding up would overflow
+    }
+    uint32_t rounded = 1;
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+
+    shm_unlink(name.c_str()); // Replace a ring left behind by a previous run
+    int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0) {
+        return nullptr;
+    }
+    size_t bytes = mappedBytes(rounded);
+    if (ftruncate(fd, bytes) != 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    Header* header = static_cast<Header*>(memory);
+    new (&header->magic) std::atomic<uint32_t>(0);
+    header->capacity = rounded;
+    new (&header->head) std::atomic<uint64_t>(0);
+    new (&header->tail) std::atomic<uint64_t>(0);
+    header->magic.store(RING_MAGIC, std::memory_order_release); // Written last: attach() only accepts a fully initialized ring
+    return new OrderRing(name, header, bytes, true);
+}
+
+OrderRing* OrderRing::attach(const std::string& name) {
+    int fd = shm_open(name.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(Header))) {
+        close(fd);
+        return nullptr;
+    }
+    size_t bytes = info.st_size;
+    void* memory = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+
+    Header* header = static_cast<Header*>(memory);
+    uint32_t magic = header->magic.load(std::memory_order_acquire); // Pairs with the release in create()
+    uint32_t capacity = header->capacity;
+    if (magic != RING_MAGIC || capacity == 0 || (capacity & (capacity - 1)) != 0 || // push() and pop() mask with capacity - 1
+        bytes < mappedBytes(capacity)) {
+        munmap(memory, bytes);
+        return nullptr;
+    }
+    return new OrderRing(name, header, bytes, false);
+}
+
+OrderRing::OrderRing(const std::string& name, Header* header, size_t mapped_bytes, bool owner)
+    : name_(name), header_(header),
+      slots_(reinterpret_cast<OrderRecord*>(reinterpret_cast<char*>(header) + sizeof(Header))),
+      mapped_bytes_(mapped_bytes), owner_(owner),
+      cached_head_(header->head.load(std::memory_order_acquire)),
+      cached_tail_(header->tail.load(std::memory_order_acquire)) {
+}
+
+OrderRing::~OrderRing() {
+    munmap(header_, mapped_bytes_);
+    if (owner_) {
+        shm_unlink(name_.c_str());
+    }
+}
+
+bool OrderRing::push(const OrderRecord& record) {
+    uint64_t head = header_->head.load(std::memory_order_relaxed);
+    if (head - cached_tail_ >= header_->capacity) {
+        // Looks full; refresh the consumer's position before giving up
+        cached_tail_ = header_->tail.load(std::memory_order_acquire);
+        if (head - cached_tail_ >= header_->capacity) {
+            return false;
+        }
+    }
+    slots_[head & (header_->capacity - 1)] = record;
+    header_->head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+size_t OrderRing::pop(OrderRecord* records, size_t max) {
+    uint64_t tail = header_->tail.load(std::memory_order_relaxed);
+    if (cached_head_ == tail) {
+        cached_head_ = header_->head.load(std::memory_order_acquire);
+    }
+    size_t count = cached_head_ - tail;
+    if (count > max) {
+        count = max;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        records[i] = slots_[(tail + i) & (header_->capacity - 1)];
+    }
+    if (count > 0) {
+        header_->tail.store(tail + count, std::memory_order_release);
+    }
+    return count;
+}
+
+size_t OrderRing::size() const {
+    return header_->head.load(std::memory_order_acquire) - header_->tail.load(std::memory_order_acquire);
+}
+
+uint32_t OrderRing::getCapacity() const {
+    return header_->capacity;
+}
+
+std::string OrderRing::getName() const {
+    return name_;
+}
+
+size_t OrderRing::mappedBytes(uint32_t capacity) {
+    return sizeof(Header) + static_cast<size_t>(capacity) * sizeof(OrderRecord);
+}
+
+uint32_t toDietaryMask(const Dish::DietaryRequest& request) {
+    return (request.vegetarian ? 1u : 0u) | (request.vegan ? 2u : 0u) | (request.gluten_free ? 4u : 0u) |
+           (request.nut_free ? 8u : 0u) | (request.low_sodium ? 16u : 0u) | (request.low_sugar ? 32u : 0u);
+}
+
+Dish::DietaryRequest fromDietaryMask(uint32_t mask) {
+    Dish::DietaryRequest request;
+    request.vegetarian = mask & 1u;
+    request.vegan = mask & 2u;
+    request.gluten_free = mask & 4u;
+    request.nut_free = mask & 8u;
+    request.low_sodium = mask & 16u;
+    request.low_sugar = mask & 32u;
+    return request;
+}
+
+uint64_t monotonicNanos() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<uint64_t>(now.tv_sec) * 1000000000ull + now.tv_nsec;
+}
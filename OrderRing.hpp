@@ -0,0 +1,128 @@
+/**
+ * @file OrderRing.hpp
+ * @brief This file contains the declaration of the OrderRing class, a single-producer single-consumer
+ * ring of fixed-size order records in POSIX shared memory.
+ *
+ * The kitchen process creates one ring per client with OrderRing::create(); each POS process
+ * attaches to its own ring with OrderRing::attach() and pushes orders without making a system call.
+ * Only the producer writes the head index and only the consumer writes the tail index, so the two
+ * sides synchronize with a single acquire/release pair per operation.
+ */
+
+#ifndef ORDERRING_HPP
+#define ORDERRING_HPP
+
+#include "Dish.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * Struct representing one order in transit.
+ */
+struct OrderRecord {
+    uint32_t catalog_id;     // Index into StationManager::getMenu()
+    uint32_t dietary_mask;   // DietaryRequest flags, see toDietaryMask()
+    uint64_t timestamp_ns;   // CLOCK_MONOTONIC time at which the client placed the order
+};
+
+class OrderRing {
+public:
+    /**
+     * Creates a new shared-memory ring, replacing any existing ring with the same name.
+     * @param name The shared-memory object name (e.g. "/bistro-pos-1").
+     * @param capacity The number of records the ring holds; rounded up to a power of two, at most 2^31.
+     * @return A ring that unlinks its shared-memory object on destruction, or nullptr on failure or
+     * if the capacity is too large.
+     */
+    static OrderRing* create(const std::string& name, uint32_t capacity);
+
+    /**
+     * Attaches to a ring created by another process.
+     * @param name The shared-memory object name passed to create().
+     * @return The attached ring, or nullptr if it does not exist, is not an order ring or has a
+     * capacity that is not a power of two.
+     */
+    static OrderRing* attach(const std::string& name);
+
+    /**
+     * Destructor.
+     * @post: Unmaps the ring, and unlinks its name if this process created it.
+     */
+    ~OrderRing();
+
+    OrderRing(const OrderRing&) = delete;
+    OrderRing& operator=(const OrderRing&) = delete;
+
+    /**
+     * Appends an order. Must only be called by the ring's single producer.
+     * @param record The order to append.
+     * @return True if the order was appended; false if the ring is full.
+     */
+    bool push(const OrderRecord& record);
+
+    /**
+     * Removes up to max orders. Must only be called by the ring's single consumer.
+     * @param records The array that receives the orders, oldest first.
+     * @param max The capacity of records.
+     * @return The number of orders removed.
+     */
+    size_t pop(OrderRecord* records, size_t max);
+
+    /**
+     * @return The number of orders waiting in the ring.
+     */
+    size_t size() const;
+
+    /**
+     * @return The number of records the ring holds.
+     */
+    uint32_t getCapacity() const;
+
+    /**
+     * @return The shared-memory object name.
+     */
+    std::string getName() const;
+
+private:
+    // Shared-memory layout; the indices live on their own cache lines and the slots follow the header
+    struct Header {
+        std::atomic<uint32_t> magic;   // stored last with release, loaded first with acquire
+        uint32_t capacity;
+        alignas(64) std::atomic<uint64_t> head;   // next slot the producer writes
+        alignas(64) std::atomic<uint64_t> tail;   // next slot the consumer reads
+    };
+
+    OrderRing(const std::string& name, Header* header, size_t mapped_bytes, bool owner);
+    static size_t mappedBytes(uint32_t capacity);
+
+    std::string name_;
+    Header* header_;
+    OrderRecord* slots_;
+    size_t mapped_bytes_;
+    bool owner_;
+    uint64_t cached_head_;   // consumer's last view of head
+    uint64_t cached_tail_;   // producer's last view of tail
+};
+
+/**
+ * Packs a dietary request into the bit mask carried by an OrderRecord.
+ * @param request The dietary request to pack.
+ * @return The mask (bit 0 vegetarian, 1 vegan, 2 gluten_free, 3 nut_free, 4 low_sodium, 5 low_sugar).
+ */
+uint32_t toDietaryMask(const Dish::DietaryRequest& request);
+
+/**
+ * Unpacks the bit mask produced by toDietaryMask().
+ * @param mask The packed mask.
+ * @return The dietary request.
+ */
+Dish::DietaryRequest fromDietaryMask(uint32_t mask);
+
+/**
+ * @return The CLOCK_MONOTONIC time in nanoseconds, comparable across processes.
+ */
+uint64_t monotonicNanos();
+
+#endif // ORDERRING_HPP
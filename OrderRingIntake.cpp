@@ -0,0 +1,116 @@
+/**
+ * @file OrderRingIntake.cpp
+ * @brief This file contains the implementation of the OrderRingIntake class.
+ */
+
+#include "OrderRingIntake.hpp"
+
+OrderRingIntake::OrderRingIntake(StationManager& manager, size_t batch_size)
+    : manager_(manager), records_(batch_size > 0 ? batch_size : 1), unknown_orders_(0),
+      rejected_orders_(0) {
+    reloadMenu();
+}
+
+OrderRingIntake::~OrderRingIntake() {
+    deleteSpares();
+}
+
+bool OrderRingIntake::addRing(OrderRing* ring) {
+    if (ring == nullptr) {
+        return false;
+    }
+    rings_.push_back(ring);
+    return true;
+}
+
+void OrderRingIntake::reloadMenu() {
+    deleteSpares();
+    for (QueuedOrder& order : queued_) {
+        order.reusable = false; // Its catalog ID may now name another dish
+    }
+    menu_ = manager_.getMenu();
+    spares_.resize(menu_.size());
+}
+
+size_t OrderRingIntake::drain(std::vector<uint64_t>* timestamps) {
+    size_t queued = 0;
+    for (OrderRing* ring : rings_) {
+        size_t count = ring->pop(records_.data(), records_.size());
+        for (size_t i = 0; i < count; ++i) {
+            const OrderRecord& record = records_[i];
+            if (record.catalog_id >= menu_.size()) {
+                ++unknown_orders_;
+                continue;
+            }
+            Dish* dish = copyOf(record.catalog_id); // The menu dish stays as the stations serve it
+            if (dish == nullptr) {
+                ++rejected_orders_;
+                continue;
+            }
+            bool adjusted = record.dietary_mask != 0;
+            if (adjusted) {
+                dish->dietaryAccommodations(fromDietaryMask(record.dietary_mask));
+            }
+            if (manager_.tryAddDishToQueue(dish) != StationManager::ADMITTED) {
+                recycle(dish, record.catalog_id, !adjusted);
+                ++rejected_orders_;
+                continue;
+            }
+            queued_.push_back(QueuedOrder{dish, record.catalog_id, !adjusted});
+            if (timestamps != nullptr) {
+                timestamps->push_back(record.timestamp_ns);
+            }
+            ++queued;
+        }
+    }
+    return queued;
+}
+
+size_t OrderRingIntake::retire(const std::vector<bool>& results) {
+    size_t retired = 0;
+    for (size_t i = 0; i < queued_.size() && i < results.size(); ++i) {
+        if (results[i]) { // Prepared, so no longer in the queue
+            recycle(queued_[i].dish, queued_[i].catalog_id, queued_[i].reusable);
+            ++retired;
+        }
+    }
+    queued_.clear();
+    return retired;
+}
+
+unsigned long OrderRingIntake::getUnknownOrders() const {
+    return unknown_orders_;
+}
+
+unsigned long OrderRingIntake::getRejectedOrders() const {
+    return rejected_orders_;
+}
+
+// Returns a kept copy of the menu dish, or a new one (nullptr if the dish cannot be copied)
+Dish* OrderRingIntake::copyOf(size_t catalog_id) {
+    std::vector<Dish*>& spares = spares_[catalog_id];
+    if (spares.empty()) {
+        return menu_[catalog_id]->clone();
+    }
+    Dish* dish = spares.back();
+    spares.pop_back();
+    return dish;
+}
+
+// Keeps an unadjusted copy for the next order of the same dish; deletes any other
+void OrderRingIntake::recycle(Dish* dish, size_t catalog_id, bool reusable) {
+    if (reusable) {
+        spares_[catalog_id].push_back(dish);
+    } else {
+        delete dish;
+    }
+}
+
+void OrderRingIntake::deleteSpares() {
+    for (std::vector<Dish*>& spares : spares_) {
+        for (Dish* dish : spares) {
+            delete dish;
+        }
+        spares.clear();
+    }
+}
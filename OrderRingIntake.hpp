@@ -0,0 +1,105 @@
+/**
+ * @file OrderRingIntake.hpp
+ * @brief This file contains the declaration of the OrderRingIntake class, which drains the per-client
+ * shared-memory order rings into a StationManager's dish queue.
+ *
+ * A dispatch loop alternates drain(), processAllDishes() and retire(). Catalog IDs index the manager's
+ * menu as returned by getMenu() when the intake was created or last reloaded.
+ *
+ * Every order is queued as its own copy of the menu dish, so dietary accommodations never change the
+ * dish the stations serve and the queue owns what it holds (clearDishQueue() may delete it). Copies
+ * of prepared orders without accommodations are kept and reused for later orders of the same dish,
+ * so steady-state intake does not allocate.
+ */
+
+#ifndef ORDERRINGINTAKE_HPP
+#define ORDERRINGINTAKE_HPP
+
+#include "OrderRing.hpp"
+#include "StationManager.hpp"
+#include <vector>
+
+class OrderRingIntake {
+public:
+    /**
+     * Parameterized constructor.
+     * @param manager The station manager whose queue receives the orders. It must outlive the intake.
+     * @param batch_size The most orders taken from one ring per drain() call.
+     */
+    OrderRingIntake(StationManager& manager, size_t batch_size = 256);
+
+    /**
+     * Destructor. Deletes the kept copies; orders still queued belong to the queue.
+     */
+    ~OrderRingIntake();
+
+    /**
+     * Adds a client ring. The intake becomes the ring's single consumer.
+     * @param ring A ring created with OrderRing::create(). The caller keeps ownership.
+     * @return True if the ring was added; false if it is null.
+     */
+    bool addRing(OrderRing* ring);
+
+    /**
+     * Reloads the catalog from the manager's menu.
+     * @post: Kept copies of the old menu's dishes are deleted.
+     */
+    void reloadMenu();
+
+    /**
+     * Moves waiting orders from every ring into the dish queue, visiting the rings round robin.
+     * Each order is a copy of the menu dish, adjusted for the dietary request when the mask is set,
+     * and goes through tryAddDishToQueue().
+     * @param timestamps If not null, receives the client timestamp of every queued order, in queue order.
+     * @post: Orders whose catalog ID is not on the menu, or that the manager does not admit, are
+     * counted and discarded.
+     * @return The number of orders queued.
+     */
+    size_t drain(std::vector<uint64_t>* timestamps = nullptr);
+
+    /**
+     * Takes back the orders of the last drain() that processAllDishes() prepared, which it removed
+     * from the queue. Orders it did not prepare stay in the queue, which owns them.
+     * @param results The results processAllDishes() reported, in queue order.
+     * @pre: The queue held only the orders of the last drain() when processAllDishes() ran.
+     * @return The number of orders taken back.
+     */
+    size_t retire(const std::vector<bool>& results);
+
+    /**
+     * @return The number of orders discarded because their catalog ID was not on the menu.
+     */
+    unsigned long getUnknownOrders() const;
+
+    /**
+     * @return The number of orders discarded because the manager did not admit them, or because
+     * their menu dish cannot be copied.
+     */
+    unsigned long getRejectedOrders() const;
+
+private:
+    // An order queued by the last drain()
+    struct QueuedOrder {
+        Dish* dish;
+        size_t catalog_id;
+        bool reusable;   // Not adjusted, and of the current menu
+    };
+
+    StationManager& manager_;
+    std::vector<OrderRing*> rings_;
+    std::vector<Dish*> menu_;
+    std::vector<std::vector<Dish*>> spares_;   // Unadjusted copies of each menu dish, ready for reuse
+    std::vector<QueuedOrder> queued_;
+    std::vector<OrderRecord> records_;
+    unsigned long unknown_orders_;
+    unsigned long rejected_orders_;
+
+    OrderRingIntake(const OrderRingIntake&) = delete;
+    OrderRingIntake& operator=(const OrderRingIntake&) = delete;
+
+    Dish* copyOf(size_t catalog_id);
+    void recycle(Dish* dish, size_t catalog_id, bool reusable);
+    void deleteSpares();
+};
+
+#endif // ORDERRINGINTAKE_HPP
@@ -0,0 +1,326 @@
+/**
+ * @file OrderServer.cpp
+ * @brief This file contains the implementation of the OrderServer class, an epoll based order intake
+ * server for a StationManager.
+ */
+
+#include "OrderServer.hpp"
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+const int MAX_EVENTS = 64;
+const size_t READ_CHUNK = 16384;
+const size_t MAX_LINE = 4096;
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+}
+
+OrderServer::OrderServer(StationManager& manager, const std::string& socket_path)
+    : manager_(manager), socket_path_(socket_path), listen_fd_(-1), epoll_fd_(-1), wake_fd_(-1),
+      running_(false), orders_served_(0) {
+}
+
+OrderServer::~OrderServer() {
+    for (auto& entry : connections_) {
+        close(entry.first);
+        delete entry.second;
+    }
+    connections_.clear();
+    if (listen_fd_ >= 0) {
+        close(listen_fd_);
+        unlink(socket_path_.c_str());
+    }
+    if (wake_fd_ >= 0) {
+        close(wake_fd_);
+    }
+    if (epoll_fd_ >= 0) {
+        close(epoll_fd_);
+    }
+}
+
+bool OrderServer::start() {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path_.size() >= sizeof(address.sun_path)) {
+        errno = ENAMETOOLONG;
+        return false;
+    }
+    std::strncpy(address.sun_path, socket_path_.c_str(), sizeof(address.sun_path) - 1);
+
+    listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd_ < 0) {
+        return false;
+    }
+    unlink(socket_path_.c_str()); // Remove a stale socket left by a previous run
+    if (bind(listen_fd_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listen_fd_, SOMAXCONN) != 0 || !setNonBlocking(listen_fd_)) {
+        return false;
+    }
+
+    epoll_fd_ = epoll_create1(0);
+    wake_fd_ = eventfd(0, EFD_NONBLOCK);
+    if (epoll_fd_ < 0 || wake_fd_ < 0) {
+        return false;
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = listen_fd_;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, listen_fd_, &event) != 0) {
+        return false;
+    }
+    event.data.fd = wake_fd_;
+    if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, wake_fd_, &event) != 0) {
+        return false;
+    }
+
+    reloadMenu();
+    running_ = true;
+    return true;
+}
+
+void OrderServer::run() {
+    epoll_event events[MAX_EVENTS];
+    while (running_) {
+        int ready = epoll_wait(epoll_fd_, events, MAX_EVENTS, -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        // Gather every request that is ready, then prepare them as one batch
+        for (int i = 0; i < ready; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == listen_fd_) {
+                acceptConnections();
+                continue;
+            }
+            if (fd == wake_fd_) {
+                continue;
+            }
+            auto found = connections_.find(fd);
+            if (found == connections_.end()) {
+                continue;
+            }
+            Connection* connection = found->second;
+            if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                if (!readConnection(connection)) {
+                    connection->closing = true;
+                }
+                parseRequests(connection);
+            }
+            if ((events[i].events & EPOLLOUT) && !flushConnection(connection)) {
+                connection->closing = true;
+            }
+        }
+
+        processBatch();
+
+        // Send the answers and retire connections whose peer went away
+        std::vector<Connection*> finished;
+        for (auto& entry : connections_) {
+            Connection* connection = entry.second;
+            if (!connection->out.empty() && !flushConnection(connection)) {
+                connection->closing = true;
+            }
+            if (connection->closing) {
+                finished.push_back(connection);
+            }
+        }
+        for (Connection* connection : finished) {
+            closeConnection(connection);
+        }
+    }
+}
+
+void OrderServer::stop() {
+    running_ = false;
+    if (wake_fd_ >= 0) {
+        uint64_t one = 1;
+        ssize_t written = write(wake_fd_, &one, sizeof(one));
+        (void)written;
+    }
+}
+
+void OrderServer::reloadMenu() {
+    menu_.clear();
+    for (Dish* dish : manager_.getMenu()) {
+        menu_[dish->getName()] = dish;
+    }
+}
+
+unsigned long OrderServer::getOrdersServed() const {
+    return orders_served_;
+}
+
+void OrderServer::acceptConnections() {
+    while (true) {
+        int fd = accept(listen_fd_, nullptr, nullptr);
+        if (fd < 0) {
+            return; // EAGAIN: no more pending connections
+        }
+        if (!setNonBlocking(fd)) {
+            close(fd);
+            continue;
+        }
+        Connection* connection = new Connection{fd, "", "", false, false};
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) != 0) {
+            close(fd);
+            delete connection;
+            continue;
+        }
+        connections_[fd] = connection;
+    }
+}
+
+// Reads everything available; returns false once the peer has hung up or failed
+bool OrderServer::readConnection(Connection* connection) {
+    char buffer[READ_CHUNK];
+    while (true) {
+        ssize_t count = read(connection->fd, buffer, sizeof(buffer));
+        if (count > 0) {
+            connection->in.append(buffer, count);
+            continue;
+        }
+        if (count == 0) {
+            return false;
+        }
+        return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    }
+}
+
+// Writes as much pending output as the socket accepts; returns false on a write error
+bool OrderServer::flushConnection(Connection* connection) {
+    size_t sent = 0;
+    while (sent < connection->out.size()) {
+        ssize_t count = write(connection->fd, connection->out.data() + sent, connection->out.size() - sent);
+        if (count > 0) {
+            sent += count;
+            continue;
+        }
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        return false;
+    }
+    connection->out.erase(0, sent);
+
+    // Only watch for writability while output is backed up
+    bool want_write = !connection->out.empty();
+    if (want_write != connection->want_write) {
+        epoll_event event;
+        event.events = want_write ? (EPOLLIN | EPOLLOUT) : EPOLLIN;
+        event.data.fd = connection->fd;
+        epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, connection->fd, &event);
+        connection->want_write = want_write;
+    }
+    return true;
+}
+
+void OrderServer::closeConnection(Connection* connection) {
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, connection->fd, nullptr);
+    close(connection->fd);
+    connections_.erase(connection->fd);
+    delete connection;
+}
+
+// Splits complete request lines off the input buffer and adds them to the batch
+void OrderServer::parseRequests(Connection* connection) {
+    static const std::string ORDER = "ORDER ";
+    size_t start = 0;
+    size_t end;
+    while ((end = connection->in.find('\n', start)) != std::string::npos) {
+        std::string line = connection->in.substr(start, end - start);
+        start = end + 1;
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        PendingOrder order{connection, nullptr, ""};
+        if (line.compare(0, ORDER.size(), ORDER) == 0) {
+            std::string dish_name = line.substr(ORDER.size());
+            auto found = menu_.find(dish_name);
+            if (found != menu_.end()) {
+                order.dish = found->second;
+            } else {
+                order.response = "UNKNOWN " + dish_name + "\n";
+            }
+        } else {
+            order.response = "ERROR " + line + "\n";
+        }
+        batch_.push_back(order);
+    }
+    connection->in.erase(0, start);
+
+    // A client that never sends a newline is not allowed to grow the buffer forever
+    if (connection->in.size() > MAX_LINE) {
+        connection->in.clear();
+        connection->closing = true;
+    }
+}
+
+// Queues the batch, prepares it in one pass, and appends the answers in request order
+void OrderServer::processBatch() {
+    if (batch_.empty()) {
+        return;
+    }
+
+    for (PendingOrder& order : batch_) {
+        if (order.dish == nullptr) {
+            continue;
+        }
+        Dish* copy = order.dish->clone(); // The queue owns what it holds, so it gets its own copy
+        StationManager::AdmissionResult admission =
+            copy != nullptr ? manager_.tryAddDishToQueue(copy) : StationManager::INVALID_DISH;
+        if (admission != StationManager::ADMITTED) {
+            const char* reason = admission == StationManager::QUEUE_FULL ? "BUSY "
+                               : admission == StationManager::OUT_OF_STOCK ? "SOLDOUT " : "UNKNOWN ";
+            order.response = reason + order.dish->getName() + "\n";
+            order.dish = nullptr;
+            delete copy;
+            continue;
+        }
+        order.dish = copy;
+    }
+
+    static std::ostream discard(nullptr);
+    results_.clear();
+    manager_.processAllDishes(discard, &results_);
+
+    size_t next_result = 0;
+    for (PendingOrder& order : batch_) {
+        std::string& out = order.connection->out;
+        if (order.dish == nullptr) {
+            out += order.response;
+        } else {
+            bool prepared = results_[next_result++];
+            out += prepared ? "OK " : "FAIL ";
+            out += order.dish->getName();
+            out += '\n';
+            if (prepared) {
+                delete order.dish; // processAllDishes() took it out of the queue
+            }
+        }
+        ++orders_served_;
+    }
+    manager_.clearDishQueue(); // Failed orders have been answered; delete them
+    batch_.clear();
+}
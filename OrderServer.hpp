@@ -0,0 +1,112 @@
+/**
+ * @file OrderServer.hpp
+ * @brief This file contains the declaration of the OrderServer class, which accepts orders for a
+ * StationManager over a Unix domain socket.
+ *
+ * The protocol is line based. Each request is one line and each request gets exactly one response
+ * line, in request order, so clients may pipeline as many requests as they like:
+ *
+ *   ORDER <dish name>     ->  OK <dish name>        the dish was prepared
+ *                             FAIL <dish name>      no station could prepare the dish
+ *                             UNKNOWN <dish name>   no station serves the dish
+ *                             SOLDOUT <dish name>   the kitchen and backup cannot cover the recipe
+ *                             BUSY <dish name>      the queue is at capacity; retry later
+ *   anything else         ->  ERROR <request line>
+ *
+ * All requests that arrive during one pass of the event loop go through tryAddDishToQueue()
+ * together and are prepared with a single processAllDishes() call. Dishes that could not be
+ * prepared are answered with FAIL and dropped from the queue, so every batch starts empty.
+ * Set a queue capacity on the manager to bound the batch size under overload.
+ */
+
+#ifndef ORDERSERVER_HPP
+#define ORDERSERVER_HPP
+
+#include "StationManager.hpp"
+#include <atomic>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class OrderServer {
+public:
+    /**
+     * Parameterized constructor.
+     * @param manager The station manager that prepares the orders. It must outlive the server.
+     * @param socket_path The file system path of the Unix domain socket to listen on.
+     */
+    OrderServer(StationManager& manager, const std::string& socket_path);
+
+    /**
+     * Destructor.
+     * @post: Closes every connection and the listening socket, and unlinks the socket path.
+     */
+    ~OrderServer();
+
+    /**
+     * Binds and listens on the socket path, replacing any stale socket file.
+     * @post: The dish catalog is loaded from the manager's menu.
+     * @return: True if the server is ready to run; false otherwise (errno describes the failure).
+     */
+    bool start();
+
+    /**
+     * Runs the event loop until stop() is called.
+     * @pre: start() returned true.
+     */
+    void run();
+
+    /**
+     * Asks the event loop to return. Safe to call from a signal handler or another thread.
+     */
+    void stop();
+
+    /**
+     * Reloads the dish catalog from the manager's menu.
+     * @post: Orders are resolved against the dishes currently assigned to stations.
+     */
+    void reloadMenu();
+
+    /**
+     * @return: The number of orders answered since start().
+     */
+    unsigned long getOrdersServed() const;
+
+private:
+    // One client connection and its unparsed input / unsent output
+    struct Connection {
+        int fd;
+        std::string in;
+        std::string out;
+        bool want_write;
+        bool closing;           // peer hung up; closed once its batch has been answered
+    };
+
+    // One parsed request of the current batch
+    struct PendingOrder {
+        Connection* connection;
+        Dish* dish;             // the menu dish, then its queued copy; nullptr if the request gets no preparation result
+        std::string response;   // fixed response for requests that are not queued
+    };
+
+    void acceptConnections();
+    bool readConnection(Connection* connection);
+    bool flushConnection(Connection* connection);
+    void closeConnection(Connection* connection);
+    void parseRequests(Connection* connection);
+    void processBatch();
+
+    StationManager& manager_;
+    std::string socket_path_;
+    int listen_fd_;
+    int epoll_fd_;
+    int wake_fd_;
+    std::atomic<bool> running_;
+    unsigned long orders_served_;
+    std::unordered_map<int, Connection*> connections_;
+    std::unordered_map<std::string, Dish*> menu_;
+    std::vector<PendingOrder> batch_;
+    std::vector<bool> results_;
+};
+
+#endif // ORDERSERVER_HPP
@@ -0,0 +1,161 @@
+/**
+ * @file PhaseProfiler.cpp
+ * @brief This file contains the implementation of the PhaseProfiler class.
+ */
+
+#include "PhaseProfiler.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace {
+const char* PHASE_NAMES[] = {"station lookup", "feasibility", "replenishment", "deduction", "output"};
+
+int openEvent(uint32_t type, uint64_t config, int group_fd) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = group_fd == -1 ? 1 : 0;   // The leader starts the whole group
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+uint64_t nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+}
+
+PhaseProfiler::PhaseProfiler() : group_fd_(-1), current_(NONE) {
+    const struct {
+        uint32_t type;
+        uint64_t config;
+    } events[EVENT_COUNT] = {
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    };
+    for (int i = 0; i < EVENT_COUNT; ++i) {
+        fds_[i] = -1;
+    }
+    group_fd_ = openEvent(events[0].type, events[0].config, -1);
+    if (group_fd_ >= 0) {
+        fds_[0] = group_fd_;
+        for (int i = 1; i < EVENT_COUNT; ++i) {
+            fds_[i] = openEvent(events[i].type, events[i].config, group_fd_); // -1 if this CPU lacks the event
+        }
+        ioctl(group_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(group_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+    read(last_);
+}
+
+PhaseProfiler::~PhaseProfiler() {
+    for (int i = EVENT_COUNT - 1; i >= 0; --i) {
+        if (fds_[i] >= 0) {
+            close(fds_[i]);
+        }
+    }
+}
+
+bool PhaseProfiler::isAvailable() const {
+    return group_fd_ >= 0;
+}
+
+PhaseProfiler::Phase PhaseProfiler::enter(Phase phase) {
+    Phase previous = current_;
+    if (phase == previous) {
+        return previous;
+    }
+    uint64_t now[EVENT_COUNT + 1];
+    read(now);
+    if (previous != NONE) {
+        Counters& counters = counters_[previous];
+        counters.cycles += now[0] - last_[0];
+        counters.instructions += now[1] - last_[1];
+        counters.l1_misses += now[2] - last_[2];
+        counters.llc_misses += now[3] - last_[3];
+        counters.branch_misses += now[4] - last_[4];
+        counters.nanoseconds += now[EVENT_COUNT] - last_[EVENT_COUNT];
+    }
+    if (phase != NONE) {
+        ++counters_[phase].entries;
+    }
+    std::memcpy(last_, now, sizeof(last_));
+    current_ = phase;
+    return previous;
+}
+
+const PhaseProfiler::Counters& PhaseProfiler::getCounters(Phase phase) const {
+    return counters_[phase];
+}
+
+const char* PhaseProfiler::getPhaseName(Phase phase) {
+    return phase < PHASE_COUNT ? PHASE_NAMES[phase] : "none";
+}
+
+void PhaseProfiler::reset() {
+    for (Counters& counters : counters_) {
+        counters = Counters();
+    }
+}
+
+void PhaseProfiler::report(std::ostream& out, uint64_t orders) const {
+    if (orders == 0) {
+        orders = 1;
+    }
+    uint64_t total_ns = 0;
+    for (const Counters& counters : counters_) {
+        total_ns += counters.nanoseconds;
+    }
+    char line[256];
+    std::snprintf(line, sizeof(line), "%-17s %9s %9s %10s %10s %9s %9s %9s %7s\n", "phase (per order)", "entries",
+                  "ns", "cycles", "instr", "L1 miss", "LLC miss", "br miss", "time");
+    out << line;
+    for (int phase = 0; phase < PHASE_COUNT; ++phase) {
+        const Counters& counters = counters_[phase];
+        const uint64_t values[] = {counters.cycles, counters.instructions, counters.l1_misses, counters.llc_misses,
+                                   counters.branch_misses};
+        char formatted[EVENT_COUNT][16];
+        for (int i = 0; i < EVENT_COUNT; ++i) {
+            if (fds_[i] < 0) {
+                std::snprintf(formatted[i], sizeof(formatted[i]), "n/a");
+            } else {
+                std::snprintf(formatted[i], sizeof(formatted[i]), "%.2f", static_cast<double>(values[i]) / orders);
+            }
+        }
+        std::snprintf(line, sizeof(line), "%-17s %9.2f %9.1f %10s %10s %9s %9s %9s %6.1f%%\n", PHASE_NAMES[phase],
+                      static_cast<double>(counters.entries) / orders, static_cast<double>(counters.nanoseconds) / orders,
+                      formatted[0], formatted[1], formatted[2], formatted[3], formatted[4],
+                      total_ns > 0 ? 100.0 * counters.nanoseconds / total_ns : 0.0);
+        out << line;
+    }
+}
+
+// Reads the counters of the open events in order (0 for the others), then the steady clock
+void PhaseProfiler::read(uint64_t* values) const {
+    for (int i = 0; i < EVENT_COUNT; ++i) {
+        values[i] = 0;
+    }
+    if (group_fd_ >= 0) {
+        uint64_t group[1 + EVENT_COUNT];   // the number of events, then their values in opening order
+        if (::read(group_fd_, group, sizeof(group)) > 0) {
+            uint64_t next = 0;
+            for (int i = 0; i < EVENT_COUNT && next < group[0]; ++i) {
+                if (fds_[i] >= 0) {
+                    values[i] = group[1 + next++];
+                }
+            }
+        }
+    }
+    values[EVENT_COUNT] = nowNanos();
+}
@@ -0,0 +1,146 @@
+/**
+ * @file PhaseProfiler.hpp
+ * @brief This file contains the declaration of the PhaseProfiler class, which attributes hardware
+ * performance counters to the phases of dish dispatch.
+ *
+ * The profiler opens one perf_event_open group on the calling thread: cycles, instructions, L1
+ * data cache read misses, last-level cache misses and branch misses. Each time dispatch moves to
+ * another phase, the group is read once and the difference is charged to the phase being left, so
+ * the phases partition the profiled time. When the kernel or the machine does not provide the
+ * counters (no PMU in a VM, perf_event_paranoid too high), the profiler still counts entries and
+ * wall time per phase, and isAvailable() reports false.
+ *
+ * Reading the group is a system call per phase change, so a profiled run is several times slower
+ * than an unprofiled one; the profile shows where the time goes, not how much there is.
+ */
+
+#ifndef PHASEPROFILER_HPP
+#define PHASEPROFILER_HPP
+
+#include <cstdint>
+#include <ostream>
+
+class PhaseProfiler {
+public:
+    enum Phase {
+        STATION_LOOKUP,   // walking the stations and finding the dish or its recipe at one
+        FEASIBILITY,      // checking a station's stock against the recipe
+        REPLENISHMENT,    // topping a station up from the pantry, including substitutions
+        DEDUCTION,        // deducting the recipe and booking the sale
+        OUTPUT,           // emitting the preparation log
+        PHASE_COUNT,
+        NONE = PHASE_COUNT   // outside dispatch; not charged
+    };
+
+    /**
+     * Struct representing the counts charged to one phase.
+     */
+    struct Counters {
+        uint64_t entries = 0;
+        uint64_t nanoseconds = 0;
+        uint64_t cycles = 0;
+        uint64_t instructions = 0;
+        uint64_t l1_misses = 0;
+        uint64_t llc_misses = 0;
+        uint64_t branch_misses = 0;
+    };
+
+    /**
+     * Default constructor.
+     * Opens the counters for the calling thread; only that thread may use the profiler.
+     */
+    PhaseProfiler();
+
+    /**
+     * Destructor.
+     * @post Closes the counters.
+     */
+    ~PhaseProfiler();
+
+    PhaseProfiler(const PhaseProfiler&) = delete;
+    PhaseProfiler& operator=(const PhaseProfiler&) = delete;
+
+    /**
+     * @return True if the hardware counters are open; false if only time is measured.
+     */
+    bool isAvailable() const;
+
+    /**
+     * Charges the counts since the last change to the current phase, then moves to another.
+     * @param phase The phase that starts now, or NONE.
+     * @return The phase that was current.
+     */
+    Phase enter(Phase phase);
+
+    /**
+     * @param phase A phase other than NONE.
+     * @return The counts charged to it so far.
+     */
+    const Counters& getCounters(Phase phase) const;
+
+    /**
+     * @param phase A phase other than NONE.
+     * @return Its name, e.g. "station lookup".
+     */
+    static const char* getPhaseName(Phase phase);
+
+    /**
+     * Sets every count to zero.
+     */
+    void reset();
+
+    /**
+     * Writes one line per phase: entries, time and each counter, divided by `orders`, plus the
+     * share of the profiled time. Counters show n/a when they are unavailable.
+     * @param out The stream to write to.
+     * @param orders The number of orders profiled (at least 1).
+     */
+    void report(std::ostream& out, uint64_t orders) const;
+
+private:
+    static const int EVENT_COUNT = 5;
+
+    void read(uint64_t* values) const;
+
+    int group_fd_;
+    int fds_[EVENT_COUNT];
+    Phase current_;
+    uint64_t last_[EVENT_COUNT + 1];   // the counters, then the steady clock in nanoseconds
+    Counters counters_[PHASE_COUNT];
+};
+
+/**
+ * Moves a profiler to a phase for the life of the scope, then back to the phase it left. Does
+ * nothing when the profiler is null, so unprofiled dispatch pays one pointer test.
+ */
+class PhaseScope {
+public:
+    PhaseScope(PhaseProfiler* profiler, PhaseProfiler::Phase phase)
+        : profiler_(profiler), previous_(profiler != nullptr ? profiler->enter(phase) : PhaseProfiler::NONE) {
+    }
+
+    ~PhaseScope() {
+        if (profiler_ != nullptr) {
+            profiler_->enter(previous_);
+        }
+    }
+
+    /**
+     * Moves to another phase without ending the scope.
+     * @param phase The phase that starts now.
+     */
+    void switchTo(PhaseProfiler::Phase phase) {
+        if (profiler_ != nullptr) {
+            profiler_->enter(phase);
+        }
+    }
+
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+    PhaseProfiler* profiler_;
+    PhaseProfiler::Phase previous_;
+};
+
+#endif // PHASEPROFILER_HPP
@@ -0,0 +1,186 @@
+/**
+ * @file RecipeBook.cpp
+ * @brief This file contains the implementation of the RecipeBook class.
+ */
+
+#include "RecipeBook.hpp"
+#include "MemoryUsage.hpp"
+
+namespace {
+const std::vector<Ingredient> NO_INGREDIENTS;
+}
+
+RecipeBook::RecipeBook() : version_(0), stale_(false) {
+}
+
+bool RecipeBook::addRecipe(const std::string& name, const std::vector<Ingredient>& components, int yield) {
+    if (yield < 1 || recipes_.count(name) != 0) {
+        return false;
+    }
+    for (const Ingredient& component : components) {
+        if (component.name == name || reaches(component.name, name)) {
+            return false;
+        }
+    }
+    recipes_[name] = Recipe{components, yield};
+    ++version_;
+    stale_ = true;
+    return true;
+}
+
+bool RecipeBook::removeRecipe(const std::string& name) {
+    if (recipes_.erase(name) == 0) {
+        return false;
+    }
+    ++version_;
+    stale_ = true;
+    return true;
+}
+
+bool RecipeBook::contains(const std::string& name) const {
+    return recipes_.count(name) != 0;
+}
+
+int RecipeBook::getYield(const std::string& name) const {
+    auto found = recipes_.find(name);
+    return found == recipes_.end() ? 0 : found->second.yield;
+}
+
+std::vector<Ingredient> RecipeBook::getComponents(const std::string& name) const {
+    auto found = recipes_.find(name);
+    return found == recipes_.end() ? std::vector<Ingredient>() : found->second.components;
+}
+
+const std::vector<Ingredient>& RecipeBook::getRawIngredients(const std::string& name) const {
+    refresh();
+    auto found = raw_.find(name);
+    return found == raw_.end() ? NO_INGREDIENTS : found->second;
+}
+
+std::vector<Ingredient> RecipeBook::expand(const std::vector<Ingredient>& recipe) const {
+    refresh();
+    std::vector<Ingredient> raw;
+    expandInto(recipe, raw);
+    return raw;
+}
+
+std::vector<std::string> RecipeBook::getTopologicalOrder() const {
+    refresh();
+    return order_;
+}
+
+size_t RecipeBook::size() const {
+    return recipes_.size();
+}
+
+bool RecipeBook::empty() const {
+    return recipes_.empty();
+}
+
+void RecipeBook::clear() {
+    recipes_.clear();
+    ++version_;
+    stale_ = true;
+}
+
+unsigned long RecipeBook::getVersion() const {
+    return version_;
+}
+
+// True if target is reachable from the sub-recipe `from` (false if `from` is a raw ingredient)
+bool RecipeBook::reaches(const std::string& from, const std::string& target) const {
+    auto found = recipes_.find(from);
+    if (found == recipes_.end()) {
+        return false;
+    }
+    for (const Ingredient& component : found->second.components) {
+        if (component.name == target || reaches(component.name, target)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Depth-first post-order: a sub-recipe is appended after everything it uses
+void RecipeBook::visit(const std::string& name, std::unordered_map<std::string, bool>& visited) const {
+    if (visited[name]) {
+        return;
+    }
+    visited[name] = true;
+    for (const Ingredient& component : recipes_.at(name).components) {
+        if (recipes_.count(component.name) != 0) {
+            visit(component.name, visited);
+        }
+    }
+    order_.push_back(name);
+}
+
+// Rebuilds the topological order, then each sub-recipe's raw list from its children's
+void RecipeBook::refresh() const {
+    if (!stale_) {
+        return;
+    }
+    order_.clear();
+    raw_.clear();
+    std::unordered_map<std::string, bool> visited;
+    for (const auto& entry : recipes_) {
+        visit(entry.first, visited);
+    }
+    for (const std::string& name : order_) {
+        expandInto(recipes_.at(name).components, raw_[name]);
+    }
+    stale_ = false;
+}
+
+// Appends the raw ingredients of a recipe to raw, merging entries of the same ingredient.
+// Sub-recipes must already be in raw_.
+void RecipeBook::expandInto(const std::vector<Ingredient>& recipe, std::vector<Ingredient>& raw) const {
+    std::unordered_map<std::string, size_t> positions;
+    for (size_t i = 0; i < raw.size(); ++i) {
+        positions[raw[i].name] = i;
+    }
+    auto add = [&raw, &positions](const Ingredient& ingredient, int factor) {
+        auto position = positions.find(ingredient.name);
+        if (position == positions.end()) {
+            positions[ingredient.name] = raw.size();
+            raw.push_back(Ingredient(ingredient.name, 0, ingredient.required_quantity * factor, ingredient.price));
+        } else {
+            raw[position->second].required_quantity += ingredient.required_quantity * factor;
+        }
+    };
+    for (const Ingredient& component : recipe) {
+        auto sub_recipe = recipes_.find(component.name);
+        if (sub_recipe == recipes_.end()) {
+            add(component, 1);
+            continue;
+        }
+        int yield = sub_recipe->second.yield;
+        int batches = (component.required_quantity + yield - 1) / yield;
+        for (const Ingredient& ingredient : raw_.at(component.name)) {
+            add(ingredient, batches);
+        }
+    }
+}
+
+size_t RecipeBook::memoryUsage() const {
+    const size_t TREE_NODE = 4 * sizeof(void*);   // color, parent and two children
+    size_t bytes = recipes_.size() * (sizeof(std::map<std::string, Recipe>::value_type) + TREE_NODE);
+    for (const auto& recipe : recipes_) {
+        bytes += heapBytes(recipe.first) + heapBytes(recipe.second.components);
+        for (const Ingredient& component : recipe.second.components) {
+            bytes += heapBytes(component.name);
+        }
+    }
+    bytes += heapBytes(order_);
+    for (const std::string& name : order_) {
+        bytes += heapBytes(name);
+    }
+    bytes += hashBytes(raw_);
+    for (const auto& raw : raw_) {
+        bytes += heapBytes(raw.first) + heapBytes(raw.second);
+        for (const Ingredient& ingredient : raw.second) {
+            bytes += heapBytes(ingredient.name);
+        }
+    }
+    return bytes;
+}
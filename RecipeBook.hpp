@@ -0,0 +1,148 @@
+/**
+ * @file RecipeBook.hpp
+ * @brief This file contains the declaration of the RecipeBook class, a DAG of sub-recipes such as
+ * sauces, stocks and side dishes.
+ *
+ * A sub-recipe is a named list of components plus a yield: one batch makes `yield` units. A
+ * component whose name is another sub-recipe refers to it; any other component is a raw
+ * ingredient. Cycles are rejected when a sub-recipe is added.
+ *
+ * Every sub-recipe's expansion to raw ingredients is cached. The cache is rebuilt in topological
+ * order after the book changes, so each sub-recipe is expanded from its children's cached lists
+ * once; expanding a dish's recipe afterwards costs the same as reading a flat recipe of the same
+ * width. The cache is rebuilt lazily by the const queries, so a book must not be read from several
+ * threads while it is being changed.
+ */
+
+#ifndef RECIPEBOOK_HPP
+#define RECIPEBOOK_HPP
+
+#include "Dish.hpp"
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class KitchenStation;
+
+/**
+ * @struct BatchPlan
+ * @brief Batches of a sub-recipe a station should prepare ahead of demand.
+ */
+struct BatchPlan {
+    const KitchenStation* station;
+    std::string recipe_name;
+    int batches;          // batches to prepare now
+    double units_needed;  // projected units used over the horizon
+    int on_hand;          // units the station holds now
+};
+
+class RecipeBook {
+public:
+    /**
+     * Default constructor.
+     * Initializes an empty book.
+     */
+    RecipeBook();
+
+    /**
+     * Adds a sub-recipe.
+     * @param name The name of the sub-recipe; recipes and stations refer to it by this name.
+     * @param components The ingredients and sub-recipes of one batch, with their
+     * required_quantity set.
+     * @param yield The units one batch makes (at least 1).
+     * @return True if the sub-recipe was added; false if the name is taken, the yield is not
+     * positive, or a component refers back to the sub-recipe.
+     */
+    bool addRecipe(const std::string& name, const std::vector<Ingredient>& components, int yield = 1);
+
+    /**
+     * Removes a sub-recipe. Recipes that refer to it treat its name as a raw ingredient again.
+     * @param name The name of the sub-recipe.
+     * @return True if it was removed; false if there was no such sub-recipe.
+     */
+    bool removeRecipe(const std::string& name);
+
+    /**
+     * @param name A name.
+     * @return True if the name is a sub-recipe; false if it is a raw ingredient.
+     */
+    bool contains(const std::string& name) const;
+
+    /**
+     * @param name The name of a sub-recipe.
+     * @return The units one batch makes, or 0 if there is no such sub-recipe.
+     */
+    int getYield(const std::string& name) const;
+
+    /**
+     * @param name The name of a sub-recipe.
+     * @return The components of one batch, or an empty list if there is no such sub-recipe.
+     */
+    std::vector<Ingredient> getComponents(const std::string& name) const;
+
+    /**
+     * @param name The name of a sub-recipe.
+     * @return The raw ingredients of one batch made from scratch, one entry per ingredient, or an
+     * empty list if there is no such sub-recipe. Nested sub-recipes are made in whole batches.
+     */
+    const std::vector<Ingredient>& getRawIngredients(const std::string& name) const;
+
+    /**
+     * Expands a recipe to raw ingredients.
+     * @param recipe Ingredients and sub-recipes with their required_quantity set.
+     * @return The raw ingredients, one entry per ingredient. Each sub-recipe is made in as many
+     * whole batches as its required quantity needs.
+     */
+    std::vector<Ingredient> expand(const std::vector<Ingredient>& recipe) const;
+
+    /**
+     * @return The names of all sub-recipes, each after every sub-recipe it uses.
+     */
+    std::vector<std::string> getTopologicalOrder() const;
+
+    /**
+     * @return The number of sub-recipes.
+     */
+    size_t size() const;
+
+    /**
+     * @return True if the book has no sub-recipes.
+     */
+    bool empty() const;
+
+    /**
+     * Removes every sub-recipe.
+     */
+    void clear();
+
+    /**
+     * @return A counter that changes whenever a sub-recipe is added or removed, so callers can tell
+     * when a copy they derived from the book is out of date.
+     */
+    unsigned long getVersion() const;
+
+    /**
+     * @return The heap bytes held by the book and its caches, estimated as in MemoryUsage.hpp.
+     */
+    size_t memoryUsage() const;
+
+private:
+    struct Recipe {
+        std::vector<Ingredient> components;
+        int yield;
+    };
+
+    bool reaches(const std::string& from, const std::string& target) const;
+    void visit(const std::string& name, std::unordered_map<std::string, bool>& visited) const;
+    void refresh() const;
+    void expandInto(const std::vector<Ingredient>& recipe, std::vector<Ingredient>& raw) const;
+
+    std::map<std::string, Recipe> recipes_;   // ordered, so the topological order is deterministic
+    unsigned long version_;                    // incremented by every change
+    mutable bool stale_;                       // the caches below predate the last change
+    mutable std::vector<std::string> order_;
+    mutable std::unordered_map<std::string, std::vector<Ingredient>> raw_;   // per batch
+};
+
+#endif // RECIPEBOOK_HPP
@@ -0,0 +1,601 @@
+/**
+ * @file SessionTrace.cpp
+ * @brief This file contains the implementation of the SessionRecorder and SessionReplayer classes.
+ */
+
+#include "SessionTrace.hpp"
+#include "Appetizer.hpp"
+#include "Dessert.hpp"
+#include "MainCourse.hpp"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <thread>
+
+namespace {
+const char MAGIC[4] = {'K', 'T', 'R', '1'};
+
+// Trace records; NAME and DISH define the next name or dish index, the others are calls
+enum Op : uint8_t {
+    NAME = 1,                    // length, bytes
+    DISH,                        // kind, cuisine, name, prep time, price, line count, (ingredient, required)...
+    ADD_STATION,                 // name, line count, (ingredient, quantity, price)...
+    ASSIGN_DISH,                 // station, dish
+    QUEUE_DISH,                  // dish
+    REPLENISH_AT_STATION,        // station, ingredient, quantity, required, price
+    REPLENISH_FROM_BACKUP,       // station, ingredient, quantity
+    ADD_BACKUP,                  // ingredient, quantity, required, price
+    PREPARE_NEXT,
+    PROCESS_ALL,
+    CHECKSUM                     // 8 bytes, little-endian
+};
+
+enum DishKind : uint8_t { APPETIZER, MAIN_COURSE, DESSERT };
+
+// Dish::getCuisineType() of each CuisineType, in enum order
+const char* CUISINE_NAMES[] = {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "OTHER"};
+
+const uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+void hashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * FNV_PRIME;
+    }
+}
+
+void hashString(uint64_t& hash, const std::string& value) {
+    hashBytes(hash, value.data(), value.size());
+    hashBytes(hash, "", 1);   // terminator, so "ab"+"c" and "a"+"bc" differ
+}
+
+void hashNumber(uint64_t& hash, int64_t value) {
+    hashBytes(hash, &value, sizeof(value));
+}
+
+// Reads the variable-length numbers written by SessionRecorder
+class TraceReader {
+public:
+    TraceReader(const std::vector<uint8_t>& trace, size_t pos) : trace_(trace), pos_(pos), ok_(true) {
+    }
+
+    bool atEnd() const {
+        return pos_ >= trace_.size();
+    }
+
+    bool ok() const {
+        return ok_;
+    }
+
+    uint8_t readByte() {
+        if (pos_ >= trace_.size()) {
+            ok_ = false;
+            return 0;
+        }
+        return trace_[pos_++];
+    }
+
+    uint64_t readUnsigned() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = readByte();
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+        ok_ = false;
+        return 0;
+    }
+
+    int64_t readSigned() {
+        uint64_t value = readUnsigned();
+        return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+    }
+
+    // Reads an index and checks it against the number of entries defined so far
+    uint32_t readRef(size_t defined) {
+        uint64_t value = readUnsigned();
+        if (value >= defined) {
+            ok_ = false;
+            return 0;
+        }
+        return static_cast<uint32_t>(value);
+    }
+
+    bool readBytes(void* out, size_t size) {
+        if (trace_.size() - pos_ < size) {
+            ok_ = false;
+            return false;
+        }
+        std::memcpy(out, trace_.data() + pos_, size);
+        pos_ += size;
+        return true;
+    }
+
+private:
+    const std::vector<uint8_t>& trace_;
+    size_t pos_;
+    bool ok_;
+};
+}
+
+uint64_t stateChecksum(const StationManager& manager) {
+    uint64_t hash = FNV_OFFSET;
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    for (Node<KitchenStation*>* node = manager.getHeadNode(); node != nullptr; node = node->getNext()) {
+        const KitchenStation* station = node->getItem();
+        hashString(hash, station->getName());
+        hashNumber(hash, static_cast<int64_t>(station->getDishes().size()));
+        for (const Dish* dish : station->getDishes()) {
+            hashString(hash, dish->getName());
+        }
+        hashNumber(hash, static_cast<int64_t>(station->getStockLines().size()));
+        for (const StockLine& line : station->getStockLines()) {
+            hashString(hash, registry.getName(line.id));
+            hashNumber(hash, line.quantity);
+            hashNumber(hash, line.price.getCents());
+        }
+    }
+    std::vector<Ingredient> backup = manager.getBackupIngredients();
+    hashNumber(hash, static_cast<int64_t>(backup.size()));
+    for (const Ingredient& ingredient : backup) {
+        hashString(hash, ingredient.name);
+        hashNumber(hash, ingredient.quantity);
+        hashNumber(hash, ingredient.getPriceMoney().getCents());
+    }
+    std::queue<Dish*> queue = manager.getDishQueue();
+    hashNumber(hash, static_cast<int64_t>(queue.size()));
+    for (; !queue.empty(); queue.pop()) {
+        hashString(hash, queue.front()->getName());
+    }
+    return hash;
+}
+
+SessionRecorder::SessionRecorder(StationManager& manager) : manager_(manager), calls_(0) {
+    trace_.assign(MAGIC, MAGIC + sizeof(MAGIC));
+
+    // The kitchen as it stands, written as the calls that would have built it
+    for (Node<KitchenStation*>* node = manager_.getHeadNode(); node != nullptr; node = node->getNext()) {
+        recordStation(*node->getItem());
+    }
+    for (const Ingredient& ingredient : manager_.getBackupIngredients()) {
+        uint32_t ingredient_ref = nameRef(ingredient.name);
+        writeOp(ADD_BACKUP);
+        writeUnsigned(ingredient_ref);
+        writeSigned(ingredient.quantity);
+        writeSigned(ingredient.required_quantity);
+        writeSigned(ingredient.getPriceMoney().getCents());
+    }
+    for (std::queue<Dish*> queue = manager_.getDishQueue(); !queue.empty(); queue.pop()) {
+        uint32_t dish_ref = dishRef(queue.front());
+        writeOp(QUEUE_DISH);
+        writeUnsigned(dish_ref);
+    }
+}
+
+bool SessionRecorder::addStation(KitchenStation* station) {
+    if (station != nullptr) {
+        recordStation(*station);
+    }
+    return manager_.addStation(station);
+}
+
+bool SessionRecorder::assignDishToStation(const std::string& station_name, Dish* dish) {
+    if (dish != nullptr) {
+        uint32_t station_ref = nameRef(station_name);
+        uint32_t dish_ref = dishRef(dish);
+        writeOp(ASSIGN_DISH);
+        writeUnsigned(station_ref);
+        writeUnsigned(dish_ref);
+    }
+    return manager_.assignDishToStation(station_name, dish);
+}
+
+void SessionRecorder::addDishToQueue(Dish* dish) {
+    if (dish != nullptr) {
+        uint32_t dish_ref = dishRef(dish);
+        writeOp(QUEUE_DISH);
+        writeUnsigned(dish_ref);
+    }
+    manager_.addDishToQueue(dish);
+}
+
+bool SessionRecorder::replenishIngredientAtStation(const std::string& station_name, const Ingredient& ingredient) {
+    uint32_t station_ref = nameRef(station_name);
+    uint32_t ingredient_ref = nameRef(ingredient.name);
+    writeOp(REPLENISH_AT_STATION);
+    writeUnsigned(station_ref);
+    writeUnsigned(ingredient_ref);
+    writeSigned(ingredient.quantity);
+    writeSigned(ingredient.required_quantity);
+    writeSigned(ingredient.getPriceMoney().getCents());
+    return manager_.replenishIngredientAtStation(station_name, ingredient);
+}
+
+bool SessionRecorder::replenishStationIngredientFromBackup(const std::string& station_name, const std::string& ingredient_name, int quantity) {
+    uint32_t station_ref = nameRef(station_name);
+    uint32_t ingredient_ref = nameRef(ingredient_name);
+    writeOp(REPLENISH_FROM_BACKUP);
+    writeUnsigned(station_ref);
+    writeUnsigned(ingredient_ref);
+    writeSigned(quantity);
+    return manager_.replenishStationIngredientFromBackup(station_name, ingredient_name, quantity);
+}
+
+bool SessionRecorder::addBackupIngredient(const Ingredient& ingredient) {
+    uint32_t ingredient_ref = nameRef(ingredient.name);
+    writeOp(ADD_BACKUP);
+    writeUnsigned(ingredient_ref);
+    writeSigned(ingredient.quantity);
+    writeSigned(ingredient.required_quantity);
+    writeSigned(ingredient.getPriceMoney().getCents());
+    return manager_.addBackupIngredient(ingredient);
+}
+
+bool SessionRecorder::prepareNextDish() {
+    writeOp(PREPARE_NEXT);
+    return manager_.prepareNextDish();
+}
+
+void SessionRecorder::processAllDishes(EventSink& events, std::vector<bool>* results) {
+    writeOp(PROCESS_ALL);
+    manager_.processAllDishes(events, results);
+}
+
+uint64_t SessionRecorder::finish() {
+    uint64_t checksum = stateChecksum(manager_);
+    trace_.push_back(CHECKSUM);
+    for (int i = 0; i < 8; ++i) {
+        trace_.push_back(static_cast<uint8_t>(checksum >> (8 * i)));
+    }
+    return checksum;
+}
+
+size_t SessionRecorder::getCallCount() const {
+    return calls_;
+}
+
+const std::vector<uint8_t>& SessionRecorder::getTrace() const {
+    return trace_;
+}
+
+bool SessionRecorder::save(const std::string& path) const {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(trace_.data()), static_cast<std::streamsize>(trace_.size()));
+    out.close();
+    return !out.fail();
+}
+
+// Records a station with its stock, then the dishes it already serves
+void SessionRecorder::recordStation(const KitchenStation& station) {
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    uint32_t station_ref = nameRef(station.getName());
+    std::vector<uint32_t> ingredient_refs;
+    for (const StockLine& line : station.getStockLines()) {
+        ingredient_refs.push_back(nameRef(registry.getName(line.id)));
+    }
+    std::vector<uint32_t> dish_refs;
+    for (const Dish* dish : station.getDishes()) {
+        dish_refs.push_back(dishRef(dish));
+    }
+    writeOp(ADD_STATION);
+    writeUnsigned(station_ref);
+    writeUnsigned(ingredient_refs.size());
+    for (size_t i = 0; i < ingredient_refs.size(); ++i) {
+        const StockLine& line = station.getStockLines()[i];
+        writeUnsigned(ingredient_refs[i]);
+        writeSigned(line.quantity);
+        writeSigned(line.price.getCents());
+    }
+    for (uint32_t dish_ref : dish_refs) {
+        writeOp(ASSIGN_DISH);
+        writeUnsigned(station_ref);
+        writeUnsigned(dish_ref);
+    }
+}
+
+// Returns the index of a name, defining it in the trace the first time it is seen
+uint32_t SessionRecorder::nameRef(const std::string& name) {
+    auto found = names_.find(name);
+    if (found != names_.end()) {
+        return found->second;
+    }
+    uint32_t ref = static_cast<uint32_t>(names_.size());
+    names_.emplace(name, ref);
+    trace_.push_back(NAME);
+    writeUnsigned(name.size());
+    trace_.insert(trace_.end(), name.begin(), name.end());
+    return ref;
+}
+
+// Returns the index of a dish, defining it with its current recipe the first time it is seen
+uint32_t SessionRecorder::dishRef(const Dish* dish) {
+    auto found = dishes_.find(dish);
+    if (found != dishes_.end()) {
+        return found->second;
+    }
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    uint32_t name_ref = nameRef(dish->getName());
+    std::vector<uint32_t> ingredient_refs;
+    for (const RecipeLine& line : dish->getRecipeLines()) {
+        ingredient_refs.push_back(nameRef(registry.getName(line.id)));
+    }
+    uint8_t kind = dynamic_cast<const MainCourse*>(dish) != nullptr ? MAIN_COURSE
+                 : dynamic_cast<const Dessert*>(dish) != nullptr ? DESSERT : APPETIZER;
+    uint8_t cuisine = Dish::OTHER;
+    for (int c = Dish::ITALIAN; c < Dish::OTHER; ++c) {
+        if (dish->getCuisineType() == CUISINE_NAMES[c]) {
+            cuisine = static_cast<uint8_t>(c);
+            break;
+        }
+    }
+
+    uint32_t ref = static_cast<uint32_t>(dishes_.size());
+    dishes_.emplace(dish, ref);
+    trace_.push_back(DISH);
+    trace_.push_back(kind);
+    trace_.push_back(cuisine);
+    writeUnsigned(name_ref);
+    writeSigned(dish->getPrepTime());
+    writeSigned(dish->getPriceMoney().getCents());
+    writeUnsigned(ingredient_refs.size());
+    for (size_t i = 0; i < ingredient_refs.size(); ++i) {
+        writeUnsigned(ingredient_refs[i]);
+        writeSigned(dish->getRecipeLines()[i].required);
+    }
+    return ref;
+}
+
+void SessionRecorder::writeOp(uint8_t op) {
+    trace_.push_back(op);
+    ++calls_;
+}
+
+// LEB128: seven bits per byte, low bits first
+void SessionRecorder::writeUnsigned(uint64_t value) {
+    while (value >= 0x80) {
+        trace_.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    trace_.push_back(static_cast<uint8_t>(value));
+}
+
+// Zigzag, so that small negative numbers stay short
+void SessionRecorder::writeSigned(int64_t value) {
+    writeUnsigned((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+SessionReplayer::SessionReplayer() : has_checksum_(false), checksum_(0) {
+}
+
+SessionReplayer* SessionReplayer::fromTrace(const std::vector<uint8_t>& trace) {
+    SessionReplayer* replayer = new SessionReplayer();
+    if (!replayer->decode(trace)) {
+        delete replayer;
+        return nullptr;
+    }
+    return replayer;
+}
+
+SessionReplayer* SessionReplayer::load(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return nullptr;
+    }
+    std::vector<uint8_t> trace((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    return fromTrace(trace);
+}
+
+bool SessionReplayer::decode(const std::vector<uint8_t>& trace) {
+    if (trace.size() < sizeof(MAGIC) || std::memcmp(trace.data(), MAGIC, sizeof(MAGIC)) != 0) {
+        return false;
+    }
+    TraceReader reader(trace, sizeof(MAGIC));
+    while (reader.ok() && !reader.atEnd()) {
+        uint8_t op = reader.readByte();
+        Call call = {op, 0, 0, 0, 0, Money()};
+        switch (op) {
+        case NAME: {
+            uint64_t length = reader.readUnsigned();
+            if (length > trace.size()) {
+                return false;
+            }
+            std::string name(length, '\0');
+            if (!reader.readBytes(&name[0], name.size())) {
+                return false;
+            }
+            names_.push_back(name);
+            continue;
+        }
+        case DISH: {
+            DishDef dish;
+            dish.kind = reader.readByte();
+            dish.cuisine = reader.readByte();
+            dish.name = reader.readRef(names_.size());
+            dish.prep_time = static_cast<int>(reader.readSigned());
+            dish.price = Money::fromCents(reader.readSigned());
+            uint64_t lines = reader.readUnsigned();
+            for (uint64_t i = 0; i < lines && reader.ok(); ++i) {
+                RecipeLine line;
+                line.id = reader.readRef(names_.size());
+                line.required = static_cast<int>(reader.readSigned());
+                dish.recipe.push_back(line);
+            }
+            if (dish.kind > DESSERT || dish.cuisine > Dish::OTHER) {
+                return false;
+            }
+            dishes_.push_back(dish);
+            continue;
+        }
+        case ADD_STATION: {
+            StationDef station;
+            station.name = reader.readRef(names_.size());
+            uint64_t lines = reader.readUnsigned();
+            for (uint64_t i = 0; i < lines && reader.ok(); ++i) {
+                StockLine line;
+                line.id = reader.readRef(names_.size());
+                line.quantity = static_cast<int>(reader.readSigned());
+                line.price = Money::fromCents(reader.readSigned());
+                station.stock.push_back(line);
+            }
+            call.station = static_cast<uint32_t>(stations_.size());
+            stations_.push_back(station);
+            break;
+        }
+        case ASSIGN_DISH:
+            call.station = reader.readRef(names_.size());
+            call.target = reader.readRef(dishes_.size());
+            break;
+        case QUEUE_DISH:
+            call.target = reader.readRef(dishes_.size());
+            break;
+        case REPLENISH_AT_STATION:
+        case ADD_BACKUP:
+            call.station = op == REPLENISH_AT_STATION ? reader.readRef(names_.size()) : 0;
+            call.target = reader.readRef(names_.size());
+            call.quantity = static_cast<int>(reader.readSigned());
+            call.required = static_cast<int>(reader.readSigned());
+            call.price = Money::fromCents(reader.readSigned());
+            break;
+        case REPLENISH_FROM_BACKUP:
+            call.station = reader.readRef(names_.size());
+            call.target = reader.readRef(names_.size());
+            call.quantity = static_cast<int>(reader.readSigned());
+            break;
+        case PREPARE_NEXT:
+        case PROCESS_ALL:
+            break;
+        case CHECKSUM: {
+            uint8_t bytes[8];
+            if (!reader.readBytes(bytes, sizeof(bytes))) {
+                return false;
+            }
+            checksum_ = 0;
+            for (int i = 0; i < 8; ++i) {
+                checksum_ |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+            }
+            has_checksum_ = true;
+            continue;
+        }
+        default:
+            return false;
+        }
+        calls_.push_back(call);
+    }
+    return reader.ok();
+}
+
+uint64_t SessionReplayer::replay(EventSink& events) const {
+    // Build this replay's own dishes and stations before the first call, so the calls run back to back
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    std::vector<IngredientId> ids(names_.size());
+    for (size_t i = 0; i < names_.size(); ++i) {
+        ids[i] = registry.intern(names_[i]);
+    }
+    std::vector<std::unique_ptr<Dish>> dishes;
+    dishes.reserve(dishes_.size());
+    for (const DishDef& def : dishes_) {
+        Dish* dish = def.kind == MAIN_COURSE ? static_cast<Dish*>(new MainCourse())
+                   : def.kind == DESSERT ? static_cast<Dish*>(new Dessert()) : static_cast<Dish*>(new Appetizer());
+        std::vector<Ingredient> recipe;
+        for (const RecipeLine& line : def.recipe) {
+            recipe.push_back(Ingredient(names_[line.id], 0, line.required, Money()));
+        }
+        dish->setName(names_[def.name]);
+        dish->setIngredients(recipe);
+        dish->setPrepTime(def.prep_time);
+        dish->setPrice(def.price);
+        dish->setCuisineType(static_cast<Dish::CuisineType>(def.cuisine));
+        dishes.emplace_back(dish);
+    }
+    std::vector<std::unique_ptr<KitchenStation>> stations;
+    stations.reserve(stations_.size());
+    for (const StationDef& def : stations_) {
+        KitchenStation* station = new KitchenStation(names_[def.name]);
+        for (StockLine line : def.stock) {
+            line.id = ids[line.id];
+            station->replenishStationIngredients(line);
+        }
+        stations.emplace_back(station);
+    }
+
+    std::vector<bool> assigned(dishes.size(), false);   // A station deletes the dishes it serves
+    uint64_t checksum;
+    {
+        StationManager manager;
+        for (const Call& call : calls_) {
+            switch (call.op) {
+            case ADD_STATION:
+                manager.addStation(stations[call.station].get());
+                break;
+            case ASSIGN_DISH:
+                if (manager.assignDishToStation(names_[call.station], dishes[call.target].get())) {
+                    assigned[call.target] = true;
+                }
+                break;
+            case QUEUE_DISH:
+                manager.addDishToQueue(dishes[call.target].get());
+                break;
+            case REPLENISH_AT_STATION:
+                manager.replenishIngredientAtStation(names_[call.station],
+                                                     Ingredient(names_[call.target], call.quantity, call.required, call.price));
+                break;
+            case REPLENISH_FROM_BACKUP:
+                manager.replenishStationIngredientFromBackup(names_[call.station], names_[call.target], call.quantity);
+                break;
+            case ADD_BACKUP:
+                manager.addBackupIngredient(Ingredient(names_[call.target], call.quantity, call.required, call.price));
+                break;
+            case PREPARE_NEXT:
+                manager.prepareNextDish();
+                break;
+            case PROCESS_ALL:
+                manager.processAllDishes(events);
+                break;
+            }
+        }
+        checksum = stateChecksum(manager);
+        for (auto& station : stations) {   // The stations outlive the manager that observes them
+            station->setObserver(nullptr);
+        }
+    }
+    for (size_t i = 0; i < dishes.size(); ++i) {
+        if (assigned[i]) {
+            dishes[i].release();
+        }
+    }
+    return checksum;
+}
+
+std::vector<uint64_t> SessionReplayer::replayParallel(int threads) const {
+    if (threads < 1) {
+        threads = 1;
+    }
+    std::vector<uint64_t> checksums(threads);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; ++i) {
+        workers.emplace_back([this, &checksums, i]() {
+            NullEventSink events;
+            checksums[i] = replay(events);
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    return checksums;
+}
+
+size_t SessionReplayer::getCallCount() const {
+    return calls_.size();
+}
+
+bool SessionReplayer::hasExpectedChecksum() const {
+    return has_checksum_;
+}
+
+uint64_t SessionReplayer::getExpectedChecksum() const {
+    return checksum_;
+}
@@ -0,0 +1,186 @@
+/**
+ * @file SessionTrace.hpp
+ * @brief This file contains the declaration of the SessionRecorder and SessionReplayer classes,
+ * which record the StationManager calls of a dispatch session to a compact binary trace and run
+ * them again.
+ *
+ * A recorder is attached to a running kitchen: it first writes the kitchen's current stations,
+ * menus, stock, pantry and queue as calls, then forwards each call made through it to the manager
+ * and appends it to the trace. Names and dishes are written once and referred to by index after
+ * that, and numbers are variable-length, so a queued order costs two bytes. The replayer decodes a
+ * trace once and can then run it any number of times, each time on a fresh StationManager with its
+ * own stations and dishes, from one thread or from several at once.
+ *
+ * stateChecksum() hashes the final state of a kitchen by name, not by pointer or ingredient ID, so
+ * a trace recorded in one process and replayed in another yields the same checksum when the
+ * dispatch logic is unchanged. The recorder can store it at the end of the trace for the replayer
+ * to check.
+ *
+ * Not recorded: dietary requests, the substitution graph, the recipe book, a backup supplier, the
+ * queue capacity and the clock. A session that depends on them replays without them.
+ */
+
+#ifndef SESSIONTRACE_HPP
+#define SESSIONTRACE_HPP
+
+#include "EventSink.hpp"
+#include "StationManager.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Hashes the stations of a kitchen in order, with their dishes and stock lines, then its pantry and
+ * its queue (FNV-1a, 64 bits). Revenue, statistics and stock history are not included.
+ * @param manager The kitchen.
+ * @return The checksum.
+ */
+uint64_t stateChecksum(const StationManager& manager);
+
+class SessionRecorder {
+public:
+    /**
+     * Parameterized constructor. Records the kitchen's current state as the start of the trace.
+     * @param manager The kitchen whose calls are recorded; it must outlive the recorder.
+     */
+    explicit SessionRecorder(StationManager& manager);
+
+    SessionRecorder(const SessionRecorder&) = delete;
+    SessionRecorder& operator=(const SessionRecorder&) = delete;
+
+    /**
+     * Forward to the StationManager functions of the same name and record the call. A station is
+     * recorded with the stock it holds when it is added, and a dish with its recipe when it is
+     * first seen.
+     */
+    bool addStation(KitchenStation* station);
+    bool assignDishToStation(const std::string& station_name, Dish* dish);
+    void addDishToQueue(Dish* dish);
+    bool replenishIngredientAtStation(const std::string& station_name, const Ingredient& ingredient);
+    bool replenishStationIngredientFromBackup(const std::string& station_name, const std::string& ingredient_name, int quantity);
+    bool addBackupIngredient(const Ingredient& ingredient);
+    bool prepareNextDish();
+    void processAllDishes(EventSink& events, std::vector<bool>* results = nullptr);
+
+    /**
+     * Appends the kitchen's stateChecksum() to the trace. Calls recorded after it are still
+     * replayed; the replayer checks the last checksum in the trace.
+     * @return The checksum.
+     */
+    uint64_t finish();
+
+    /**
+     * @return The number of calls recorded, including those of the initial state.
+     */
+    size_t getCallCount() const;
+
+    /**
+     * @return The trace so far.
+     */
+    const std::vector<uint8_t>& getTrace() const;
+
+    /**
+     * Writes the trace to a file.
+     * @param path The file to write.
+     * @return True if the whole trace was written; false otherwise.
+     */
+    bool save(const std::string& path) const;
+
+private:
+    void recordStation(const KitchenStation& station);
+    uint32_t nameRef(const std::string& name);
+    uint32_t dishRef(const Dish* dish);
+    void writeOp(uint8_t op);
+    void writeUnsigned(uint64_t value);
+    void writeSigned(int64_t value);
+
+    StationManager& manager_;
+    std::vector<uint8_t> trace_;
+    std::unordered_map<std::string, uint32_t> names_;
+    std::unordered_map<const Dish*, uint32_t> dishes_;
+    size_t calls_;
+};
+
+class SessionReplayer {
+public:
+    /**
+     * Decodes a trace.
+     * @param trace The bytes written by a SessionRecorder.
+     * @return The replayer, or nullptr if the trace is malformed.
+     */
+    static SessionReplayer* fromTrace(const std::vector<uint8_t>& trace);
+
+    /**
+     * Reads and decodes a trace file.
+     * @param path The file written by SessionRecorder::save().
+     * @return The replayer, or nullptr if the file cannot be read or is malformed.
+     */
+    static SessionReplayer* load(const std::string& path);
+
+    /**
+     * Runs the calls on a fresh kitchen. May be called from several threads at once.
+     * @param events The sink for the events of processAllDishes(); not shared between threads.
+     * @return The stateChecksum() of the kitchen after the last call.
+     */
+    uint64_t replay(EventSink& events) const;
+
+    /**
+     * Runs the calls on `threads` fresh kitchens at once, one thread each, discarding the events.
+     * @param threads The number of concurrent replays (at least 1).
+     * @return The checksum of each replay.
+     */
+    std::vector<uint64_t> replayParallel(int threads) const;
+
+    /**
+     * @return The number of calls in the trace, including those of the initial state.
+     */
+    size_t getCallCount() const;
+
+    /**
+     * @return True if the trace ends with a checksum from SessionRecorder::finish().
+     */
+    bool hasExpectedChecksum() const;
+
+    /**
+     * @return The last checksum recorded in the trace, or 0 if there is none.
+     */
+    uint64_t getExpectedChecksum() const;
+
+private:
+    // One decoded call; the fields used depend on the op
+    struct Call {
+        uint8_t op;
+        uint32_t station;      // name index, or station index for ADD_STATION
+        uint32_t target;       // dish index, or ingredient name index
+        int quantity;
+        int required;
+        Money price;
+    };
+
+    struct DishDef {
+        uint8_t kind;
+        uint8_t cuisine;
+        uint32_t name;
+        int prep_time;
+        Money price;
+        std::vector<RecipeLine> recipe;   // ids index names_, not the registry
+    };
+
+    struct StationDef {
+        uint32_t name;
+        std::vector<StockLine> stock;     // ids index names_, not the registry
+    };
+
+    SessionReplayer();
+    bool decode(const std::vector<uint8_t>& trace);
+
+    std::vector<std::string> names_;
+    std::vector<DishDef> dishes_;
+    std::vector<StationDef> stations_;
+    std::vector<Call> calls_;
+    bool has_checksum_;
+    uint64_t checksum_;
+};
+
+#endif // SESSIONTRACE_HPP
@@ -0,0 +1,62 @@
+/**
+ * @file StaticMenu.cpp
+ * @brief This file contains the implementation of installStaticMenu().
+ */
+
+#include "StaticMenu.hpp"
+#include "StationManager.hpp"
+
+std::vector<KitchenStation*> installStaticMenu(const StaticMenuView& menu, StationManager& manager) {
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    std::vector<IngredientId> ids(menu.ingredient_count); // Each name interned once, not once per recipe line
+    for (size_t i = 0; i < menu.ingredient_count; ++i) {
+        ids[i] = registry.intern(menu.ingredients[i].name);
+    }
+
+    std::vector<KitchenStation*> stations;
+    stations.reserve(menu.station_count);
+    for (size_t i = 0; i < menu.station_count; ++i) {
+        KitchenStation* station = new KitchenStation(menu.stations[i]);
+        stations.push_back(station);
+        manager.addStation(station);
+    }
+
+    std::vector<RecipeLine> recipe;
+    for (size_t a = 0; a < menu.assignment_count; ++a) {
+        const StaticDish& entry = menu.dishes[menu.assignments[a].dish];
+        Dish* dish = nullptr;
+        if (entry.kind == StaticDish::MAIN_COURSE) {
+            MainCourse* main_course = new MainCourse();
+            main_course->setCookingMethod(static_cast<MainCourse::CookingMethod>(entry.style));
+            main_course->setProteinType(entry.protein);
+            main_course->setGlutenFree(entry.flag);
+            dish = main_course;
+        } else if (entry.kind == StaticDish::DESSERT) {
+            Dessert* dessert = new Dessert();
+            dessert->setFlavorProfile(static_cast<Dessert::FlavorProfile>(entry.style));
+            dessert->setSweetnessLevel(entry.level);
+            dessert->setContainsNuts(entry.flag);
+            dish = dessert;
+        } else {
+            Appetizer* appetizer = new Appetizer();
+            appetizer->setServingStyle(static_cast<Appetizer::ServingStyle>(entry.style));
+            appetizer->setSpicinessLevel(entry.level);
+            appetizer->setVegetarian(entry.flag);
+            dish = appetizer;
+        }
+        recipe.clear();
+        for (size_t i = entry.first_line; i < entry.first_line + entry.line_count; ++i) {
+            recipe.push_back(RecipeLine{ids[menu.lines[i].ingredient], menu.lines[i].required});
+        }
+        dish->setName(entry.name);
+        dish->setRecipeLines(recipe);
+        dish->setPrepTime(entry.prep_time);
+        dish->setPrice(Money::fromCents(entry.price_cents));
+        dish->setCuisineType(entry.cuisine);
+        KitchenStation* station = stations[menu.assignments[a].station];
+        if (!manager.assignDishToStation(station->getName(), dish)) {
+            delete dish; // The station already serves a dish of that name
+        }
+    }
+    return stations;
+}
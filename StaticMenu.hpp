@@ -0,0 +1,368 @@
+/**
+ * @file StaticMenu.hpp
+ * @brief This file contains the declaration of StaticMenu, a compile-time description of a fixed
+ * menu: its ingredients, stations, dishes, recipes and station assignments.
+ *
+ * A menu is written as one constexpr expression:
+ *
+ *     constexpr auto WINTER = StaticMenu<2, 1, 1, 2, 1>()
+ *         .ingredient("Chicken", 200)                    // name, unit price in cents
+ *         .ingredient("Spices", 50)
+ *         .station("Grill Station")
+ *         .dish("Grilled Chicken", StaticDish::MAIN_COURSE, Dish::AMERICAN, 15, 1099)
+ *             .mainCourse(MainCourse::GRILLED, "Chicken", false)   // course fields of the dish above
+ *             .uses("Chicken", 1).uses("Spices", 1)      // recipe of the dish above
+ *         .serve("Grill Station", "Grilled Chicken");
+ *
+ * The compiler resolves every name to an index into the menu's own tables, so a misspelt
+ * ingredient, a duplicate, an invalid dish name or a table that is too small stops the build
+ * rather than failing at startup. The tables are fixed-size arrays of plain records with static
+ * storage, read-only and contiguous, and building them costs nothing at run time. Queries such as
+ * findDish() and getRecipeCostCents() also work in constant expressions.
+ *
+ * A StationManager works on KitchenStation and Dish objects, so installStaticMenu()
+ * (StaticMenu.cpp) still creates those on the heap, one station per station and one dish per
+ * assignment; installing a menu allocates about as much as building the same kitchen by hand. It
+ * does so in one pass: each ingredient name is interned once and each recipe is copied as compact
+ * lines, with no Ingredient lists or name copies per line. The course fields (serving style,
+ * spiciness, gluten-free, ...) come from the appetizer(), mainCourse() and dessert() calls; side
+ * dishes are not part of a static menu.
+ */
+
+#ifndef STATICMENU_HPP
+#define STATICMENU_HPP
+
+#include "Appetizer.hpp"
+#include "Dessert.hpp"
+#include "Dish.hpp"
+#include "MainCourse.hpp"
+#include "PrecondViolatedExcep.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class KitchenStation;
+class StationManager;
+
+/**
+ * Struct representing an ingredient of a static menu.
+ */
+struct StaticIngredient {
+    const char* name;
+    int64_t price_cents;   // Unit price
+};
+
+/**
+ * Struct representing one recipe line of a static menu.
+ */
+struct StaticLine {
+    uint16_t ingredient;   // Index into the menu's ingredients
+    int16_t required;
+};
+
+/**
+ * Struct representing a dish of a static menu. Its recipe is lines [first_line, first_line + line_count).
+ * The course fields that do not apply to its kind are unused.
+ */
+struct StaticDish {
+    enum Kind : uint8_t { APPETIZER, MAIN_COURSE, DESSERT };
+
+    const char* name;
+    Kind kind;
+    Dish::CuisineType cuisine;
+    int prep_time;
+    int64_t price_cents;
+    uint16_t first_line;
+    uint16_t line_count;
+    int style;             // Appetizer::ServingStyle, MainCourse::CookingMethod or Dessert::FlavorProfile
+    int level;             // Spiciness of an appetizer, sweetness of a dessert
+    bool flag;             // Vegetarian appetizer, gluten-free main course, dessert with nuts
+    const char* protein;   // Protein type of a main course
+};
+
+/**
+ * Struct representing a station serving a dish.
+ */
+struct StaticAssignment {
+    uint16_t station;   // Index into the menu's stations
+    uint16_t dish;      // Index into the menu's dishes
+};
+
+/**
+ * The tables of any StaticMenu, without its capacities in the type.
+ */
+struct StaticMenuView {
+    const StaticIngredient* ingredients;
+    size_t ingredient_count;
+    const char* const* stations;
+    size_t station_count;
+    const StaticDish* dishes;
+    size_t dish_count;
+    const StaticLine* lines;
+    size_t line_count;
+    const StaticAssignment* assignments;
+    size_t assignment_count;
+};
+
+/**
+ * Compares two names in a constant expression.
+ */
+constexpr bool staticNameEquals(const char* a, const char* b) {
+    while (*a != '\0' && *a == *b) {
+        ++a;
+        ++b;
+    }
+    return *a == *b;
+}
+
+/**
+ * A menu of at most the given number of ingredients, stations, dishes, recipe lines and
+ * assignments. Each builder function returns a copy with one more entry.
+ */
+template <size_t MaxIngredients, size_t MaxStations, size_t MaxDishes, size_t MaxLines, size_t MaxAssignments>
+class StaticMenu {
+public:
+    static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+    constexpr StaticMenu()
+        : ingredients_(), stations_(), dishes_(), lines_(), assignments_(), ingredient_count_(0), station_count_(0),
+          dish_count_(0), line_count_(0), assignment_count_(0) {
+    }
+
+    /**
+     * @param name The ingredient's name.
+     * @param price_cents Its unit price, in cents.
+     */
+    constexpr StaticMenu ingredient(const char* name, int64_t price_cents) const {
+        if (ingredient_count_ == MaxIngredients) {
+            throw PrecondViolatedExcep("StaticMenu: too many ingredients");
+        }
+        if (findIngredient(name) != NOT_FOUND) {
+            throw PrecondViolatedExcep("StaticMenu: duplicate ingredient");
+        }
+        StaticMenu next = *this;
+        next.ingredients_[next.ingredient_count_++] = StaticIngredient{name, price_cents};
+        return next;
+    }
+
+    /**
+     * @param name The station's name. Stations are installed in this order.
+     */
+    constexpr StaticMenu station(const char* name) const {
+        if (station_count_ == MaxStations) {
+            throw PrecondViolatedExcep("StaticMenu: too many stations");
+        }
+        if (findStation(name) != NOT_FOUND) {
+            throw PrecondViolatedExcep("StaticMenu: duplicate station");
+        }
+        StaticMenu next = *this;
+        next.stations_[next.station_count_++] = name;
+        return next;
+    }
+
+    /**
+     * Starts a dish; the uses() calls that follow give its recipe, and one appetizer(),
+     * mainCourse() or dessert() call may give its course fields, which otherwise keep the
+     * defaults of the kind's default constructor.
+     * @param name The dish's name: letters and spaces only.
+     * @param kind Which Dish subclass to create.
+     * @param cuisine The cuisine type.
+     * @param prep_time The preparation time in minutes.
+     * @param price_cents The menu price, in cents.
+     */
+    constexpr StaticMenu dish(const char* name, StaticDish::Kind kind, Dish::CuisineType cuisine, int prep_time,
+                              int64_t price_cents) const {
+        if (dish_count_ == MaxDishes) {
+            throw PrecondViolatedExcep("StaticMenu: too many dishes");
+        }
+        if (findDish(name) != NOT_FOUND) {
+            throw PrecondViolatedExcep("StaticMenu: duplicate dish");
+        }
+        for (const char* c = name; *c != '\0'; ++c) {
+            bool letter = (*c >= 'A' && *c <= 'Z') || (*c >= 'a' && *c <= 'z');
+            if (!letter && *c != ' ') {
+                throw PrecondViolatedExcep("StaticMenu: dish names hold only letters and spaces");
+            }
+        }
+        StaticMenu next = *this;
+        next.dishes_[next.dish_count_++] =
+            StaticDish{name, kind, cuisine, prep_time, price_cents, static_cast<uint16_t>(line_count_), 0, 0, 0, false, "UNKNOWN"};
+        return next;
+    }
+
+    /**
+     * Sets the course fields of the last dish, which must be an APPETIZER.
+     */
+    constexpr StaticMenu appetizer(Appetizer::ServingStyle serving_style, int spiciness_level, bool vegetarian) const {
+        return course(StaticDish::APPETIZER, serving_style, spiciness_level, vegetarian, "UNKNOWN");
+    }
+
+    /**
+     * Sets the course fields of the last dish, which must be a MAIN_COURSE.
+     */
+    constexpr StaticMenu mainCourse(MainCourse::CookingMethod cooking_method, const char* protein_type, bool gluten_free) const {
+        return course(StaticDish::MAIN_COURSE, cooking_method, 0, gluten_free, protein_type);
+    }
+
+    /**
+     * Sets the course fields of the last dish, which must be a DESSERT.
+     */
+    constexpr StaticMenu dessert(Dessert::FlavorProfile flavor_profile, int sweetness_level, bool contains_nuts) const {
+        return course(StaticDish::DESSERT, flavor_profile, sweetness_level, contains_nuts, "UNKNOWN");
+    }
+
+    /**
+     * Adds a line to the recipe of the last dish.
+     * @param ingredient_name The name of an ingredient declared earlier.
+     * @param required The quantity the dish needs.
+     */
+    constexpr StaticMenu uses(const char* ingredient_name, int required) const {
+        if (dish_count_ == 0) {
+            throw PrecondViolatedExcep("StaticMenu: uses() before dish()");
+        }
+        if (line_count_ == MaxLines) {
+            throw PrecondViolatedExcep("StaticMenu: too many recipe lines");
+        }
+        size_t ingredient_index = findIngredient(ingredient_name);
+        if (ingredient_index == NOT_FOUND) {
+            throw PrecondViolatedExcep("StaticMenu: unknown ingredient");
+        }
+        const StaticDish& last = dishes_[dish_count_ - 1];
+        for (size_t i = last.first_line; i < line_count_; ++i) {
+            if (lines_[i].ingredient == ingredient_index) {
+                throw PrecondViolatedExcep("StaticMenu: ingredient used twice in a recipe");
+            }
+        }
+        if (required <= 0) {
+            throw PrecondViolatedExcep("StaticMenu: required quantity must be positive");
+        }
+        StaticMenu next = *this;
+        next.lines_[next.line_count_++] = StaticLine{static_cast<uint16_t>(ingredient_index), static_cast<int16_t>(required)};
+        ++next.dishes_[dish_count_ - 1].line_count;
+        return next;
+    }
+
+    /**
+     * Assigns a dish to a station.
+     * @param station_name The name of a station declared earlier.
+     * @param dish_name The name of a dish declared earlier.
+     */
+    constexpr StaticMenu serve(const char* station_name, const char* dish_name) const {
+        if (assignment_count_ == MaxAssignments) {
+            throw PrecondViolatedExcep("StaticMenu: too many assignments");
+        }
+        size_t station_index = findStation(station_name);
+        size_t dish_index = findDish(dish_name);
+        if (station_index == NOT_FOUND || dish_index == NOT_FOUND) {
+            throw PrecondViolatedExcep("StaticMenu: unknown station or dish");
+        }
+        for (size_t i = 0; i < assignment_count_; ++i) {
+            if (assignments_[i].station == station_index && assignments_[i].dish == dish_index) {
+                throw PrecondViolatedExcep("StaticMenu: duplicate assignment");
+            }
+        }
+        StaticMenu next = *this;
+        next.assignments_[next.assignment_count_++] =
+            StaticAssignment{static_cast<uint16_t>(station_index), static_cast<uint16_t>(dish_index)};
+        return next;
+    }
+
+    /**
+     * @return The index of the ingredient, station or dish with the name, or NOT_FOUND.
+     */
+    constexpr size_t findIngredient(const char* name) const {
+        for (size_t i = 0; i < ingredient_count_; ++i) {
+            if (staticNameEquals(ingredients_[i].name, name)) {
+                return i;
+            }
+        }
+        return NOT_FOUND;
+    }
+
+    constexpr size_t findStation(const char* name) const {
+        for (size_t i = 0; i < station_count_; ++i) {
+            if (staticNameEquals(stations_[i], name)) {
+                return i;
+            }
+        }
+        return NOT_FOUND;
+    }
+
+    constexpr size_t findDish(const char* name) const {
+        for (size_t i = 0; i < dish_count_; ++i) {
+            if (staticNameEquals(dishes_[i].name, name)) {
+                return i;
+            }
+        }
+        return NOT_FOUND;
+    }
+
+    /**
+     * @param dish_name The name of a dish.
+     * @return The cost of one serving at the ingredients' unit prices, in cents.
+     */
+    constexpr int64_t getRecipeCostCents(const char* dish_name) const {
+        size_t dish_index = findDish(dish_name);
+        if (dish_index == NOT_FOUND) {
+            throw PrecondViolatedExcep("StaticMenu: unknown dish");
+        }
+        const StaticDish& found = dishes_[dish_index];
+        int64_t cost = 0;
+        for (size_t i = found.first_line; i < found.first_line + found.line_count; ++i) {
+            cost += ingredients_[lines_[i].ingredient].price_cents * lines_[i].required;
+        }
+        return cost;
+    }
+
+    constexpr size_t getIngredientCount() const { return ingredient_count_; }
+    constexpr size_t getStationCount() const { return station_count_; }
+    constexpr size_t getDishCount() const { return dish_count_; }
+    constexpr size_t getLineCount() const { return line_count_; }
+    constexpr size_t getAssignmentCount() const { return assignment_count_; }
+
+    /**
+     * @return The tables; valid as long as this menu is.
+     */
+    constexpr StaticMenuView view() const {
+        return StaticMenuView{ingredients_.data(), ingredient_count_, stations_.data(), station_count_,
+                              dishes_.data(),      dish_count_,       lines_.data(),    line_count_,
+                              assignments_.data(), assignment_count_};
+    }
+
+private:
+    constexpr StaticMenu course(StaticDish::Kind kind, int style, int level, bool flag, const char* protein) const {
+        if (dish_count_ == 0 || dishes_[dish_count_ - 1].kind != kind) {
+            throw PrecondViolatedExcep("StaticMenu: course fields do not match the last dish's kind");
+        }
+        StaticMenu next = *this;
+        StaticDish& last = next.dishes_[dish_count_ - 1];
+        last.style = style;
+        last.level = level;
+        last.flag = flag;
+        last.protein = protein;
+        return next;
+    }
+
+    std::array<StaticIngredient, MaxIngredients> ingredients_;
+    std::array<const char*, MaxStations> stations_;
+    std::array<StaticDish, MaxDishes> dishes_;
+    std::array<StaticLine, MaxLines> lines_;
+    std::array<StaticAssignment, MaxAssignments> assignments_;
+    size_t ingredient_count_;
+    size_t station_count_;
+    size_t dish_count_;
+    size_t line_count_;
+    size_t assignment_count_;
+};
+
+/**
+ * Creates a menu's stations in order, adds them to a manager and assigns each station its dishes
+ * (one Dish object per assignment, since a station owns its dishes).
+ * @param menu The menu's tables.
+ * @param manager The kitchen; it should not already have stations of the same names.
+ * @return The stations created, which the caller deletes after the manager is done with them.
+ */
+std::vector<KitchenStation*> installStaticMenu(const StaticMenuView& menu, StationManager& manager);
+
+#endif // STATICMENU_HPP
@@ -11,23 +11,37 @@
 */
 
 #include "StationManager.hpp"
+#include "MainCourse.hpp"
 #include <iostream>
+#include <chrono>
+#include <cmath>
 
 // Default Constructor
-StationManager::StationManager() {
+StationManager::StationManager()
+    : backup_supplier_(nullptr), queue_capacity_(0), admission_counts_(), sub_recipe_version_(0), batch_runs_(0), substituted_dishes_(0), profiler_(nullptr) {
     // Initializes an empty station manager
 }
 
 
 // Adds a new station to the station manager
 bool StationManager::addStation(KitchenStation* station) {
-    return insert(item_count_, station);
+    if (station == nullptr || !insert(item_count_, station)) {
+        return false;
+    }
+    accountStation(*station, 1);
+    station->setObserver(this);
+    return true;
 }
 
 // Removes a station from the station manager by name
 bool StationManager::removeStation(const std::string& station_name) {
     for (int i = 0; i < item_count_; ++i) {
-        if (getEntry(i)->getName() == station_name) {
+        KitchenStation* station = getEntry(i);
+        if (station->getName() == station_name) {
+            accountStation(*station, -1);
+            stock_history_.forget(station);
+            demand_forecast_.forget(station);
+            station->setObserver(nullptr);
             return remove(i);
         }
     }
@@ -145,11 +159,47 @@ bool StationManager::canCompleteOrder(const std::string& dish_name) const {
     return false;
 }
 
+// Collects every assigned dish, once per name, in station order
+std::vector<Dish*> StationManager::getMenu() const {
+    std::vector<Dish*> menu;
+    Node<KitchenStation*>* searchptr = getHeadNode();
+    while (searchptr != nullptr) {
+        for (Dish* dish : searchptr->getItem()->getDishes()) {
+            bool listed = false;
+            for (Dish* menu_dish : menu) {
+                if (menu_dish->getName() == dish->getName()) {
+                    listed = true;
+                    break;
+                }
+            }
+            if (!listed) {
+                menu.push_back(dish);
+            }
+        }
+        searchptr = searchptr->getNext();
+    }
+    return menu;
+}
+
 // Prepares a dish at a specific station if possible
 bool StationManager::prepareDishAtStation(const std::string& station_name, const std::string& dish_name) {
     KitchenStation* station = findStation(station_name);
-    if (station && station->canCompleteOrder(dish_name)) {
-        return station->prepareDish(dish_name);
+    if (station == nullptr) {
+        return false;
+    }
+    std::vector<Ingredient> resolved; // The recipe with sub-recipes, when the dish uses any
+    bool nested = resolveSubRecipes(*station, dish_name, nullptr, resolved);
+    if (nested ? station->canCompleteRecipe(resolved) : station->canCompleteOrder(dish_name)) {
+        Money cost_before = cost_of_goods_;
+        if (nested ? station->prepareRecipe(resolved) : station->prepareDish(dish_name)) {
+            for (Dish* dish : station->getDishes()) {
+                if (dish->getName() == dish_name) {
+                    recordSale(dish_name, dish->getPriceMoney(), cost_before);
+                    break;
+                }
+            }
+            return true;
+        }
     }
     return false;
 }
@@ -178,10 +228,749 @@ the end of the queue.
 void StationManager::addDishToQueue(Dish* dish, const Dish::DietaryRequest& request) {
     if (dish != nullptr) { // Check if dish pointer is valid
         dish->dietaryAccommodations(request); // Adjust dish for dietary accommodations
+        ingredient_index_.reindexDish(*dish); // The recipe may have changed at the stations serving this dish
         dish_queue_.push(dish); // Add dish to the queue
     }
 }
 
+/**
+* Adds a dish to the preparation queue if the kitchen can take it.
+* @param dish A pointer to a dynamically allocated Dish object.
+* @return: ADMITTED, or the reason the dish was turned away.
+*/
+StationManager::AdmissionResult StationManager::tryAddDishToQueue(Dish* dish) {
+    AdmissionResult result = admit(dish);
+    ++admission_counts_[result];
+    if (result == ADMITTED) {
+        dish_queue_.push(dish);
+    }
+    return result;
+}
+
+/**
+* Adjusts a dish for dietary accommodations and adds it to the preparation
+queue if the kitchen can take it.
+* @param dish A pointer to a dynamically allocated Dish object.
+* @param request A DietaryRequest object specifying dietary accommodations.
+* @post: Admission is checked against an adjusted copy; the dish itself is
+adjusted and queued only if the result is ADMITTED.
+* @return: ADMITTED, or the reason the dish was turned away.
+*/
+StationManager::AdmissionResult StationManager::tryAddDishToQueue(Dish* dish, const Dish::DietaryRequest& request) {
+    if (dish == nullptr) {
+        return tryAddDishToQueue(dish);
+    }
+    std::unique_ptr<Dish> adjusted(dish->clone()); // Checked as it will be prepared, leaving the dish alone until admitted
+    if (adjusted) {
+        adjusted->dietaryAccommodations(request);
+    }
+    AdmissionResult result = admit(adjusted ? adjusted.get() : dish); // A dish that cannot be copied is checked as it is
+    ++admission_counts_[result];
+    if (result == ADMITTED) {
+        dish->dietaryAccommodations(request);
+        ingredient_index_.reindexDish(*dish); // The recipe may have changed at the stations serving this dish
+        dish_queue_.push(dish);
+    }
+    return result;
+}
+
+// Decides whether a dish may join the queue using only the precomputed counters
+StationManager::AdmissionResult StationManager::admit(Dish* dish) {
+    if (dish == nullptr) {
+        return INVALID_DISH;
+    }
+    if (queue_capacity_ != 0 && dish_queue_.size() >= queue_capacity_) {
+        return QUEUE_FULL;
+    }
+    std::shared_ptr<const MenuSnapshot> menu = std::atomic_load(&menu_snapshot_);
+    const std::vector<MenuSnapshot::DistinctRecipe>* recipes = menu ? menu->findDistinctRecipes(dish->getName()) : nullptr;
+    bool served = menu ? recipes != nullptr : served_stations_.find(dish->getName()) != served_stations_.end();
+    if (!served) {
+        return NOT_SERVED;
+    }
+    if (backup_supplier_ == nullptr) {
+        refreshSubRecipeLines();
+        if (recipes != nullptr) {
+            // The published recipes, which a reload may have changed from the dish's own; any one will do
+            for (const MenuSnapshot::DistinctRecipe& recipe : *recipes) {
+                if (inTotalStock(recipe.lines)) {
+                    return ADMITTED;
+                }
+            }
+            return OUT_OF_STOCK;
+        }
+        return inTotalStock(dish->getRecipeLines()) ? ADMITTED : OUT_OF_STOCK;
+    }
+    return ADMITTED;
+}
+
+// Checks a recipe against the stations' plus backup quantities. A sub-recipe line that the units
+// already made do not cover counts the raw ingredients of the batches that would make up the rest.
+bool StationManager::inTotalStock(const std::vector<RecipeLine>& recipe) const {
+    auto held = [this](IngredientId id) {
+        auto found = total_stock_.find(id);
+        return found == total_stock_.end() ? 0L : found->second;
+    };
+    bool batches_needed = false;
+    for (const RecipeLine& line : recipe) {
+        if (held(line.id) < line.required) {
+            if (sub_recipe_lines_.find(line.id) == sub_recipe_lines_.end()) {
+                return false;
+            }
+            batches_needed = true;
+        }
+    }
+    if (!batches_needed) {
+        return true;
+    }
+
+    std::unordered_map<IngredientId, long> needs; // raw ingredient -> units taken by the recipe and its batches
+    for (const RecipeLine& line : recipe) {
+        auto sub_recipe = sub_recipe_lines_.find(line.id);
+        if (sub_recipe == sub_recipe_lines_.end()) {
+            needs[line.id] += line.required;
+            continue;
+        }
+        long shortfall = line.required - held(line.id);
+        if (shortfall > 0) {
+            long batches = (shortfall + sub_recipe->second.yield - 1) / sub_recipe->second.yield;
+            for (const RecipeLine& raw : sub_recipe->second.raw) {
+                needs[raw.id] += raw.required * batches;
+            }
+        }
+    }
+    for (const auto& need : needs) {
+        if (held(need.first) < need.second) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Interns the recipe book's raw expansions again after the book changed
+void StationManager::refreshSubRecipeLines() {
+    if (sub_recipe_version_ == recipe_book_.getVersion()) {
+        return;
+    }
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    sub_recipe_lines_.clear();
+    for (const std::string& name : recipe_book_.getTopologicalOrder()) {
+        SubRecipeLines& lines = sub_recipe_lines_[registry.intern(name)];
+        lines.yield = recipe_book_.getYield(name);
+        for (const Ingredient& ingredient : recipe_book_.getRawIngredients(name)) {
+            lines.raw.push_back(toRecipeLine(ingredient));
+        }
+    }
+    sub_recipe_version_ = recipe_book_.getVersion();
+}
+
+/**
+* Sets the most dishes tryAddDishToQueue() lets wait in the queue.
+* @param capacity The queue bound, or 0 for no bound.
+*/
+void StationManager::setQueueCapacity(size_t capacity) {
+    queue_capacity_ = capacity;
+}
+
+/**
+* @return The queue bound, or 0 if there is none.
+*/
+size_t StationManager::getQueueCapacity() const {
+    return queue_capacity_;
+}
+
+/**
+* @param reason An admission result.
+* @return The number of tryAddDishToQueue() calls that returned that result.
+*/
+unsigned long StationManager::getAdmissionCount(AdmissionResult reason) const {
+    if (reason < ADMITTED || reason > INVALID_DISH) {
+        return 0;
+    }
+    return admission_counts_[reason];
+}
+
+/**
+* @param ingredient_name A string representing the name of an ingredient.
+* @return The total quantity of the ingredient held by all stations plus the backup stock.
+*/
+long StationManager::getTotalStock(const std::string& ingredient_name) const {
+    IngredientId id;
+    if (!IngredientRegistry::instance().find(ingredient_name, id)) {
+        return 0;
+    }
+    auto found = total_stock_.find(id);
+    return found == total_stock_.end() ? 0 : found->second;
+}
+
+/**
+* @param prefix The typed prefix; case is ignored.
+* @param limit The maximum number of matches to return.
+* @return Up to `limit` assigned dishes whose names start with the prefix, with their stations.
+*/
+std::vector<DishNameIndex::Match> StationManager::autocompleteDish(const std::string& prefix, size_t limit) const {
+    return dish_names_.complete(prefix, limit);
+}
+
+/**
+* @return The order and failure statistics fed by processAllDishes().
+*/
+const DishStats& StationManager::getDishStats() const {
+    return dish_stats_;
+}
+
+void StationManager::setClock(std::function<int64_t()> clock_ms) {
+    clock_ms_ = clock_ms;
+}
+
+int64_t StationManager::getTimeMs() const {
+    if (clock_ms_) {
+        return clock_ms_();
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+const StockHistory& StationManager::getStockHistory() const {
+    return stock_history_;
+}
+
+/**
+* @param station_name The name of a station.
+* @param ingredient_name The name of an ingredient.
+* @param window_seconds The length of the window ending now.
+* @return The station's average use of the ingredient per second over the window.
+*/
+double StationManager::getConsumptionRate(const std::string& station_name, const std::string& ingredient_name, int window_seconds) const {
+    KitchenStation* station = findStation(station_name);
+    IngredientId id;
+    if (station == nullptr || !IngredientRegistry::instance().find(ingredient_name, id)) {
+        return 0.0;
+    }
+    return stock_history_.getConsumptionRate(station, id, window_seconds, getTimeMs());
+}
+
+/**
+* @param station_name The name of a station.
+* @param ingredient_name The name of an ingredient.
+* @param window_seconds The length of the window the rate is measured over.
+* @return The projected seconds until the station runs out, 0 if it holds none, or -1 if it is not using the ingredient.
+*/
+double StationManager::getTimeToStockout(const std::string& station_name, const std::string& ingredient_name, int window_seconds) const {
+    KitchenStation* station = findStation(station_name);
+    if (station == nullptr) {
+        return -1.0;
+    }
+    long quantity = station->getStockQuantity(ingredient_name);
+    if (quantity <= 0) {
+        return 0.0;
+    }
+    double rate = getConsumptionRate(station_name, ingredient_name, window_seconds);
+    return rate > 0.0 ? quantity / rate : -1.0;
+}
+
+/**
+* @return The value of all stations' stock plus the backup stock, in cents.
+*/
+long StationManager::getInventoryValueCents() const {
+    return static_cast<long>((stations_value_ + backup_value_).getCents());
+}
+
+/**
+* @return The value of the backup stock, in cents.
+*/
+long StationManager::getBackupValueCents() const {
+    return static_cast<long>(backup_value_.getCents());
+}
+
+/**
+* @param station_name The name of a station.
+* @return The value of the station's stock in cents, or 0 if the station does not exist.
+*/
+long StationManager::getStationValueCents(const std::string& station_name) const {
+    KitchenStation* station = findStation(station_name);
+    return station == nullptr ? 0 : station->getInventoryValueCents();
+}
+
+/**
+* @return The value of the ingredients used by every dish prepared so far, in cents.
+*/
+long StationManager::getCostOfGoodsCents() const {
+    return static_cast<long>(cost_of_goods_.getCents());
+}
+
+/**
+* @param dish_name The name of a dish.
+* @return The value of the ingredients used by every preparation of the dish, in cents.
+*/
+long StationManager::getCostOfGoodsCents(const std::string& dish_name) const {
+    auto found = dish_sales_.find(dish_name);
+    return found == dish_sales_.end() ? 0 : static_cast<long>(found->second.cost.getCents());
+}
+
+/**
+* @return The menu price of every dish prepared so far, in cents.
+*/
+long StationManager::getRevenueCents() const {
+    return static_cast<long>(revenue_.getCents());
+}
+
+/**
+* @param dish_name The name of a dish.
+* @return The menu price of every preparation of the dish, in cents.
+*/
+long StationManager::getRevenueCents(const std::string& dish_name) const {
+    auto found = dish_sales_.find(dish_name);
+    return found == dish_sales_.end() ? 0 : static_cast<long>(found->second.revenue.getCents());
+}
+
+// Books the outcome of one dispatched dish: its result, its statistics and, if prepared, its sale
+void StationManager::bookDish(Dish* dish, bool prepared, Money cost_before, std::vector<bool>* results) {
+    if (results != nullptr) {
+        results->push_back(prepared);
+    }
+    dish_stats_.record(dish->getName(), prepared);
+    if (prepared) {
+        demand_forecast_.recordDish(dish->getName(), getTimeMs());
+        recordSale(dish->getName(), dish->getPriceMoney(), cost_before);
+    }
+}
+
+// Books a prepared dish: its price, and the ingredients deducted since cost_before
+void StationManager::recordSale(const std::string& dish_name, Money price, Money cost_before) {
+    DishSales& sales = dish_sales_[dish_name];
+    sales.revenue += price;
+    sales.cost += cost_of_goods_ - cost_before;
+    revenue_ += price;
+}
+
+/**
+* @return The sub-recipes that dish recipes and side dishes may refer to.
+*/
+RecipeBook& StationManager::getRecipeBook() {
+    return recipe_book_;
+}
+
+/**
+* @return The recipe book.
+*/
+const RecipeBook& StationManager::getRecipeBook() const {
+    return recipe_book_;
+}
+
+/**
+* Prepares batches of a sub-recipe at a station from raw ingredients.
+* @param station_name The name of the station.
+* @param recipe_name The name of a sub-recipe in the recipe book.
+* @param batches The number of batches.
+* @return True if the batches were prepared and stocked at the station; false otherwise.
+*/
+bool StationManager::prepareBatch(const std::string& station_name, const std::string& recipe_name, int batches) {
+    KitchenStation* station = findStation(station_name);
+    return station != nullptr && prepareBatchAt(*station, recipe_name, batches);
+}
+
+// Makes batches of a sub-recipe from the station's raw stock, and stocks the result at its raw cost
+bool StationManager::prepareBatchAt(KitchenStation& station, const std::string& recipe_name, int batches) {
+    int yield = recipe_book_.getYield(recipe_name);
+    if (yield == 0 || batches < 1) {
+        return false;
+    }
+    std::vector<Ingredient> raw = recipe_book_.getRawIngredients(recipe_name);
+    for (Ingredient& ingredient : raw) {
+        ingredient.required_quantity *= batches;
+    }
+    Money cost_before = cost_of_goods_;
+    if (!station.prepareRecipe(raw)) {
+        return false;
+    }
+    int units = yield * batches;
+    Money unit_cost = (cost_of_goods_ - cost_before) / units;
+    cost_of_goods_ -= unit_cost * units; // Charged to the dishes that use the batch instead; only the rounding stays
+    station.replenishStationIngredients(Ingredient(recipe_name, units, 0, unit_cost));
+    ++batch_runs_;
+    return true;
+}
+
+/**
+* @return The number of batch runs so far.
+*/
+unsigned long StationManager::getBatchRunCount() const {
+    return batch_runs_;
+}
+
+/**
+* Plans the sub-recipe batches each station should prepare ahead of the
+* queued and forecast orders.
+* @param minutes The length of the projection.
+* @return One entry per (station, sub-recipe) that falls short, in station order.
+*/
+std::vector<BatchPlan> StationManager::planMiseEnPlace(int minutes) const {
+    std::vector<BatchPlan> plan;
+    if (recipe_book_.empty()) {
+        return plan;
+    }
+    std::unordered_map<std::string, double> expected_orders; // dish name -> queued plus forecast orders
+    for (size_t i = 0; i < dish_queue_.size(); ++i) {
+        expected_orders[dish_queue_.at(i)->getName()] += 1.0;
+    }
+    int64_t now_ms = getTimeMs();
+    for (const auto& served : served_stations_) {
+        expected_orders[served.first] += demand_forecast_.getDishRate(served.first, now_ms) * minutes * 60.0;
+    }
+
+    std::unordered_map<std::string, bool> claimed; // dishes already expected at an earlier station
+    for (Node<KitchenStation*>* node = getHeadNode(); node != nullptr; node = node->getNext()) {
+        const KitchenStation* station = node->getItem();
+        std::map<std::string, double> units; // sub-recipe -> expected units, in name order
+        for (const Dish* dish : station->getDishes()) {
+            auto expected = expected_orders.find(dish->getName());
+            if (expected == expected_orders.end() || expected->second <= 0.0 || claimed[dish->getName()]) {
+                continue;
+            }
+            claimed[dish->getName()] = true;
+            for (const Ingredient& component : dish->getIngredients()) {
+                if (recipe_book_.contains(component.name)) {
+                    units[component.name] += expected->second * component.required_quantity;
+                }
+            }
+            const MainCourse* main_course = dynamic_cast<const MainCourse*>(dish);
+            if (main_course != nullptr) {
+                for (const MainCourse::SideDish& side_dish : main_course->getSideDishes()) {
+                    if (recipe_book_.contains(side_dish.name)) {
+                        units[side_dish.name] += expected->second;
+                    }
+                }
+            }
+        }
+
+        for (const auto& need : units) {
+            int on_hand = station->getStockQuantity(need.first);
+            int shortfall = static_cast<int>(std::ceil(need.second)) - on_hand;
+            if (shortfall > 0) {
+                int yield = recipe_book_.getYield(need.first);
+                plan.push_back(BatchPlan{station, need.first, (shortfall + yield - 1) / yield, need.second, on_hand});
+            }
+        }
+    }
+    return plan;
+}
+
+/**
+* Prepares the planned batches and stocks them at the stations.
+* @param minutes The length of the projection.
+* @return The number of batches prepared.
+*/
+int StationManager::runMiseEnPlace(int minutes) {
+    int prepared = 0;
+    for (const BatchPlan& batch : planMiseEnPlace(minutes)) {
+        if (prepareBatch(batch.station->getName(), batch.recipe_name, batch.batches)) {
+            prepared += batch.batches;
+        }
+    }
+    return prepared;
+}
+
+// With sub-recipes in the book, builds the recipe a station prepares for a dish: its components
+// plus its side dishes that are sub-recipes. Sub-recipe shortfalls are batch-prepared first, if
+// the station's raw stock covers the whole dish. Returns false when no sub-recipe is involved.
+bool StationManager::resolveSubRecipes(KitchenStation& station, const std::string& dish_name, const std::vector<Ingredient>* recipe, std::vector<Ingredient>& resolved) {
+    if (recipe_book_.empty()) {
+        return false;
+    }
+    const Dish* assigned = nullptr;
+    for (Dish* dish : station.getDishes()) {
+        if (dish->getName() == dish_name) {
+            assigned = dish;
+            break;
+        }
+    }
+    if (recipe == nullptr && assigned == nullptr) {
+        return false;
+    }
+    resolved = recipe != nullptr ? *recipe : assigned->getIngredients();
+    const MainCourse* main_course = dynamic_cast<const MainCourse*>(assigned);
+    if (main_course != nullptr) {
+        for (const MainCourse::SideDish& side_dish : main_course->getSideDishes()) {
+            if (recipe_book_.contains(side_dish.name)) {
+                resolved.push_back(Ingredient(side_dish.name, 0, 1, Money()));
+            }
+        }
+    }
+
+    std::vector<Ingredient> needs;
+    std::vector<std::pair<std::string, int>> batches;
+    if (!planSubRecipeBatches(station, resolved, needs, batches)) {
+        return false;
+    }
+    if (!batches.empty() && station.canCompleteRecipe(recipe_book_.expand(needs))) {
+        for (const auto& batch : batches) {
+            prepareBatchAt(station, batch.first, batch.second);
+        }
+    }
+    return true;
+}
+
+// Lists the sub-recipe batches a station is short of for a resolved recipe, and what they and the
+// raw components need before expansion. Returns false when no component is a sub-recipe.
+bool StationManager::planSubRecipeBatches(const KitchenStation& station, const std::vector<Ingredient>& resolved, std::vector<Ingredient>& needs, std::vector<std::pair<std::string, int>>& batches) const {
+    bool nested = false;
+    for (const Ingredient& component : resolved) {
+        int yield = recipe_book_.getYield(component.name);
+        if (yield == 0) {
+            needs.push_back(component);
+            continue;
+        }
+        nested = true;
+        int shortfall = component.required_quantity - station.getStockQuantity(component.name);
+        if (shortfall > 0) {
+            int count = (shortfall + yield - 1) / yield;
+            batches.push_back({component.name, count});
+            needs.push_back(Ingredient(component.name, 0, count * yield, Money()));
+        }
+    }
+    return nested;
+}
+
+// Tops a station up from the backup for a resolved recipe: the raw ingredients of the batches it is
+// short of and of its raw components, then makes the batches. What was moved before a shortfall stays.
+bool StationManager::replenishSubRecipes(KitchenStation& station, const std::vector<Ingredient>& resolved) {
+    std::vector<Ingredient> needs;
+    std::vector<std::pair<std::string, int>> batches;
+    planSubRecipeBatches(station, resolved, needs, batches);
+    for (const Ingredient& ingredient : recipe_book_.expand(needs)) {
+        int replenish_quantity = ingredient.required_quantity - station.getStockQuantity(ingredient.name);
+        if (replenish_quantity > 0 && !replenishStationIngredientFromBackup(station.getName(), ingredient.name, replenish_quantity)) {
+            return false;
+        }
+    }
+    for (const auto& batch : batches) {
+        if (!prepareBatchAt(station, batch.first, batch.second)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+* @return The ingredient substitutions processAllDishes() may use.
+*/
+SubstitutionGraph& StationManager::getSubstitutionGraph() {
+    return substitutions_;
+}
+
+/**
+* @return The substitution graph.
+*/
+const SubstitutionGraph& StationManager::getSubstitutionGraph() const {
+    return substitutions_;
+}
+
+/**
+* @return The number of dishes prepared with at least one substitute.
+*/
+unsigned long StationManager::getSubstitutedDishCount() const {
+    return substituted_dishes_;
+}
+
+/**
+* Turns the profiling mode on, or off with nullptr.
+* @param profiler A profiler created on the dispatch thread, or nullptr.
+*/
+void StationManager::setProfiler(PhaseProfiler* profiler) {
+    profiler_ = profiler;
+}
+
+/**
+* @return The profiler, or nullptr when profiling is off.
+*/
+PhaseProfiler* StationManager::getProfiler() const {
+    return profiler_;
+}
+
+// Prepares a recipe with the cheapest substitutes the station's stock plus the backup stock cover,
+// topping the station up from the backup first. Logs each substitution.
+bool StationManager::prepareWithSubstitutes(KitchenStation& station, const std::vector<Ingredient>& recipe, EventSink& events) {
+    if (substitutions_.empty()) {
+        return false;
+    }
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    std::unordered_map<IngredientId, int> available;
+    for (const StockLine& line : station.getStockLines()) {
+        available[line.id] += line.quantity;
+    }
+    for (const StockLine& line : backup_ingredients_.getLines()) {
+        available[line.id] += line.quantity;
+    }
+
+    std::vector<Ingredient> substituted;
+    std::vector<SubstitutionGraph::Substitution> made;
+    if (!substitutions_.resolve(recipe, available, substituted, made) || made.empty()) {
+        return false;
+    }
+    for (const Ingredient& ingredient : substituted) {
+        int replenish_quantity = ingredient.required_quantity - station.getStockQuantity(ingredient.name);
+        if (replenish_quantity > 0 && !replenishStationIngredientFromBackup(station.getName(), ingredient.name, replenish_quantity)) {
+            return false;
+        }
+    }
+    if (!station.prepareRecipe(substituted)) {
+        return false;
+    }
+    for (const SubstitutionGraph::Substitution& substitution : made) {
+        events.record(KitchenEvent{KitchenEvent::SUBSTITUTED, registry.intern(substitution.original),
+                                   registry.intern(substitution.substitute), &station, nullptr});
+    }
+    ++substituted_dishes_;
+    return true;
+}
+
+/**
+* Reports the memory used by the manager and everything it owns.
+* @return The breakdown, in bytes.
+*/
+MemoryUsage StationManager::memoryUsage() const {
+    MemoryUsage usage;
+    usage.objects = sizeof(StationManager);
+    usage.nodes = LinkedList<KitchenStation*>::memoryUsage().nodes;
+    for (Node<KitchenStation*>* node = getHeadNode(); node != nullptr; node = node->getNext()) {
+        usage += node->getItem()->memoryUsage();
+    }
+    usage.queue = dish_queue_.capacity() * sizeof(Dish*);
+    usage.pantry = backup_ingredients_.getHeapBytes(); // Names live in the IngredientRegistry
+    usage.indexes = hashBytes(served_stations_) + hashBytes(total_stock_) + hashBytes(dish_sales_);
+    for (const auto& served : served_stations_) {
+        usage.indexes += heapBytes(served.first);
+    }
+    for (const auto& sales : dish_sales_) {
+        usage.indexes += heapBytes(sales.first);
+    }
+    usage.indexes += dish_names_.memoryUsage() + ingredient_index_.memoryUsage() + dish_stats_.memoryUsage()
+        + stock_history_.memoryUsage() + demand_forecast_.memoryUsage() + recipe_book_.memoryUsage()
+        + substitutions_.memoryUsage();
+    return usage;
+}
+
+const DemandForecast& StationManager::getDemandForecast() const {
+    return demand_forecast_;
+}
+
+void StationManager::setDemandHalfLife(double half_life_seconds) {
+    demand_forecast_.setHalfLife(half_life_seconds);
+}
+
+/**
+* @param minutes The length of the projection.
+* @return Each station's projected use of each ingredient, with its current stock.
+*/
+std::vector<IngredientNeed> StationManager::projectIngredientNeeds(int minutes) const {
+    std::vector<IngredientNeed> needs = demand_forecast_.project(minutes * 60.0, getTimeMs());
+    for (IngredientNeed& need : needs) {
+        need.on_hand = need.station->getStockQuantity(need.ingredient_name);
+    }
+    return needs;
+}
+
+/**
+* Moves backup stock to the stations projected to run short.
+* @param minutes The length of the projection.
+* @return The number of units moved.
+*/
+int StationManager::prestockFromBackup(int minutes) {
+    int moved = 0;
+    for (const IngredientNeed& need : projectIngredientNeeds(minutes)) {
+        int shortfall = static_cast<int>(std::ceil(need.units)) - need.on_hand;
+        if (shortfall > 0 && replenishStationIngredientFromBackup(need.station->getName(), need.ingredient_name, shortfall)) {
+            moved += shortfall;
+        }
+    }
+    return moved;
+}
+
+/**
+* @param ingredient_name The name of an ingredient.
+* @return Every (station, dish) pair whose recipe uses the ingredient.
+*/
+std::vector<IngredientIndex::Use> StationManager::getDishesUsing(const std::string& ingredient_name) const {
+    IngredientId id;
+    if (!IngredientRegistry::instance().find(ingredient_name, id)) {
+        return {};
+    }
+    return ingredient_index_.getUses(id);
+}
+
+/**
+* @param dish_name The name of a dish.
+* @return True if some station serves the dish but none holds all of its ingredients.
+*/
+bool StationManager::isEightySixed(const std::string& dish_name) const {
+    return ingredient_index_.isEightySixed(dish_name);
+}
+
+/**
+* @return The names of all 86'd dishes.
+*/
+std::vector<std::string> StationManager::getEightySixedDishes() const {
+    return ingredient_index_.getEightySixed();
+}
+
+// Counts a dish newly assigned to one of this manager's stations
+void StationManager::onDishAssigned(const KitchenStation& station, const Dish& dish) {
+    ++served_stations_[dish.getName()];
+    dish_names_.add(dish.getName(), &station);
+    ingredient_index_.addDish(station, dish);
+}
+
+// Follows a stock change at one of this manager's stations
+void StationManager::onStockChanged(const KitchenStation& station, IngredientId id, int delta, long value_delta_cents) {
+    Money value_delta = Money::fromCents(value_delta_cents);
+    adjustTotalStock(id, delta);
+    stations_value_ += value_delta;
+    int64_t now_ms = getTimeMs();
+    stock_history_.record(&station, id, delta, now_ms);
+    if (delta < 0) { // Only preparing a dish deducts stock
+        demand_forecast_.recordIngredient(&station, id, -delta, now_ms);
+        cost_of_goods_ -= value_delta;
+    }
+}
+
+// Marks the dishes that use an ingredient at a station as (un)available
+void StationManager::onStockAvailability(const KitchenStation& station, IngredientId id, bool in_stock) {
+    ingredient_index_.setInStock(station, id, in_stock);
+}
+
+// Adds (sign 1) or removes (sign -1) a station's dishes and stock from the counters
+void StationManager::accountStation(const KitchenStation& station, int sign) {
+    for (Dish* dish : station.getDishes()) {
+        int& count = served_stations_[dish->getName()];
+        count += sign;
+        if (count <= 0) {
+            served_stations_.erase(dish->getName());
+        }
+        if (sign > 0) {
+            dish_names_.add(dish->getName(), &station);
+            ingredient_index_.addDish(station, *dish);
+        } else {
+            dish_names_.remove(dish->getName(), &station);
+            ingredient_index_.removeDish(station, *dish);
+        }
+    }
+    for (const StockLine& line : station.getStockLines()) {
+        adjustTotalStock(line.id, sign * static_cast<long>(line.quantity));
+    }
+    stations_value_ += Money::fromCents(station.getInventoryValueCents()) * sign;
+}
+
+void StationManager::adjustTotalStock(const std::string& ingredient_name, long delta) {
+    adjustTotalStock(IngredientRegistry::instance().intern(ingredient_name), delta);
+}
+
+// Entries that reach zero are kept, so that stock cycling through zero does not reallocate them
+void StationManager::adjustTotalStock(IngredientId id, long delta) {
+    if (delta != 0) {
+        total_stock_[id] += delta;
+    }
+}
+
 /**
 * Prepares the next dish in the queue if possible.
 * @pre: The dish queue is not empty.
@@ -192,16 +981,34 @@ void StationManager::addDishToQueue(Dish* dish, const Dish::DietaryRequest& requ
 bool StationManager::prepareNextDish () {
     if (!dish_queue_.empty()) { // Check if the dish queue is not empty
         Dish* dish = dish_queue_.front(); // Get dish at front of the queue
+        std::shared_ptr<const MenuSnapshot> menu = std::atomic_load(&menu_snapshot_); // Menu version for this dish
 
+        PhaseScope phase(profiler_, PhaseProfiler::STATION_LOOKUP);
         Node<KitchenStation*>* station_node = getHeadNode(); // Attempt to find a station to prepare the dish
+        Money cost_before = cost_of_goods_;
         while (station_node != nullptr) { // Loop through all stations
             KitchenStation* station = station_node->getItem(); // Get station
-            if (station->canCompleteOrder(dish->getName())) { // Check if station can prepare dish
-                if (station->prepareDish(dish->getName())) { // Prepare dish
+            const std::vector<Ingredient>* recipe = menu ? menu->findRecipe(station, dish->getName()) : nullptr;
+            if (menu && recipe == nullptr) { // Not served here in this menu version
+                station_node = station_node->getNext();
+                continue;
+            }
+            phase.switchTo(PhaseProfiler::REPLENISHMENT); // Sub-recipe batches top the station up
+            std::vector<Ingredient> resolved; // The recipe with sub-recipes, when the dish uses any
+            if (resolveSubRecipes(*station, dish->getName(), recipe, resolved)) {
+                recipe = &resolved;
+            }
+            phase.switchTo(PhaseProfiler::FEASIBILITY);
+            if (recipe != nullptr ? station->canCompleteRecipe(*recipe) : station->canCompleteOrder(dish->getName())) { // Check if station can prepare dish
+                phase.switchTo(PhaseProfiler::DEDUCTION);
+                if (recipe != nullptr ? station->prepareRecipe(*recipe) : station->prepareDish(dish->getName())) { // Prepare dish
+                    demand_forecast_.recordDish(dish->getName(), getTimeMs());
+                    recordSale(dish->getName(), dish->getPriceMoney(), cost_before);
                     dish_queue_.pop();  // Remove dish from the queue
                     return true;
                 }
             }
+            phase.switchTo(PhaseProfiler::STATION_LOOKUP);
             station_node = station_node->getNext();  // Move to next station
         }
     }
@@ -214,7 +1021,7 @@ bool StationManager::prepareNextDish () {
 * @post: The dish preparation queue is returned unchanged.
 */
 std::queue<Dish*> StationManager::getDishQueue() const {
-    return dish_queue_;
+    return dish_queue_.toQueue();
 }
 
 /**
@@ -224,7 +1031,27 @@ supplies.
 * @post: The list of backup ingredients is returned unchanged.
 */
 std::vector<Ingredient> StationManager::getBackupIngredients() const {
-    return backup_ingredients_;
+    std::vector<Ingredient> ingredients;
+    ingredients.reserve(backup_ingredients_.size());
+    for (const StockLine& line : backup_ingredients_.getLines()) {
+        ingredients.push_back(toIngredient(line));
+    }
+    return ingredients;
+}
+
+/**
+* @return The backup stock lines, without copying.
+*/
+const std::vector<StockLine>& StationManager::getBackupLines() const {
+    return backup_ingredients_.getLines();
+}
+
+/**
+* @param id The ingredient's registry ID.
+* @return Its backup line, or nullptr if it is not in backup stock.
+*/
+const StockLine* StationManager::findBackupLine(IngredientId id) const {
+    return backup_ingredients_.find(id);
 }
 
 /**
@@ -236,7 +1063,12 @@ Dish objects.
 queue.
 */
 void StationManager::setDishQueue(const std::queue<Dish*>& dish_queue) {
-    dish_queue_ = dish_queue;
+    dish_queue_.clear(); // Keeps the ring's storage
+    std::queue<Dish*> pending = dish_queue;
+    while (!pending.empty()) {
+        dish_queue_.push(pending.front());
+        pending.pop();
+    }
 }
 
 /**
@@ -246,10 +1078,8 @@ void StationManager::setDishQueue(const std::queue<Dish*>& dish_queue) {
 is on its own line).
 */
 void StationManager::displayDishQueue() const {
-    std::queue<Dish*> temp_queue = dish_queue_; // Create temporary queue to preserve original queue
-    while (!temp_queue.empty()) { // Loop through all dishes in the queue
-        std::cout << temp_queue.front()->getName() << std::endl; //Display dish name
-        temp_queue.pop(); // Remove dish from the queue
+    for (size_t i = 0; i < dish_queue_.size(); ++i) { // Loop through all dishes in the queue, front first
+        std::cout << dish_queue_.at(i)->getName() << std::endl; //Display dish name
     }
 }
 
@@ -295,24 +1125,27 @@ bool StationManager::replenishStationIngredientFromBackup(const std::string& sta
         return false;
     }
 
-    for (auto it = backup_ingredients_.begin(); it != backup_ingredients_.end(); ++it) { // Loop through all backup ingredients
-        if (it->name == ingredient_name) { // Check if ingredient exists in backup
-            if (it->quantity >= quantity) { // Check if there is sufficient quantity in backup
-                Ingredient replenished_ingredient(ingredient_name, quantity, 0, it->price); // Create a new Ingredient object with the replenished quantity
-
-                station->replenishStationIngredients(replenished_ingredient); // Add the replenished ingredient to the station
-
-                it->quantity -= quantity; // Update the backup stock quantity
-
-                if (it->quantity == 0) {
-                    backup_ingredients_.erase(it); // Remove ingredient from backup if quantity is zero
-                }
-
-                return true;
-            } else {
-                return false;
-            }
+    int available = 0;
+    IngredientId id;
+    if (IngredientRegistry::instance().find(ingredient_name, id)) { // Every backup ingredient is registered
+        PantryStock::Change change;
+        if (backup_ingredients_.take(id, quantity, change)) { // Takes the quantity only if there is enough; a depleted line is removed
+            station->replenishStationIngredients(StockLine{id, quantity, change.price}); // The replenished quantity, without copying the name
+            adjustTotalStock(id, -quantity); // The station's observer counted the other side
+            backup_value_ -= change.price * quantity;
+            return true;
         }
+        available = change.before;
+    }
+
+    // Ask the supplier (e.g. a sister kitchen) for the shortfall, then try once more
+    if (backup_supplier_ != nullptr) {
+        BackupSupplier* supplier = backup_supplier_;
+        backup_supplier_ = nullptr; // A supplier that calls back into this kitchen must not recurse
+        bool supplied = supplier->requestBackup(*this, ingredient_name, quantity - available);
+        bool replenished = supplied && replenishStationIngredientFromBackup(station_name, ingredient_name, quantity);
+        backup_supplier_ = supplier;
+        return replenished;
     }
 
     return false;
@@ -323,12 +1156,15 @@ bool StationManager::replenishStationIngredientFromBackup(const std::string& sta
 * @param ingredients A vector of Ingredient objects to set as the backup
 stock.
 * @pre None.
-* @post The backup_ingredients_ vector is replaced with the provided
-ingredients.
+* @post The backup stock is replaced with the provided ingredients
+(quantities of a repeated ingredient are added together).
 * @return True if the ingredients were added; false otherwise.
 */
 bool StationManager::addBackupIngredients(const std::vector<Ingredient>& ingredients) {
-    backup_ingredients_ = ingredients;
+    clearBackupIngredients();
+    for (const Ingredient& ingredient : ingredients) {
+        addBackupIngredient(ingredient);
+    }
     return true;
 }
 
@@ -342,23 +1178,108 @@ is increased by the ingredient's quantity.
 * @return True if the ingredient was added; false otherwise.
 */
 bool StationManager::addBackupIngredient(const Ingredient& ingredient) {
-    for (auto& backup_ingredient : backup_ingredients_) { // Check if ingredient already exists in backup
-        if (backup_ingredient.name == ingredient.name) { // Check if ingredient exists
-            backup_ingredient.quantity += ingredient.quantity; // Increase quantity if ingredient exists
-            return true;
-        }
-    }
-
-    backup_ingredients_.push_back(ingredient); // Add ingredient to backup if it does not exist
+    IngredientId id = IngredientRegistry::instance().intern(ingredient.name);
+    adjustTotalStock(id, ingredient.quantity);
+    // Increases the quantity if the ingredient exists, otherwise adds it
+    PantryStock::Change change = backup_ingredients_.add(id, ingredient.quantity, ingredient.getPriceMoney());
+    backup_value_ += change.price * ingredient.quantity; // Valued at the line's price
     return true;
 }
 
 /**
 * Empties the backup ingredients vector
-* @post The backup_ingredients_ private member variable is empty.
+* @post The backup stock is empty.
 */
 void StationManager::clearBackupIngredients() {
+    for (const StockLine& line : backup_ingredients_.getLines()) {
+        adjustTotalStock(line.id, -line.quantity);
+    }
     backup_ingredients_.clear();
+    backup_value_ = Money();
+}
+
+/**
+* Takes up to a given quantity of an ingredient out of the backup stock.
+* @param ingredient_name A string representing the name of the ingredient.
+* @param quantity The most units to take.
+* @return The number of units taken (0 if the ingredient is not in backup stock).
+*/
+int StationManager::withdrawBackupIngredient(const std::string& ingredient_name, int quantity) {
+    if (quantity <= 0) {
+        return 0;
+    }
+    IngredientId id;
+    PantryStock::Change change;
+    if (!IngredientRegistry::instance().find(ingredient_name, id) || !backup_ingredients_.takeUpTo(id, quantity, change)) {
+        return 0; // Not in backup stock
+    }
+    int taken = change.before - change.after; // A depleted line is removed from the backup
+    adjustTotalStock(id, -taken);
+    backup_value_ -= change.price * taken;
+    return taken;
+}
+
+/**
+* Sets the supplier asked for stock when the backup runs short.
+* @param supplier The supplier, or nullptr for none.
+*/
+void StationManager::setBackupSupplier(BackupSupplier* supplier) {
+    backup_supplier_ = supplier;
+}
+
+/**
+* @return The number of dishes waiting in the preparation queue.
+*/
+size_t StationManager::getDishQueueSize() const {
+    return dish_queue_.size();
+}
+
+/**
+* Sizes the preparation queue to hold a backlog without allocating.
+* @param capacity The number of dishes.
+*/
+void StationManager::reserveDishQueue(size_t capacity) {
+    dish_queue_.reserve(capacity);
+}
+
+/**
+* Publishes a menu version for dispatch.
+* @param menu The menu to dispatch against, or nullptr to go back to the
+stations' live dish lists.
+*/
+void StationManager::publishMenu(std::shared_ptr<const MenuSnapshot> menu) {
+    std::atomic_store(&menu_snapshot_, menu);
+}
+
+/**
+* @return The published menu version, or nullptr if dispatch uses the
+stations' live dish lists.
+*/
+std::shared_ptr<const MenuSnapshot> StationManager::getPublishedMenu() const {
+    return std::atomic_load(&menu_snapshot_);
+}
+
+/**
+* Builds and publishes a new menu version on a background thread.
+* @param edit A function that edits the new version.
+* @return A future holding the published version once it is live.
+*/
+std::future<std::shared_ptr<const MenuSnapshot>> StationManager::reloadMenuAsync(std::function<void(MenuSnapshot&)> edit) {
+    // Capture the live assignments here, before anyone relies on the snapshot to leave them alone
+    std::shared_ptr<const MenuSnapshot> live;
+    if (!getPublishedMenu()) {
+        live = MenuSnapshot::capture(*this);
+    }
+    return std::async(std::launch::async, [this, live, edit]() {
+        std::lock_guard<std::mutex> lock(reload_mutex_);
+        std::shared_ptr<const MenuSnapshot> base = getPublishedMenu();
+        std::shared_ptr<const MenuSnapshot> from = base ? base : live;
+        std::shared_ptr<MenuSnapshot> next = from ? from->nextVersion() : std::make_shared<MenuSnapshot>();
+        edit(*next);
+        std::shared_ptr<const MenuSnapshot> published = next;
+        publishMenu(published);
+        return published;
+    });
 }
 
 /**
@@ -424,89 +1345,144 @@ Beef Wellington was not prepared.
 All dishes have been processed.
 */
 void StationManager::processAllDishes() {
-    std::queue<Dish*> temp_queue; // Temporary queue to hold dishes that cannot be prepared
+    processAllDishes(std::cout);
+}
 
-    while (!dish_queue_.empty()) { // Loop through all dishes in the queue
+/**
+* Processes all dishes in the queue, writing the detailed results to a stream.
+* @param out The stream that receives the preparation log.
+* @param results If not null, receives one entry per processed dish, in queue
+order: true if the dish was prepared, false if it stayed in the queue.
+*/
+void StationManager::processAllDishes(std::ostream& out, std::vector<bool>* results) {
+    TextEventSink events(out);
+    processAllDishes(events, results);
+}
+
+/**
+* Processes all dishes in the queue, sending each step to an event sink.
+* @param events The sink that receives the events.
+* @param results If not null, receives one entry per processed dish, in queue
+order: true if the dish was prepared, false if it stayed in the queue.
+*/
+void StationManager::processAllDishes(EventSink& events, std::vector<bool>* results) {
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    size_t remaining = dish_queue_.size(); // Dishes that cannot be prepared go back to the end of the queue, in order
+
+    while (remaining-- > 0) { // Loop through all dishes in the queue
         Dish* dish = dish_queue_.front(); // Get the dish at the front
         dish_queue_.pop(); // Remove the dish from the main queue
+        auto emit = [this, &events, dish](KitchenEvent::Kind kind, const KitchenStation* station) {
+            PhaseScope output(profiler_, PhaseProfiler::OUTPUT);
+            events.record(KitchenEvent{kind, 0, 0, station, dish});
+        };
 
-        std::cout << "PREPARING DISH: " << dish->getName() << std::endl;
+        PhaseScope phase(profiler_, PhaseProfiler::STATION_LOOKUP);
+        emit(KitchenEvent::PREPARING, nullptr);
+        std::shared_ptr<const MenuSnapshot> menu = std::atomic_load(&menu_snapshot_); // Menu version for this dish
 
         Node<KitchenStation*>* station_node = getHeadNode(); // Start at the first station
         bool dish_prepared = false; // Track if the dish was successfully prepared
+        Money cost_before = cost_of_goods_; // Deductions from here on are this dish's ingredients
 
         while (station_node != nullptr) { // Loop through all stations
             KitchenStation* station = station_node->getItem(); // Get the station
-            std::cout << station->getName() << " attempting to prepare " << dish->getName() << "..." << std::endl;
+            emit(KitchenEvent::ATTEMPTING, station);
 
             bool dish_assigned = false; // Track if the dish is assigned to the station
-            for (Dish* assigned_dish : station->getDishes()) { // Check if the dish is assigned to the station
-                if (assigned_dish->getName() == dish->getName()) { // Check if the dish is assigned
-                    dish_assigned = true;
-                    break;
+            const std::vector<Ingredient>* recipe = nullptr; // The station's recipe when a menu version is published
+            if (menu) {
+                recipe = menu->findRecipe(station, dish->getName());
+                dish_assigned = recipe != nullptr;
+            } else {
+                for (Dish* assigned_dish : station->getDishes()) { // Check if the dish is assigned to the station
+                    if (assigned_dish->getName() == dish->getName()) { // Check if the dish is assigned
+                        dish_assigned = true;
+                        break;
+                    }
                 }
             }
 
             if (!dish_assigned) { // Check if the dish is assigned to the station
-                std::cout << station->getName() << ": Dish not available. Moving to next station..." << std::endl;
+                emit(KitchenEvent::NOT_AVAILABLE, station);
                 station_node = station_node->getNext(); // Move to the next station
                 continue;
             }
 
-            if (station->canCompleteOrder(dish->getName())) { // Attempt to prepare the dish
-                if (station->prepareDish(dish->getName())) { // Check if the dish was prepared
-                    std::cout << station->getName() << ": Successfully prepared " << dish->getName() << "." << std::endl;
+            phase.switchTo(PhaseProfiler::REPLENISHMENT); // Sub-recipe batches top the station up
+            std::vector<Ingredient> resolved; // The recipe with sub-recipes, when the dish uses any
+            bool nested = resolveSubRecipes(*station, dish->getName(), recipe, resolved);
+            if (nested) {
+                recipe = &resolved;
+            }
+            phase.switchTo(PhaseProfiler::FEASIBILITY);
+            if (recipe != nullptr ? station->canCompleteRecipe(*recipe) : station->canCompleteOrder(dish->getName())) { // Attempt to prepare the dish
+                phase.switchTo(PhaseProfiler::DEDUCTION);
+                if (recipe != nullptr ? station->prepareRecipe(*recipe) : station->prepareDish(dish->getName())) { // Check if the dish was prepared
+                    emit(KitchenEvent::PREPARED, station);
                     dish_prepared = true;
                     break;
                 }
             } else {
-                std::cout << station->getName() << ": Insufficient ingredients. Replenishing ingredients..." << std::endl;
+                emit(KitchenEvent::INSUFFICIENT, station);
+                phase.switchTo(PhaseProfiler::REPLENISHMENT);
 
                 bool replenishment_success = true; // Track if ingredient replenishment is successful
-                for (const Ingredient& ingredient : dish->getIngredients()) { // Loop through all ingredients in the dish
-                    int required_quantity = ingredient.required_quantity; // Get the required quantity
-                    int current_quantity = 0; // Initialize current quantity
-
-                    for (const Ingredient& stock_ingredient : station->getIngredientsStock()) { // Loop through all ingredients in the station
-                        if (stock_ingredient.name == ingredient.name) { // Check if the ingredient is in stock
-                            current_quantity = stock_ingredient.quantity; // Get the current quantity
+                if (nested) { // Raw ingredients for the sub-recipe batches, which are then made
+                    replenishment_success = replenishSubRecipes(*station, resolved);
+                } else if (recipe != nullptr) { // The published recipe this dish was pinned to, not the dish's own
+                    for (const Ingredient& ingredient : *recipe) {
+                        int replenish_quantity = ingredient.required_quantity - station->getStockQuantity(ingredient.name);
+                        if (replenish_quantity > 0 && !replenishStationIngredientFromBackup(station->getName(), ingredient.name, replenish_quantity)) {
+                            replenishment_success = false;
                             break;
                         }
                     }
-
-                    int replenish_quantity = required_quantity - current_quantity; // Calculate the replenish quantity
-                    if (replenish_quantity > 0) { // Check if replenishment is needed
-                        if (!replenishStationIngredientFromBackup(station->getName(), ingredient.name, replenish_quantity)) { // Replenish ingredient from backup
-                            replenishment_success = false;
-                            break;
+                } else {
+                    for (const RecipeLine& line : dish->getRecipeLines()) { // Loop through all ingredients in the dish
+                        int replenish_quantity = line.required - station->getStockQuantity(line.id); // Calculate the replenish quantity
+                        if (replenish_quantity > 0) { // Check if replenishment is needed
+                            if (!replenishStationIngredientFromBackup(station->getName(), registry.getName(line.id), replenish_quantity)) { // Replenish ingredient from backup
+                                replenishment_success = false;
+                                break;
+                            }
                         }
                     }
                 }
 
                 if (replenishment_success) { // Check if replenishment was successful
-                    std::cout << station->getName() << ": Ingredients replenished." << std::endl;
-                    if (station->prepareDish(dish->getName())) { // Attempt to prepare the dish
-                        std::cout << station->getName() << ": Successfully prepared " << dish->getName() << "." << std::endl;
+                    emit(KitchenEvent::REPLENISHED, station);
+                    phase.switchTo(PhaseProfiler::DEDUCTION);
+                    if (recipe != nullptr ? station->prepareRecipe(*recipe) : station->prepareDish(dish->getName())) { // Attempt to prepare the dish
+                        emit(KitchenEvent::PREPARED, station);
                         dish_prepared = true;
                         break;
                     } else {
-                        std::cout << station->getName() << ": Unable to prepare " << dish->getName() << "." << std::endl;
+                        emit(KitchenEvent::UNABLE_TO_PREPARE, station);
                     }
+                } else if (!substitutions_.empty() && // Skips copying the recipe when there is nothing to substitute
+                           prepareWithSubstitutes(*station, recipe != nullptr ? *recipe : dish->getIngredients(), events)) {
+                    emit(KitchenEvent::PREPARED, station);
+                    dish_prepared = true;
+                    break;
                 } else {
-                    std::cout << station->getName() << ": Unable to replenish ingredients. Failed to prepare " << dish->getName() << "." << std::endl;
+                    emit(KitchenEvent::UNABLE_TO_REPLENISH, station);
                 }
             }
 
+            phase.switchTo(PhaseProfiler::STATION_LOOKUP);
             station_node = station_node->getNext(); // Move to the next station
         }
 
+        phase.switchTo(PhaseProfiler::DEDUCTION); // Books the outcome
+        bookDish(dish, dish_prepared, cost_before, results);
+
         if (!dish_prepared) { // Check if the dish was prepared
-            std::cout << dish->getName() << " was not prepared." << std::endl;
-            temp_queue.push(dish); // Add the dish to the temporary queue
+            emit(KitchenEvent::NOT_PREPARED, nullptr);
+            dish_queue_.push(dish); // Back to the end of the queue, behind the dishes still to process
         }
     }
 
-    dish_queue_ = temp_queue; // Restore unprepared dishes back to the original queue
-
-    std::cout << "\n\nAll dishes have been processed." << std::endl;
+    PhaseScope output(profiler_, PhaseProfiler::OUTPUT);
+    events.record(KitchenEvent{KitchenEvent::ALL_PROCESSED, 0, 0, nullptr, nullptr});
 }
@@ -16,12 +16,61 @@
 #include "LinkedList.hpp"
 #include "KitchenStation.hpp"
 #include "Dish.hpp"
+#include "MenuSnapshot.hpp"
+#include "DishNameIndex.hpp"
+#include "IngredientIndex.hpp"
+#include "DishStats.hpp"
+#include "StockHistory.hpp"
+#include "DemandForecast.hpp"
+#include "RecipeBook.hpp"
+#include "SubstitutionGraph.hpp"
+#include "DishQueue.hpp"
+#include "EventSink.hpp"
+#include "PhaseProfiler.hpp"
 #include <string>
 #include <queue>
 #include <vector>
+#include <ostream>
+#include <memory>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <unordered_map>
 
-class StationManager : public LinkedList<KitchenStation*> {
+class StationManager;
+
+/**
+ * Interface for a source of pantry stock outside a StationManager, such as a sister kitchen.
+ */
+class BackupSupplier {
 public:
+    virtual ~BackupSupplier() = default;
+
+    /**
+     * Asks for more of an ingredient to be added to a kitchen's backup stock.
+     * @param requester The kitchen whose backup stock ran short.
+     * @param ingredient_name The name of the missing ingredient.
+     * @param quantity The number of units the kitchen is short.
+     * @post: If stock is available, at least `quantity` units are added with requester.addBackupIngredient().
+     * @return True if at least `quantity` units were added; false otherwise.
+     */
+    virtual bool requestBackup(StationManager& requester, const std::string& ingredient_name, int quantity) = 0;
+};
+
+class StationManager : public LinkedList<KitchenStation*>, private StationObserver {
+public:
+    /**
+     * @enum AdmissionResult
+     * @brief The outcome of tryAddDishToQueue().
+     */
+    enum AdmissionResult {
+        ADMITTED,       // The dish was added to the queue
+        QUEUE_FULL,     // The queue is at capacity; try again after processing
+        NOT_SERVED,     // No station serves the dish
+        OUT_OF_STOCK,   // All stations plus the backup together hold less of an ingredient than the dish needs
+        INVALID_DISH    // The dish pointer is null
+    };
+
     /**
      * Default Constructor
      * @post: Initializes an empty station manager.
@@ -93,6 +142,14 @@ public:
      */
     bool canCompleteOrder(const std::string& dish_name) const;
 
+    /**
+     * Collects every dish assigned to any station.
+     * @return: The assigned dishes in station order. A dish assigned to several stations
+     * (by name) appears once, at its first station. The index of a dish in this vector
+     * is its catalog ID.
+     */
+    std::vector<Dish*> getMenu() const;
+
     /**
      * Prepares a dish at a specific station if possible.
      * @param station_name A string representing the station's name.
@@ -121,6 +178,59 @@ public:
     */
     void addDishToQueue(Dish* dish, const Dish::DietaryRequest& request);
 
+    /**
+    * Adds a dish to the preparation queue if the kitchen can take it.
+    * @param dish A pointer to a dynamically allocated Dish object.
+    * @post: The dish is added to the end of the queue only if the result is
+    ADMITTED. The checks use counters kept up to date on every assignment and
+    stock change, so they cost one lookup per ingredient and never walk the
+    stations. With a published menu, one lookup finds the dish's distinct
+    published recipes, kept by the MenuSnapshot, and the dish is admitted if
+    the stock covers any of them. A component that is a sub-recipe in the
+    recipe book counts as covered by the units already made plus the raw
+    ingredients of the batches that would make up the rest. When a
+    backup supplier is set, stock is not checked, because the supplier may
+    still provide it.
+    * @return: ADMITTED, or the reason the dish was turned away.
+    */
+    AdmissionResult tryAddDishToQueue(Dish* dish);
+
+    /**
+    * Adjusts a dish for dietary accommodations and adds it to the preparation
+    queue if the kitchen can take it.
+    * @param dish A pointer to a dynamically allocated Dish object.
+    * @param request A DietaryRequest object specifying dietary accommodations.
+    * @post: Admission is checked as by tryAddDishToQueue(dish), against a copy
+    adjusted with Dish::clone() (the dish as it is, if it cannot be copied).
+    The dish itself is adjusted and queued only if the result is ADMITTED;
+    otherwise it is left unchanged.
+    * @return: ADMITTED, or the reason the dish was turned away.
+    */
+    AdmissionResult tryAddDishToQueue(Dish* dish, const Dish::DietaryRequest& request);
+
+    /**
+    * Sets the most dishes tryAddDishToQueue() lets wait in the queue.
+    * @param capacity The queue bound, or 0 for no bound.
+    */
+    void setQueueCapacity(size_t capacity);
+
+    /**
+    * @return The queue bound, or 0 if there is none.
+    */
+    size_t getQueueCapacity() const;
+
+    /**
+    * @param reason An admission result.
+    * @return The number of tryAddDishToQueue() calls that returned that result.
+    */
+    unsigned long getAdmissionCount(AdmissionResult reason) const;
+
+    /**
+    * @param ingredient_name A string representing the name of an ingredient.
+    * @return The total quantity of the ingredient held by all stations plus the backup stock.
+    */
+    long getTotalStock(const std::string& ingredient_name) const;
+
     /**
     * Prepares the next dish in the queue if possible.
     * @pre: The dish queue is not empty.
@@ -145,6 +255,20 @@ public:
     */
     std::vector<Ingredient> getBackupIngredients() const;
 
+    /**
+    * @return The backup stock lines, in the order their ingredients were
+    first added, without copying. Valid until the backup stock next changes.
+    */
+    const std::vector<StockLine>& getBackupLines() const;
+
+    /**
+    * Looks up one ingredient of the backup stock without copying the stock.
+    * @param id The ingredient's registry ID.
+    * @return Its backup line (quantity and unit price), or nullptr if it is
+    not in backup stock. Valid until the backup stock next changes.
+    */
+    const StockLine* findBackupLine(IngredientId id) const;
+
     /**
     * Sets the current dish preparation queue.
     * @param dish_queue A queue containing pointers to Dish objects.
@@ -186,6 +310,9 @@ public:
     * If the ingredient in backup stock is depleted (quantity becomes
     zero), it is removed from the backup stock.
     * If the ingredient does not have sufficient quantity in backup
+    stock and a backup supplier is set, the supplier is asked for the
+    shortfall first.
+    * If the ingredient does not have sufficient quantity in backup
     stock, or the ingredient or station is not found, returns false.
     * @return True if the ingredient was replenished from backup; false
     otherwise.
@@ -197,8 +324,8 @@ public:
     * @param ingredients A vector of Ingredient objects to set as the backup
     stock.
     * @pre None.
-    * @post The backup_ingredients_ vector is replaced with the provided
-    ingredients.
+    * @post The backup stock is replaced with the provided ingredients
+    (quantities of a repeated ingredient are added together).
     * @return True if the ingredients were added; false otherwise.
     */
     bool addBackupIngredients(const std::vector<Ingredient>& ingredients);
@@ -216,10 +343,319 @@ public:
 
     /**
     * Empties the backup ingredients vector
-    * @post The backup_ingredients_ private member variable is empty.
+    * @post The backup stock is empty.
     */
     void clearBackupIngredients();
 
+    /**
+    * Takes up to a given quantity of an ingredient out of the backup stock.
+    * @param ingredient_name A string representing the name of the ingredient.
+    * @param quantity The most units to take.
+    * @post The backup quantity is decreased by the returned amount; an ingredient
+    whose quantity reaches zero is removed from the backup stock.
+    * @return The number of units taken (0 if the ingredient is not in backup stock).
+    */
+    int withdrawBackupIngredient(const std::string& ingredient_name, int quantity);
+
+    /**
+    * Sets the supplier asked for stock when the backup runs short.
+    * @param supplier The supplier, or nullptr for none. The caller keeps ownership.
+    * @post replenishStationIngredientFromBackup() asks the supplier for the
+    shortfall before giving up on an ingredient.
+    */
+    void setBackupSupplier(BackupSupplier* supplier);
+
+    /**
+    * @return The number of dishes waiting in the preparation queue.
+    */
+    size_t getDishQueueSize() const;
+
+    /**
+    * Sizes the preparation queue to hold a backlog without allocating.
+    * @param capacity The number of dishes.
+    * @post: With the queue reserved and the stations, pantry and dishes
+    warmed up by one round of orders, addDishToQueue(), prepareNextDish() and
+    processAllDishes() with a NullEventSink or a reserved BinaryEventSink make
+    no heap allocations per order, as long as no sub-recipe or substitution
+    is involved.
+    */
+    void reserveDishQueue(size_t capacity);
+
+    /**
+    * Publishes a menu version for dispatch.
+    * @param menu The menu to dispatch against, or nullptr to go back to the
+    stations' live dish lists.
+    * @post Dishes that processAllDishes() or prepareNextDish() start from now
+    on use this version to decide which stations serve them and with which
+    recipe. Dishes already being prepared finish on the version they started
+    with. Safe to call while another thread is dispatching.
+    */
+    void publishMenu(std::shared_ptr<const MenuSnapshot> menu);
+
+    /**
+    * @return The published menu version, or nullptr if dispatch uses the
+    stations' live dish lists.
+    */
+    std::shared_ptr<const MenuSnapshot> getPublishedMenu() const;
+
+    /**
+    * Builds and publishes a new menu version on a background thread.
+    * @param edit A function that edits the new version (a copy of the
+    published version, or of the live assignments if none is published).
+    * @post Reloads are applied one at a time, each on top of the previous
+    one; dispatch is never paused.
+    * @return A future holding the published version once it is live.
+    */
+    std::future<std::shared_ptr<const MenuSnapshot>> reloadMenuAsync(std::function<void(MenuSnapshot&)> edit);
+
+    /**
+    * Looks up the dishes assigned to this manager's stations by name prefix.
+    * @param prefix The typed prefix; case is ignored.
+    * @param limit The maximum number of matches to return.
+    * @return Up to `limit` dishes in case-insensitive alphabetical order,
+    each with the stations that serve it.
+    */
+    std::vector<DishNameIndex::Match> autocompleteDish(const std::string& prefix, size_t limit = 10) const;
+
+    /**
+    * Live statistics for dashboards: the most-ordered and most-failed dishes
+    and per-dish estimates, in bounded memory.
+    * @return The statistics fed by processAllDishes(), one event per dish
+    it attempts. Safe to read while another thread is dispatching.
+    */
+    const DishStats& getDishStats() const;
+
+    /**
+    * Replaces the clock used to timestamp stock movements, e.g. with a
+    simulated one.
+    * @param clock_ms A function returning the current time in milliseconds on
+    a monotonic clock. An empty function restores std::chrono::steady_clock.
+    */
+    void setClock(std::function<int64_t()> clock_ms);
+
+    /**
+    * @return The current time in milliseconds according to the clock.
+    */
+    int64_t getTimeMs() const;
+
+    /**
+    * @return The per-station, per-ingredient history of stock movements.
+    */
+    const StockHistory& getStockHistory() const;
+
+    /**
+    * @param station_name The name of a station.
+    * @param ingredient_name The name of an ingredient.
+    * @param window_seconds The length of the window ending now, up to one day.
+    * @return The average units of the ingredient the station used per second
+    over the window, or 0 if the station does not exist.
+    */
+    double getConsumptionRate(const std::string& station_name, const std::string& ingredient_name, int window_seconds = 60) const;
+
+    /**
+    * Projects when a station will run out of an ingredient if it keeps using
+    it at the rate seen over a window. Replenishments are not projected.
+    * @param station_name The name of a station.
+    * @param ingredient_name The name of an ingredient.
+    * @param window_seconds The length of the window the rate is measured over.
+    * @return The projected seconds until the station's stock reaches zero; 0 if
+    it holds none; -1 if it used none during the window or does not exist.
+    */
+    double getTimeToStockout(const std::string& station_name, const std::string& ingredient_name, int window_seconds = 60) const;
+
+    /**
+    * Valuation queries. Values are kept in whole cents (as exact Money sums)
+    and updated on every stock change, so each query is O(1).
+    * @return The value of all stations' stock plus the backup stock, in cents.
+    */
+    long getInventoryValueCents() const;
+
+    /**
+    * @return The value of the backup stock, in cents.
+    */
+    long getBackupValueCents() const;
+
+    /**
+    * @param station_name The name of a station.
+    * @return The value of the station's stock in cents, or 0 if it does not exist.
+    */
+    long getStationValueCents(const std::string& station_name) const;
+
+    /**
+    * @return The cost of goods of every dish prepared so far, in cents.
+    */
+    long getCostOfGoodsCents() const;
+
+    /**
+    * @param dish_name The name of a dish.
+    * @return The cost of goods of every preparation of the dish so far, in cents.
+    */
+    long getCostOfGoodsCents(const std::string& dish_name) const;
+
+    /**
+    * @return The menu price of every dish prepared so far, in cents.
+    */
+    long getRevenueCents() const;
+
+    /**
+    * @param dish_name The name of a dish.
+    * @return The menu price of every preparation of the dish so far, in cents.
+    */
+    long getRevenueCents(const std::string& dish_name) const;
+
+    /**
+    * @return The demand estimators: orders filled per dish, fed by
+    processAllDishes() and prepareNextDish(), and units used per station and
+    ingredient.
+    */
+    const DemandForecast& getDemandForecast() const;
+
+    /**
+    * @param half_life_seconds How quickly the demand estimators forget old
+    orders (default 300 seconds).
+    */
+    void setDemandHalfLife(double half_life_seconds);
+
+    /**
+    * Projects how much of each ingredient each station will use over the next
+    minutes, at the current estimated demand.
+    * @param minutes The length of the projection.
+    * @return One entry per (station, ingredient) with recent use, including
+    the units the station holds now.
+    */
+    std::vector<IngredientNeed> projectIngredientNeeds(int minutes) const;
+
+    /**
+    * Tops stations up from the backup stock ahead of projected demand, so the
+    dispatch loop does not have to.
+    * @param minutes The length of the projection.
+    * @post: Each station projected to use more of an ingredient than it holds
+    receives the difference from the backup stock (or the backup supplier),
+    when available.
+    * @return The number of units moved.
+    */
+    int prestockFromBackup(int minutes);
+
+    /**
+    * @param ingredient_name The name of an ingredient.
+    * @return Every (station, dish) pair whose recipe uses the ingredient.
+    */
+    std::vector<IngredientIndex::Use> getDishesUsing(const std::string& ingredient_name) const;
+
+    /**
+    * Checks whether a dish is 86'd: some station serves it, but every such
+    station has run out of at least one of its ingredients. The backup stock
+    is not considered.
+    * @param dish_name The name of a dish.
+    * @return True if the dish is 86'd; false otherwise.
+    */
+    bool isEightySixed(const std::string& dish_name) const;
+
+    /**
+    * @return The names of all 86'd dishes, in no particular order.
+    */
+    std::vector<std::string> getEightySixedDishes() const;
+
+    /**
+    * The sub-recipes that dish recipes and side dishes may refer to. A dish
+    component or MainCourse side dish named after a sub-recipe is taken from
+    the station's stock of it, and any shortfall is batch-prepared at the
+    station from raw ingredients first, when they are in stock. When they are
+    not, processAllDishes() moves those raw ingredients from the backup stock,
+    makes the batches and tries the dish again.
+    * @return The recipe book.
+    */
+    RecipeBook& getRecipeBook();
+
+    /**
+    * @return The recipe book.
+    */
+    const RecipeBook& getRecipeBook() const;
+
+    /**
+    * Prepares batches of a sub-recipe at a station from raw ingredients. The
+    result is stocked at the station like any other ingredient, valued at the
+    cost of its raw ingredients per unit, and is charged to cost of goods only
+    when a dish uses it (the cents lost rounding the unit cost down are charged
+    at once).
+    * @param station_name The name of the station.
+    * @param recipe_name The name of a sub-recipe in the recipe book.
+    * @param batches The number of batches.
+    * @return True if the batches were prepared; false if the station or
+    sub-recipe does not exist or the station lacks raw ingredients.
+    */
+    bool prepareBatch(const std::string& station_name, const std::string& recipe_name, int batches = 1);
+
+    /**
+    * @return The number of batch runs so far, by prepareBatch(), by
+    runMiseEnPlace(), or on demand while preparing a dish. One run may make
+    several batches.
+    */
+    unsigned long getBatchRunCount() const;
+
+    /**
+    * Plans mise en place: the sub-recipe batches each station should prepare
+    before service reaches them. Expected orders are the dishes waiting in the
+    queue plus the forecast orders over the next minutes; each dish is
+    expected at the first station serving it, as dispatch tries stations in
+    order. Only the dish's direct sub-recipes and side dishes are planned.
+    * @param minutes The length of the projection.
+    * @return One entry per (station, sub-recipe) whose stock falls short of
+    the expected use, in station order.
+    */
+    std::vector<BatchPlan> planMiseEnPlace(int minutes) const;
+
+    /**
+    * Prepares the batches planned by planMiseEnPlace(), one run per station
+    and sub-recipe, and stocks them at the stations.
+    * @param minutes The length of the projection.
+    * @return The number of batches prepared. Batches whose raw ingredients a
+    station lacks are skipped.
+    */
+    int runMiseEnPlace(int minutes);
+
+    /**
+    * The ingredient substitutions processAllDishes() may use. When a station
+    can neither cover a dish nor replenish it from the backup stock, the
+    cheapest substitutes that the station's stock plus the backup stock cover
+    are used instead, and each one is logged.
+    * @return The substitution graph.
+    */
+    SubstitutionGraph& getSubstitutionGraph();
+
+    /**
+    * @return The substitution graph.
+    */
+    const SubstitutionGraph& getSubstitutionGraph() const;
+
+    /**
+    * @return The number of dishes prepared with at least one substitute.
+    */
+    unsigned long getSubstitutedDishCount() const;
+
+    /**
+    * Turns on the profiling mode: processAllDishes() and prepareNextDish()
+    charge their station lookups, feasibility checks, replenishments,
+    deductions and log output to the profiler's phases.
+    * @param profiler A profiler created on the dispatch thread, or nullptr to
+    turn profiling off.
+    */
+    void setProfiler(PhaseProfiler* profiler);
+
+    /**
+    * @return The profiler, or nullptr when profiling is off.
+    */
+    PhaseProfiler* getProfiler() const;
+
+    /**
+    * Reports the memory used by the manager: the list nodes, every station
+    with its stock and dishes, the queue, the backup stock, and the indexes,
+    statistics and caches kept alongside them. The published menu snapshot is
+    not counted, as it may be shared.
+    * @return The breakdown, in bytes (a lower bound; see MemoryUsage.hpp).
+    */
+    MemoryUsage memoryUsage() const;
+
     /**
     * Processes all dishes in the queue and displays detailed results.
     * @pre: None.
@@ -233,11 +669,77 @@ public:
     */
     void processAllDishes();
 
+    /**
+    * Processes all dishes in the queue, writing the detailed results to a stream.
+    * @param out The stream that receives the preparation log. A stream without a
+    buffer (e.g. std::ostream(nullptr)) discards the log without formatting it.
+    * @param results If not null, receives one entry per processed dish, in queue
+    order: true if the dish was prepared, false if it stayed in the queue.
+    * @post: Same as processAllDishes().
+    */
+    void processAllDishes(std::ostream& out, std::vector<bool>* results = nullptr);
+
+    /**
+    * Processes all dishes in the queue, sending each step to an event sink
+    rather than formatting it.
+    * @param events The sink that receives the events; a TextEventSink writes
+    the same log as processAllDishes(std::ostream&).
+    * @param results If not null, receives one entry per processed dish, as above.
+    * @post: Same as processAllDishes().
+    */
+    void processAllDishes(EventSink& events, std::vector<bool>* results = nullptr);
+
 private:
+friend class DispatchEngine; // Engines dispatch the queue and book each dish as processAllDishes() does
 // helper function to get index of a station by name
 int getStationIndex(const std::string& station_name) const;
-std::queue<Dish*> dish_queue_; // Queue storing pointers to dynamically allocated Dish objects
-std::vector<Ingredient> backup_ingredients_; // Vector representing the backup stock of ingredients
+// StationObserver: keeps the admission counters in step with the stations
+void onDishAssigned(const KitchenStation& station, const Dish& dish) override;
+void onStockChanged(const KitchenStation& station, IngredientId id, int delta, long value_delta_cents) override;
+void onStockAvailability(const KitchenStation& station, IngredientId id, bool in_stock) override;
+// helpers that add (sign 1) or remove (sign -1) a station's dishes and stock from the counters
+void accountStation(const KitchenStation& station, int sign);
+void adjustTotalStock(const std::string& ingredient_name, long delta);
+void adjustTotalStock(IngredientId id, long delta);
+AdmissionResult admit(Dish* dish);
+bool inTotalStock(const std::vector<RecipeLine>& recipe) const;
+void refreshSubRecipeLines();
+void recordSale(const std::string& dish_name, Money price, Money cost_before);
+void bookDish(Dish* dish, bool prepared, Money cost_before, std::vector<bool>* results);
+bool prepareBatchAt(KitchenStation& station, const std::string& recipe_name, int batches);
+bool prepareWithSubstitutes(KitchenStation& station, const std::vector<Ingredient>& recipe, EventSink& events);
+bool resolveSubRecipes(KitchenStation& station, const std::string& dish_name, const std::vector<Ingredient>* recipe, std::vector<Ingredient>& resolved);
+bool planSubRecipeBatches(const KitchenStation& station, const std::vector<Ingredient>& resolved, std::vector<Ingredient>& needs, std::vector<std::pair<std::string, int>>& batches) const;
+bool replenishSubRecipes(KitchenStation& station, const std::vector<Ingredient>& resolved);
+DishQueue dish_queue_; // Ring of pointers to dynamically allocated Dish objects
+PantryStock backup_ingredients_; // Backup stock of ingredients, in the order they were first added
+BackupSupplier* backup_supplier_; // Optional source of stock when the backup runs short
+std::shared_ptr<const MenuSnapshot> menu_snapshot_; // Published menu version; accessed with std::atomic_load/store
+std::mutex reload_mutex_; // Serializes reloadMenuAsync() edits
+size_t queue_capacity_; // Bound applied by tryAddDishToQueue(); 0 means unbounded
+std::unordered_map<std::string, int> served_stations_; // dish name -> number of stations serving it
+std::unordered_map<IngredientId, long> total_stock_; // ingredient -> stations' plus backup quantity; entries stay at zero
+unsigned long admission_counts_[INVALID_DISH + 1]; // tryAddDishToQueue() results by kind
+DishNameIndex dish_names_; // Prefix index over the names of assigned dishes
+struct DishSales { Money revenue; Money cost; };
+Money stations_value_; // Sum of the stations' inventory values
+Money backup_value_; // Value of backup_ingredients_, each line at its own unit price
+Money cost_of_goods_; // Value of every deduction, i.e. of the ingredients of every prepared dish
+Money revenue_; // Menu price of every prepared dish
+std::unordered_map<std::string, DishSales> dish_sales_; // dish name -> revenue and cost of goods of its preparations
+DishStats dish_stats_; // Streaming top-K and count-min sketches of dispatched and failed dishes
+StockHistory stock_history_; // Every station stock movement, in 1s/1m/1h rings
+std::function<int64_t()> clock_ms_; // Timestamps stock movements; steady_clock when empty
+DemandForecast demand_forecast_; // EWMA demand per dish and per (station, ingredient)
+IngredientIndex ingredient_index_; // ingredient -> (station, dish) pairs that use it, and the 86 list
+RecipeBook recipe_book_; // Sub-recipes, with cached raw expansions
+struct SubRecipeLines { int yield; std::vector<RecipeLine> raw; };
+std::unordered_map<IngredientId, SubRecipeLines> sub_recipe_lines_; // sub-recipe -> raw lines of one batch, for admission
+unsigned long sub_recipe_version_; // recipe_book_ version sub_recipe_lines_ was built from
+unsigned long batch_runs_; // Successful prepareBatchAt() calls
+SubstitutionGraph substitutions_; // Ingredient substitutes for dishes the stock cannot cover
+unsigned long substituted_dishes_; // Dishes prepared by prepareWithSubstitutes()
+PhaseProfiler* profiler_; // Dispatch phase counters; nullptr unless profiling
 };
 
 #endif // STATIONMANAGER_HPP
\ No newline at end of file
@@ -0,0 +1,119 @@
+/**
+ * @file StockHistory.cpp
+ * @brief This file contains the implementation of the StockHistory class.
+ */
+
+#include "StockHistory.hpp"
+#include "MemoryUsage.hpp"
+
+namespace {
+const int64_t SECOND_MS = 1000;
+const int64_t MINUTE_MS = 60 * SECOND_MS;
+const int64_t HOUR_MS = 60 * MINUTE_MS;
+}
+
+void StockHistory::record(const KitchenStation* station, IngredientId id, int delta, int64_t now_ms) {
+    if (delta == 0) {
+        return;
+    }
+    Series& series = series_[station][id];
+    add(series.seconds, 60, now_ms / SECOND_MS, delta);
+    add(series.minutes, 60, now_ms / MINUTE_MS, delta);
+    add(series.hours, 24, now_ms / HOUR_MS, delta);
+}
+
+void StockHistory::forget(const KitchenStation* station) {
+    series_.erase(station);
+}
+
+long StockHistory::getConsumed(const KitchenStation* station, IngredientId id, int window_seconds, int64_t now_ms) const {
+    return total(station, id, window_seconds, now_ms, true);
+}
+
+long StockHistory::getReplenished(const KitchenStation* station, IngredientId id, int window_seconds, int64_t now_ms) const {
+    return total(station, id, window_seconds, now_ms, false);
+}
+
+double StockHistory::getConsumptionRate(const KitchenStation* station, IngredientId id, int window_seconds, int64_t now_ms) const {
+    if (window_seconds <= 0) {
+        return 0.0;
+    }
+    return static_cast<double>(getConsumed(station, id, window_seconds, now_ms)) * SECOND_MS / coveredMs(window_seconds);
+}
+
+void StockHistory::add(Bucket* ring, int size, int64_t index, int delta) {
+    Bucket& bucket = ring[index % size];
+    if (bucket.index != index) {
+        bucket = Bucket{index, 0, 0};   // The slot last held an older period
+    }
+    if (delta < 0) {
+        bucket.consumed -= delta;
+    } else {
+        bucket.replenished += delta;
+    }
+}
+
+// The width of the buckets that a window is summed over
+int64_t StockHistory::bucketMs(int window_seconds) {
+    int64_t window_ms = window_seconds * SECOND_MS;
+    return window_ms <= MINUTE_MS ? SECOND_MS : window_ms <= HOUR_MS ? MINUTE_MS : HOUR_MS;
+}
+
+// The span of the buckets that a window is summed over: the window rounded up to whole buckets, at most a full ring
+int64_t StockHistory::coveredMs(int window_seconds) {
+    int64_t width = bucketMs(window_seconds);
+    int64_t count = (window_seconds * SECOND_MS + width - 1) / width;
+    int64_t size = width == HOUR_MS ? 24 : 60;
+    return (count < size ? count : size) * width;
+}
+
+// Sums the `count` buckets ending with period `index`, skipping slots that hold other periods
+long StockHistory::sum(const Bucket* ring, int size, int64_t index, int64_t count, bool consumed) {
+    if (count > size) {
+        count = size;
+    }
+    long total = 0;
+    for (int64_t i = index - count + 1; i <= index; ++i) {
+        if (i < 0) {
+            continue;
+        }
+        const Bucket& bucket = ring[i % size];
+        if (bucket.index == i) {
+            total += consumed ? bucket.consumed : bucket.replenished;
+        }
+    }
+    return total;
+}
+
+const StockHistory::Series* StockHistory::findSeries(const KitchenStation* station, IngredientId id) const {
+    auto station_series = series_.find(station);
+    if (station_series == series_.end()) {
+        return nullptr;
+    }
+    auto found = station_series->second.find(id);
+    return found == station_series->second.end() ? nullptr : &found->second;
+}
+
+long StockHistory::total(const KitchenStation* station, IngredientId id, int window_seconds, int64_t now_ms, bool consumed) const {
+    const Series* series = findSeries(station, id);
+    if (series == nullptr || window_seconds <= 0) {
+        return 0;
+    }
+    int64_t width = bucketMs(window_seconds);
+    int64_t count = coveredMs(window_seconds) / width;
+    if (width == SECOND_MS) {
+        return sum(series->seconds, 60, now_ms / width, count, consumed);
+    }
+    if (width == MINUTE_MS) {
+        return sum(series->minutes, 60, now_ms / width, count, consumed);
+    }
+    return sum(series->hours, 24, now_ms / width, count, consumed);
+}
+
+size_t StockHistory::memoryUsage() const {
+    size_t bytes = hashBytes(series_);
+    for (const auto& station_series : series_) {
+        bytes += hashBytes(station_series.second);
+    }
+    return bytes;
+}
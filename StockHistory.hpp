@@ -0,0 +1,96 @@
+/**
+ * @file StockHistory.hpp
+ * @brief This file contains the declaration of the StockHistory class, fixed-memory time series of
+ * stock movements per station and ingredient.
+ *
+ * Every (station, ingredient) pair has three rings of buckets: 60 one-second buckets, 60 one-minute
+ * buckets and 24 one-hour buckets. A movement is added to the current bucket of all three rings,
+ * so the rings hold the last minute, hour and day at decreasing resolution. A bucket whose slot
+ * comes around again is reset before reuse, so memory never grows with time. Recording allocates
+ * only the first time a pair is seen.
+ */
+
+#ifndef STOCKHISTORY_HPP
+#define STOCKHISTORY_HPP
+
+#include "IngredientRegistry.hpp"
+#include <cstdint>
+#include <unordered_map>
+
+class KitchenStation;
+
+class StockHistory {
+public:
+    /**
+     * Records a stock movement.
+     * @param station The station whose stock changed.
+     * @param id The ingredient.
+     * @param delta The change in units: negative for a deduction, positive for a replenishment.
+     * @param now_ms The current time in milliseconds on a monotonic clock.
+     */
+    void record(const KitchenStation* station, IngredientId id, int delta, int64_t now_ms);
+
+    /**
+     * Drops the history of a station.
+     * @param station The station.
+     */
+    void forget(const KitchenStation* station);
+
+    /**
+     * @param station The station.
+     * @param id The ingredient.
+     * @param window_seconds The length of the window ending now, at most one day. Windows up to a
+     * minute use one-second buckets, up to an hour one-minute buckets, otherwise one-hour buckets.
+     * @param now_ms The current time in milliseconds.
+     * @return The units deducted during the window.
+     */
+    long getConsumed(const KitchenStation* station, IngredientId id, int window_seconds, int64_t now_ms) const;
+
+    /**
+     * @param station The station.
+     * @param id The ingredient.
+     * @param window_seconds The length of the window ending now, as for getConsumed().
+     * @param now_ms The current time in milliseconds.
+     * @return The units replenished during the window.
+     */
+    long getReplenished(const KitchenStation* station, IngredientId id, int window_seconds, int64_t now_ms) const;
+
+    /**
+     * @param station The station.
+     * @param id The ingredient.
+     * @param window_seconds The length of the window ending now, as for getConsumed().
+     * @param now_ms The current time in milliseconds.
+     * @return The average units deducted per second over the buckets summed for the window, whose
+     * span is the window rounded up to whole buckets (e.g. 90 s covers two one-minute buckets, 120 s).
+     */
+    double getConsumptionRate(const KitchenStation* station, IngredientId id, int window_seconds, int64_t now_ms) const;
+
+    /**
+     * @return The heap bytes held by the history, estimated as in MemoryUsage.hpp.
+     */
+    size_t memoryUsage() const;
+
+private:
+    struct Bucket {
+        int64_t index = -1;     // time / bucket width of the period this bucket holds
+        long consumed = 0;
+        long replenished = 0;
+    };
+
+    struct Series {
+        Bucket seconds[60];
+        Bucket minutes[60];
+        Bucket hours[24];
+    };
+
+    static void add(Bucket* ring, int size, int64_t index, int delta);
+    static long sum(const Bucket* ring, int size, int64_t index, int64_t count, bool consumed);
+    static int64_t bucketMs(int window_seconds);
+    static int64_t coveredMs(int window_seconds);
+    const Series* findSeries(const KitchenStation* station, IngredientId id) const;
+    long total(const KitchenStation* station, IngredientId id, int window_seconds, int64_t now_ms, bool consumed) const;
+
+    std::unordered_map<const KitchenStation*, std::unordered_map<IngredientId, Series>> series_;
+};
+
+#endif // STOCKHISTORY_HPP
@@ -0,0 +1,190 @@
+/**
+ * @file SubstitutionGraph.cpp
+ * @brief This file contains the implementation of the SubstitutionGraph class.
+ */
+
+#include "SubstitutionGraph.hpp"
+#include "MemoryUsage.hpp"
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+namespace {
+const std::vector<SubstitutionGraph::Candidate> NO_CANDIDATES;
+}
+
+SubstitutionGraph::SubstitutionGraph() : edge_count_(0), stale_(false) {
+}
+
+bool SubstitutionGraph::addSubstitution(const std::string& original, const std::string& substitute, double cost) {
+    if (original == substitute || cost < 0.0) {
+        return false;
+    }
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    IngredientId from = registry.intern(original);
+    IngredientId to = registry.intern(substitute);
+    std::vector<Candidate>& edges = edges_[from];
+    stale_ = true;
+    for (Candidate& edge : edges) {
+        if (edge.substitute == to) {
+            edge.cost = cost;
+            return true;
+        }
+    }
+    edges.push_back(Candidate{to, cost});
+    ++edge_count_;
+    return true;
+}
+
+bool SubstitutionGraph::removeSubstitution(const std::string& original, const std::string& substitute) {
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    IngredientId from, to;
+    if (!registry.find(original, from) || !registry.find(substitute, to)) {
+        return false;
+    }
+    auto found = edges_.find(from);
+    if (found == edges_.end()) {
+        return false;
+    }
+    std::vector<Candidate>& edges = found->second;
+    for (size_t i = 0; i < edges.size(); ++i) {
+        if (edges[i].substitute == to) {
+            edges.erase(edges.begin() + i);
+            --edge_count_;
+            stale_ = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+const std::vector<SubstitutionGraph::Candidate>& SubstitutionGraph::getCandidates(IngredientId original) const {
+    refresh();
+    auto found = candidates_.find(original);
+    return found == candidates_.end() ? NO_CANDIDATES : found->second;
+}
+
+bool SubstitutionGraph::resolve(const std::vector<Ingredient>& recipe, const std::unordered_map<IngredientId, int>& available,
+                                std::vector<Ingredient>& substituted, std::vector<Substitution>& substitutions) const {
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    std::unordered_map<IngredientId, int> reserved;
+    auto remaining = [&available, &reserved](IngredientId id) {
+        auto found = available.find(id);
+        return (found == available.end() ? 0 : found->second) - reserved[id];
+    };
+
+    // First keep every ingredient the stock covers, so substitutes cannot take their units
+    substituted = recipe;
+    std::vector<size_t> short_positions;
+    std::vector<IngredientId> short_ids;
+    for (size_t i = 0; i < recipe.size(); ++i) {
+        IngredientId id = registry.intern(recipe[i].name);
+        if (remaining(id) >= recipe[i].required_quantity) {
+            reserved[id] += recipe[i].required_quantity;
+        } else {
+            short_positions.push_back(i);
+            short_ids.push_back(id);
+        }
+    }
+
+    substitutions.clear();
+    for (size_t k = 0; k < short_positions.size(); ++k) {
+        Ingredient& ingredient = substituted[short_positions[k]];
+        bool found = false;
+        for (const Candidate& candidate : getCandidates(short_ids[k])) {
+            if (remaining(candidate.substitute) >= ingredient.required_quantity) {
+                reserved[candidate.substitute] += ingredient.required_quantity;
+                std::string substitute = registry.getName(candidate.substitute);
+                substitutions.push_back(Substitution{ingredient.name, substitute, candidate.cost});
+                ingredient.name = substitute;
+                found = true;
+                break;
+            }
+        }
+        if (!found) {
+            return false;
+        }
+    }
+
+    // A substitute the recipe already uses joins that line, so the result asks for its whole requirement once
+    if (!short_positions.empty()) {
+        std::vector<Ingredient> merged;
+        merged.reserve(substituted.size());
+        for (const Ingredient& ingredient : substituted) {
+            auto same = std::find_if(merged.begin(), merged.end(), [&ingredient](const Ingredient& line) {
+                return line.name == ingredient.name;
+            });
+            if (same == merged.end()) {
+                merged.push_back(ingredient);
+            } else {
+                same->required_quantity += ingredient.required_quantity;
+            }
+        }
+        substituted.swap(merged);
+    }
+    return true;
+}
+
+size_t SubstitutionGraph::size() const {
+    return edge_count_;
+}
+
+bool SubstitutionGraph::empty() const {
+    return edge_count_ == 0;
+}
+
+void SubstitutionGraph::clear() {
+    edges_.clear();
+    edge_count_ = 0;
+    stale_ = true;
+}
+
+// Recomputes every candidate list: Dijkstra from each ingredient with outgoing substitutions
+void SubstitutionGraph::refresh() const {
+    if (!stale_) {
+        return;
+    }
+    candidates_.clear();
+    typedef std::pair<double, IngredientId> Entry;
+    for (const auto& source : edges_) {
+        std::unordered_map<IngredientId, double> best;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> frontier;
+        best[source.first] = 0.0;
+        frontier.push(Entry{0.0, source.first});
+        std::vector<Candidate>& candidates = candidates_[source.first];
+        while (!frontier.empty()) {
+            Entry entry = frontier.top();
+            frontier.pop();
+            if (entry.first > best[entry.second]) {
+                continue; // A cheaper path already settled this ingredient
+            }
+            if (entry.second != source.first) {
+                candidates.push_back(Candidate{entry.second, entry.first}); // Settled in cost order
+            }
+            auto out = edges_.find(entry.second);
+            if (out == edges_.end()) {
+                continue;
+            }
+            for (const Candidate& edge : out->second) {
+                double cost = entry.first + edge.cost;
+                auto known = best.find(edge.substitute);
+                if (known == best.end() || cost < known->second) {
+                    best[edge.substitute] = cost;
+                    frontier.push(Entry{cost, edge.substitute});
+                }
+            }
+        }
+    }
+    stale_ = false;
+}
+
+size_t SubstitutionGraph::memoryUsage() const {
+    size_t bytes = hashBytes(edges_) + hashBytes(candidates_);
+    for (const auto& edges : edges_) {
+        bytes += heapBytes(edges.second);
+    }
+    for (const auto& candidates : candidates_) {
+        bytes += heapBytes(candidates.second);
+    }
+    return bytes;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file SubstitutionGraph.hpp
+ * @brief This file contains the declaration of the SubstitutionGraph class, weighted ingredient
+ * substitutions (e.g. Chicken -> Tofu) and a resolver that repairs recipes the stock cannot cover.
+ *
+ * Edges join ingredient IDs and carry a cost, the penalty of serving the substitute. Substitutions
+ * chain: if Chicken -> Tofu costs 2 and Tofu -> Tempeh costs 1, Tempeh can stand in for Chicken
+ * at cost 3. After the graph changes, the cheapest paths from every ingredient are computed once
+ * (Dijkstra per source) into a candidate list sorted by cost, so resolving a recipe only walks
+ * short precomputed lists.
+ */
+
+#ifndef SUBSTITUTIONGRAPH_HPP
+#define SUBSTITUTIONGRAPH_HPP
+
+#include "Dish.hpp"
+#include "IngredientRegistry.hpp"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+class SubstitutionGraph {
+public:
+    /**
+     * @struct Candidate
+     * @brief An ingredient that can stand in for another, and the total cost of doing so.
+     */
+    struct Candidate {
+        IngredientId substitute;
+        double cost;
+    };
+
+    /**
+     * @struct Substitution
+     * @brief One substitution chosen by resolve().
+     */
+    struct Substitution {
+        std::string original;
+        std::string substitute;
+        double cost;
+    };
+
+    /**
+     * Default constructor.
+     * Initializes a graph without substitutions.
+     */
+    SubstitutionGraph();
+
+    /**
+     * Adds a substitution, or changes the cost of an existing one. Substitutions are one-way.
+     * @param original The name of the ingredient a recipe asks for.
+     * @param substitute The name of the ingredient that may be used instead, unit for unit.
+     * @param cost The penalty of using the substitute (non-negative).
+     * @return True if the substitution was added or changed; false if the names are the same or
+     * the cost is negative.
+     */
+    bool addSubstitution(const std::string& original, const std::string& substitute, double cost);
+
+    /**
+     * Removes a substitution.
+     * @param original The name of the ingredient a recipe asks for.
+     * @param substitute The name of the substitute.
+     * @return True if the substitution existed; false otherwise.
+     */
+    bool removeSubstitution(const std::string& original, const std::string& substitute);
+
+    /**
+     * @param original The ID of an ingredient.
+     * @return Every ingredient that can stand in for it, directly or through a chain, cheapest
+     * first.
+     */
+    const std::vector<Candidate>& getCandidates(IngredientId original) const;
+
+    /**
+     * Finds the cheapest substitutions that make a recipe feasible. Ingredients the stock covers
+     * are kept; each other ingredient takes the cheapest candidate with enough stock left after
+     * the kept ingredients and earlier substitutions.
+     * @param recipe The recipe, with required_quantity set.
+     * @param available Units available per ingredient ID.
+     * @param substituted Receives the recipe with substitutes in place, one line per ingredient: a
+     * substitute the recipe already uses is added to that line's required_quantity.
+     * @param substitutions Receives the substitutions made.
+     * @return True if the recipe is feasible after substitution; false otherwise, in which case
+     * the outputs are unspecified.
+     */
+    bool resolve(const std::vector<Ingredient>& recipe, const std::unordered_map<IngredientId, int>& available,
+                 std::vector<Ingredient>& substituted, std::vector<Substitution>& substitutions) const;
+
+    /**
+     * @return The number of substitutions (edges).
+     */
+    size_t size() const;
+
+    /**
+     * @return True if the graph has no substitutions.
+     */
+    bool empty() const;
+
+    /**
+     * Removes every substitution.
+     */
+    void clear();
+
+    /**
+     * @return The heap bytes held by the graph and its candidates, estimated as in MemoryUsage.hpp.
+     */
+    size_t memoryUsage() const;
+
+private:
+    void refresh() const;
+
+    std::unordered_map<IngredientId, std::vector<Candidate>> edges_;   // direct substitutions
+    size_t edge_count_;
+    mutable bool stale_;                                                // candidates_ predates the last change
+    mutable std::unordered_map<IngredientId, std::vector<Candidate>> candidates_;
+};
+
+#endif // SUBSTITUTIONGRAPH_HPP
@@ -0,0 +1,135 @@
+/**
+ * @file alloc_guard.cpp
+ * @brief Checks that steady-state dispatch makes no heap allocations.
+ *
+ * Usage: alloc_guard [orders_per_round] [rounds]
+ *        (defaults: 1000 20)
+ *
+ * Links AllocationCounter.o, which counts every operator new. The demo kitchen starts with empty
+ * stations, so processAllDishes() also replenishes each order's station from the pantry; the
+ * prepareNextDish() phase, which does not replenish, gets its stock first. After one warm-up round
+ * of every phase, each round queues and dispatches the orders through addDishToQueue(),
+ * prepareNextDish() and processAllDishes() with a NullEventSink and a BinaryEventSink, counting
+ * the allocations of each phase. processAllDishes() into a stream without a buffer is reported
+ * too but not checked. Exits with status 1 if a checked phase allocated.
+ */
+
+#include "AllocationCounter.hpp"
+#include "DemoKitchen.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+struct Phase {
+    const char* label;
+    bool checked;
+    uint64_t allocations;
+    uint64_t bytes;
+};
+
+void queueOrders(StationManager& manager, const std::vector<Dish*>& menu, int orders) {
+    for (int i = 0; i < orders; ++i) {
+        manager.addDishToQueue(menu[i % menu.size()]);
+    }
+}
+
+// Stocks every station for `servings` of each of its dishes
+void stockStations(StationManager& manager, int servings) {
+    for (Node<KitchenStation*>* node = manager.getHeadNode(); node != nullptr; node = node->getNext()) {
+        KitchenStation* station = node->getItem();
+        for (const Dish* dish : station->getDishes()) {
+            for (const Ingredient& ingredient : dish->getIngredients()) {
+                manager.replenishStationIngredientFromBackup(station->getName(), ingredient.name,
+                                                             ingredient.required_quantity * servings);
+            }
+        }
+    }
+}
+}
+
+int main(int argc, char* argv[]) {
+    int orders = argc > 1 ? std::atoi(argv[1]) : 1000;
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 20;
+    if (orders < 1 || rounds < 1) {
+        std::fprintf(stderr, "usage: alloc_guard [orders_per_round] [rounds]\n");
+        return 2;
+    }
+
+    DemoKitchen kitchen;
+    StationManager& manager = kitchen.getManager();
+    std::vector<Dish*> menu = manager.getMenu();
+    manager.reserveDishQueue(orders);
+    std::vector<bool> results;
+    results.reserve(orders);
+    NullEventSink null_sink;
+    BinaryEventSink binary_sink;
+    binary_sink.reserve(static_cast<size_t>(orders) * 16);
+    std::ostream discard(nullptr);
+
+    Phase phases[] = {
+        {"addDishToQueue", true, 0, 0},
+        {"prepareNextDish", true, 0, 0},
+        {"processAllDishes(null)", true, 0, 0},
+        {"processAllDishes(binary)", true, 0, 0},
+        {"processAllDishes(ostream)", false, 0, 0},
+    };
+    long not_prepared = 0;
+    for (int round = 0; round <= rounds; ++round) {   // Round 0 warms up and is not counted
+        AllocationCounter counter;
+        auto finish = [&](Phase& phase) {
+            if (round > 0) {
+                phase.allocations += counter.getAllocations();
+                phase.bytes += counter.getBytes();
+            }
+        };
+
+        queueOrders(manager, menu, orders);
+        finish(phases[0]);
+
+        stockStations(manager, (orders + static_cast<int>(menu.size()) - 1) / static_cast<int>(menu.size()));
+        counter.restart();
+        for (int i = 0; i < orders; ++i) {
+            not_prepared += manager.prepareNextDish() ? 0 : 1;
+        }
+        finish(phases[1]);
+
+        queueOrders(manager, menu, orders);
+        results.clear();
+        counter.restart();
+        manager.processAllDishes(null_sink, &results);
+        finish(phases[2]);
+
+        queueOrders(manager, menu, orders);
+        binary_sink.clear();
+        results.clear();
+        counter.restart();
+        manager.processAllDishes(binary_sink, &results);
+        finish(phases[3]);
+
+        queueOrders(manager, menu, orders);
+        results.clear();
+        counter.restart();
+        manager.processAllDishes(discard, &results);
+        finish(phases[4]);
+    }
+
+    long counted = static_cast<long>(orders) * rounds;
+    bool clean = true;
+    std::printf("%d orders x %d rounds after warm-up (%zu events per binary round)\n", orders, rounds,
+                binary_sink.getEvents().size());
+    for (const Phase& phase : phases) {
+        std::printf("%-28s %10.4f allocations/order  %10.1f bytes/order%s\n", phase.label,
+                    static_cast<double>(phase.allocations) / counted, static_cast<double>(phase.bytes) / counted,
+                    phase.checked ? "" : "  (not checked)");
+        if (phase.checked && phase.allocations != 0) {
+            clean = false;
+        }
+    }
+    if (not_prepared != 0 || manager.getDishQueueSize() != 0) {
+        std::printf("FAIL: %ld orders were not prepared\n", not_prepared + static_cast<long>(manager.getDishQueueSize()));
+        return 1;
+    }
+    std::printf(clean ? "PASS: steady-state dispatch is allocation-free\n" : "FAIL: steady-state dispatch allocated\n");
+    return clean ? 0 : 1;
+}
@@ -0,0 +1,151 @@
+/**
+ * @file dish_name_bench.cpp
+ * @brief Autocomplete benchmark for StationManager::autocompleteDish().
+ *
+ * Usage: dish_name_bench [stations] [dishes_per_station] [lookups] [limit]
+ *        (defaults: 20 2500 20000 10)
+ *
+ * Assigns randomly named dishes to the stations, then resolves random typed prefixes (one to four
+ * characters, in mixed case) twice: once by scanning every station's dish names and once through
+ * the prefix index. The benchmark checks that both give the same dishes and stations and reports
+ * the average time per lookup.
+ */
+
+#include "Appetizer.hpp"
+#include "StationManager.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace {
+std::string lower(std::string text) {
+    for (char& c : text) {
+        if (c >= 'A' && c <= 'Z') {
+            c = c - 'A' + 'a';
+        }
+    }
+    return text;
+}
+
+// The scan the index replaces: every station, every dish, sorted at the end
+std::vector<DishNameIndex::Match> scan(const StationManager& manager, const std::string& prefix, size_t limit) {
+    std::string key = lower(prefix);
+    std::map<std::pair<std::string, std::string>, DishNameIndex::Match> found;
+    Node<KitchenStation*>* node = manager.getHeadNode();
+    while (node != nullptr) {
+        for (Dish* dish : node->getItem()->getDishes()) {
+            std::string name = lower(dish->getName());
+            if (name.compare(0, key.size(), key) == 0) {
+                DishNameIndex::Match& match = found[std::make_pair(name, dish->getName())];
+                match.dish_name = dish->getName();
+                match.stations.push_back(node->getItem());
+            }
+        }
+        node = node->getNext();
+    }
+    std::vector<DishNameIndex::Match> matches;
+    for (auto& entry : found) {
+        if (matches.size() == limit) {
+            break;
+        }
+        matches.push_back(entry.second);
+    }
+    return matches;
+}
+
+bool sameMatches(const std::vector<DishNameIndex::Match>& matches1, const std::vector<DishNameIndex::Match>& matches2) {
+    if (matches1.size() != matches2.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < matches1.size(); ++i) {
+        std::vector<const KitchenStation*> stations1 = matches1[i].stations;
+        std::vector<const KitchenStation*> stations2 = matches2[i].stations;
+        std::sort(stations1.begin(), stations1.end());
+        std::sort(stations2.begin(), stations2.end());
+        if (matches1[i].dish_name != matches2[i].dish_name || stations1 != stations2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string randomWord(std::mt19937& random, size_t length) {
+    std::string word;
+    for (size_t i = 0; i < length; ++i) {
+        char c = 'a' + random() % 26;
+        word += (random() % 4 == 0) ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+    return word;
+}
+}
+
+int main(int argc, char* argv[]) {
+    int station_count = argc > 1 ? std::atoi(argv[1]) : 20;
+    int dishes_per_station = argc > 2 ? std::atoi(argv[2]) : 2500;
+    int lookups = argc > 3 ? std::atoi(argv[3]) : 20000;
+    size_t limit = argc > 4 ? std::strtoul(argv[4], nullptr, 10) : 10;
+
+    std::mt19937 random(7);
+    StationManager manager;
+    std::vector<Appetizer*> dishes;   // Distinct dishes, owned by their stations
+    for (int s = 0; s < station_count; ++s) {
+        KitchenStation* station = new KitchenStation("Station " + std::to_string(s));
+        manager.addStation(station);
+        for (int d = 0; d < dishes_per_station; ++d) {
+            // Some dishes are also served by an earlier station; each station owns its own copy
+            if (s > 0 && random() % 8 == 0) {
+                station->assignDishToStation(new Appetizer(*dishes[random() % dishes.size()]));
+                continue;
+            }
+            std::string name = randomWord(random, 4 + random() % 6) + " " + randomWord(random, 5);
+            Appetizer* dish = new Appetizer(name, {}, 10, 9.99, Dish::OTHER, Appetizer::PLATED, 0, true);
+            dishes.push_back(dish);
+            station->assignDishToStation(dish);
+        }
+    }
+
+    std::vector<std::string> prefixes;
+    for (int i = 0; i < lookups; ++i) {
+        const std::string& name = dishes[random() % dishes.size()]->getName();
+        std::string prefix = name.substr(0, 1 + random() % 4);
+        prefixes.push_back(random() % 2 == 0 ? lower(prefix) : prefix);
+    }
+
+    using Clock = std::chrono::steady_clock;
+    int scan_lookups = std::min(lookups, 200);   // The scan is slow; time a sample of it
+    auto start = Clock::now();
+    std::vector<std::vector<DishNameIndex::Match>> expected;
+    for (int i = 0; i < scan_lookups; ++i) {
+        expected.push_back(scan(manager, prefixes[i], limit));
+    }
+    double scan_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / scan_lookups;
+
+    start = Clock::now();
+    size_t returned = 0;
+    for (int i = 0; i < lookups; ++i) {
+        returned += manager.autocompleteDish(prefixes[i], limit).size();
+    }
+    double index_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / lookups;
+
+    int mismatches = 0;
+    for (int i = 0; i < scan_lookups; ++i) {
+        mismatches += !sameMatches(expected[i], manager.autocompleteDish(prefixes[i], limit));
+    }
+
+    std::printf("%zu dishes on %d stations, %d lookups, %.1f matches per lookup\n", dishes.size(), station_count,
+                lookups, lookups > 0 ? static_cast<double>(returned) / lookups : 0.0);
+    std::printf("linear scan:  %10.2f us/lookup\n", scan_us);
+    std::printf("prefix index: %10.2f us/lookup\n", index_us);
+    std::printf("mismatched results: %d\n", mismatches);
+
+    while (!manager.isEmpty()) {
+        KitchenStation* station = manager.getEntry(0);
+        manager.removeStation(station->getName());
+        delete station;   // Also deletes the station's dishes
+    }
+    return mismatches == 0 ? 0 : 1;
+}
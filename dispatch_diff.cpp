@@ -0,0 +1,283 @@
+/**
+ * @file dispatch_diff.cpp
+ * @brief Differential test of the dispatch engines against the reference, processAllDishes().
+ *
+ * Usage: dispatch_diff [workloads] [orders] [seed]
+ *        (defaults: 50 4000 1)
+ *
+ * Each workload is a kitchen generated from the seed: stations in a random order, dishes assigned
+ * to one or more of them (sometimes with a station's own variant of the recipe), random station
+ * stock and a pantry too small for every order, so that shortfalls, partial replenishment and
+ * leftover orders all occur. Every engine gets its own copy of the kitchen and the same orders, in
+ * rounds of queueing and dispatching. After each round the station stock, pantry, leftover queue,
+ * results, revenue and event stream of each engine are compared with the reference's; the first
+ * difference is printed. Finally each engine's dispatch time is reported against the reference.
+ * Exits with status 1 if any engine differed.
+ */
+
+#include "Appetizer.hpp"
+#include "Dessert.hpp"
+#include "DispatchEngine.hpp"
+#include "MainCourse.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+const int ROUNDS = 4;
+
+// Alphabetic suffix, since dish names may only hold letters and spaces
+std::string letters(int index) {
+    std::string result;
+    do {
+        result.insert(result.begin(), static_cast<char>('A' + index % 26));
+        index = index / 26 - 1;
+    } while (index >= 0);
+    return result;
+}
+
+Dish* makeDish(int kind, const std::string& name, const std::vector<Ingredient>& recipe, double price) {
+    if (kind == 0) {
+        return new Appetizer(name, recipe, 10, price, Dish::OTHER, Appetizer::PLATED, 0, false);
+    }
+    if (kind == 1) {
+        return new MainCourse(name, recipe, 20, price, Dish::OTHER, MainCourse::GRILLED, "None", {}, false);
+    }
+    return new Dessert(name, recipe, 15, price, Dish::OTHER, Dessert::SWEET, 5, false);
+}
+
+/**
+ * A generated kitchen. Building two from the same seed gives identical kitchens.
+ */
+class Workload {
+public:
+    Workload(unsigned seed, int orders) {
+        std::mt19937 rng(seed);
+        auto uniform = [&rng](int low, int high) { return std::uniform_int_distribution<int>(low, high)(rng); };
+
+        int ingredient_count = uniform(3, 10);
+        std::vector<std::string> ingredients;
+        for (int i = 0; i < ingredient_count; ++i) {
+            ingredients.push_back("Ingredient " + letters(i));
+        }
+
+        int station_count = uniform(1, 6);
+        for (int i = 0; i < station_count; ++i) {
+            KitchenStation* station = new KitchenStation("Station " + letters(i));
+            for (const std::string& ingredient : ingredients) {
+                if (uniform(0, 2) == 0) {
+                    station->replenishStationIngredients(Ingredient(ingredient, uniform(1, 8), 0, Money::fromCents(uniform(10, 500))));
+                }
+            }
+            stations_.push_back(station);
+            manager_.addStation(station);
+        }
+
+        int dish_count = uniform(2, 12);
+        for (int d = 0; d < dish_count; ++d) {
+            std::string name = "Dish " + letters(d);
+            int kind = uniform(0, 2);
+            double price = uniform(100, 3000) / 100.0;
+            std::vector<Ingredient> recipe;
+            int lines = uniform(1, 4);
+            for (int l = 0; l < lines; ++l) {
+                recipe.push_back(Ingredient(ingredients[uniform(0, ingredient_count - 1)], 0, uniform(1, 3), 0.0));
+            }
+            menu_.emplace_back(makeDish(kind, name, recipe, price));
+
+            // Most dishes are served somewhere, some by several stations, some nowhere
+            for (KitchenStation* station : stations_) {
+                if (uniform(0, 2) != 0) {
+                    continue;
+                }
+                std::vector<Ingredient> variant = recipe;
+                if (uniform(0, 4) == 0) { // The station's own take on the recipe
+                    variant[uniform(0, lines - 1)].required_quantity = uniform(1, 4);
+                }
+                manager_.assignDishToStation(station->getName(), makeDish(kind, name, variant, price));
+            }
+        }
+
+        for (const std::string& ingredient : ingredients) {
+            manager_.addBackupIngredient(Ingredient(ingredient, uniform(0, orders / 2), 0, Money::fromCents(uniform(10, 500))));
+        }
+        for (int i = 0; i < orders; ++i) {
+            orders_.push_back(menu_[uniform(0, dish_count - 1)].get());
+        }
+    }
+
+    ~Workload() {
+        for (KitchenStation* station : stations_) {
+            delete station;
+        }
+    }
+
+    StationManager& getManager() {
+        return manager_;
+    }
+
+    /**
+     * Queues the orders of one round.
+     */
+    void queueRound(int round) {
+        size_t begin = orders_.size() * round / ROUNDS;
+        size_t end = orders_.size() * (round + 1) / ROUNDS;
+        for (size_t i = begin; i < end; ++i) {
+            manager_.addDishToQueue(orders_[i]);
+        }
+    }
+
+private:
+    StationManager manager_;
+    std::vector<KitchenStation*> stations_;
+    std::vector<std::unique_ptr<Dish>> menu_;   // the dishes orders are placed for
+    std::vector<Dish*> orders_;
+};
+
+const char* nameOf(const KitchenStation* station) {
+    return station != nullptr ? station->getName().c_str() : "-";
+}
+
+const char* nameOf(const Dish* dish) {
+    return dish != nullptr ? dish->getName().c_str() : "-";
+}
+
+// Compares an engine's kitchen after a round with the reference's; prints the first difference
+bool sameOutcome(StationManager& reference, StationManager& candidate, const BinaryEventSink& reference_events,
+                 const BinaryEventSink& candidate_events, const std::vector<bool>& reference_results,
+                 const std::vector<bool>& candidate_results, std::string& difference) {
+    char line[512];
+    const std::vector<KitchenEvent>& expected = reference_events.getEvents();
+    const std::vector<KitchenEvent>& actual = candidate_events.getEvents();
+    for (size_t i = 0; i < expected.size() || i < actual.size(); ++i) {
+        if (i >= expected.size() || i >= actual.size()) {
+            std::snprintf(line, sizeof(line), "event stream: %zu events, reference has %zu", actual.size(), expected.size());
+            difference = line;
+            return false;
+        }
+        const KitchenEvent& a = actual[i];
+        const KitchenEvent& e = expected[i];
+        if (a.kind != e.kind || a.original != e.original || a.substitute != e.substitute ||
+            std::string(nameOf(a.station)) != nameOf(e.station) || std::string(nameOf(a.dish)) != nameOf(e.dish)) {
+            std::snprintf(line, sizeof(line), "event %zu: kind %d station %s dish %s, reference kind %d station %s dish %s",
+                          i, a.kind, nameOf(a.station), nameOf(a.dish), e.kind, nameOf(e.station), nameOf(e.dish));
+            difference = line;
+            return false;
+        }
+    }
+    if (candidate_results != reference_results) {
+        difference = "results";
+        return false;
+    }
+
+    Node<KitchenStation*>* e = reference.getHeadNode();
+    Node<KitchenStation*>* a = candidate.getHeadNode();
+    for (; e != nullptr && a != nullptr; e = e->getNext(), a = a->getNext()) {
+        const std::vector<StockLine>& expected_stock = e->getItem()->getStockLines();
+        const std::vector<StockLine>& actual_stock = a->getItem()->getStockLines();
+        bool same = expected_stock.size() == actual_stock.size();
+        for (size_t i = 0; same && i < expected_stock.size(); ++i) {
+            same = expected_stock[i].id == actual_stock[i].id && expected_stock[i].quantity == actual_stock[i].quantity &&
+                   expected_stock[i].price == actual_stock[i].price;
+        }
+        if (!same) {
+            difference = "stock of " + e->getItem()->getName();
+            return false;
+        }
+    }
+
+    std::vector<Ingredient> expected_pantry = reference.getBackupIngredients();
+    std::vector<Ingredient> actual_pantry = candidate.getBackupIngredients();
+    bool same = expected_pantry.size() == actual_pantry.size();
+    for (size_t i = 0; same && i < expected_pantry.size(); ++i) {
+        same = expected_pantry[i].name == actual_pantry[i].name && expected_pantry[i].quantity == actual_pantry[i].quantity &&
+               expected_pantry[i].price == actual_pantry[i].price;
+    }
+    if (!same) {
+        difference = "pantry";
+        return false;
+    }
+
+    std::queue<Dish*> expected_queue = reference.getDishQueue();
+    std::queue<Dish*> actual_queue = candidate.getDishQueue();
+    same = expected_queue.size() == actual_queue.size();
+    for (; same && !expected_queue.empty(); expected_queue.pop(), actual_queue.pop()) {
+        same = expected_queue.front()->getName() == actual_queue.front()->getName();
+    }
+    if (!same) {
+        difference = "leftover queue";
+        return false;
+    }
+
+    if (candidate.getRevenueCents() != reference.getRevenueCents() || candidate.getCostOfGoodsCents() != reference.getCostOfGoodsCents()) {
+        difference = "revenue or cost of goods";
+        return false;
+    }
+    return true;
+}
+}
+
+int main(int argc, char* argv[]) {
+    int workloads = argc > 1 ? std::atoi(argv[1]) : 50;
+    int orders = argc > 2 ? std::atoi(argv[2]) : 4000;
+    unsigned seed = argc > 3 ? static_cast<unsigned>(std::strtoul(argv[3], nullptr, 10)) : 1;
+    if (workloads < 1 || orders < ROUNDS) {
+        std::fprintf(stderr, "usage: dispatch_diff [workloads] [orders] [seed]\n");
+        return 2;
+    }
+
+    std::vector<std::unique_ptr<DispatchEngine>> engines;
+    engines.emplace_back(new ReferenceEngine());   // engines[0] is the oracle
+    engines.emplace_back(new IndexedEngine());
+    std::vector<double> seconds(engines.size(), 0.0);
+    std::vector<long> failures(engines.size(), 0);
+
+    long events = 0;
+    for (int w = 0; w < workloads; ++w) {
+        unsigned workload_seed = seed + static_cast<unsigned>(w);
+        std::vector<std::unique_ptr<Workload>> kitchens;
+        for (size_t e = 0; e < engines.size(); ++e) {
+            kitchens.emplace_back(new Workload(workload_seed, orders));
+        }
+        std::vector<bool> failed(engines.size(), false);
+        for (int round = 0; round < ROUNDS; ++round) {
+            std::vector<BinaryEventSink> sinks(engines.size());
+            std::vector<std::vector<bool>> results(engines.size());
+            for (size_t e = 0; e < engines.size(); ++e) {
+                kitchens[e]->queueRound(round);
+                sinks[e].reserve(static_cast<size_t>(orders) * 16);
+                results[e].reserve(orders);
+                auto start = std::chrono::steady_clock::now();
+                engines[e]->dispatch(kitchens[e]->getManager(), sinks[e], &results[e]);
+                seconds[e] += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            }
+            events += static_cast<long>(sinks[0].getEvents().size());
+            for (size_t e = 1; e < engines.size(); ++e) {
+                std::string difference;
+                if (!failed[e] && !sameOutcome(kitchens[0]->getManager(), kitchens[e]->getManager(), sinks[0], sinks[e],
+                                               results[0], results[e], difference)) {
+                    std::printf("MISMATCH %s, workload seed %u, round %d: %s\n", engines[e]->getName(), workload_seed, round,
+                                difference.c_str());
+                    failed[e] = true;
+                    ++failures[e];
+                }
+            }
+        }
+    }
+
+    std::printf("%d workloads x %d orders, %ld reference events\n", workloads, orders, events);
+    for (size_t e = 0; e < engines.size(); ++e) {
+        std::printf("%-12s %10.1f ns/order  %6.2fx  %s\n", engines[e]->getName(), 1e9 * seconds[e] / (static_cast<double>(workloads) * orders),
+                    seconds[0] / seconds[e], e == 0 ? "(oracle)" : failures[e] == 0 ? "matches" : "DIFFERS");
+    }
+    for (size_t e = 1; e < engines.size(); ++e) {
+        if (failures[e] != 0) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file federation_bench.cpp
+ * @brief Multi-kitchen benchmark for KitchenFederation.
+ *
+ * Usage: federation_bench [kitchens] [orders] [batch_quantity]
+ *        (defaults: 4 200000 64)
+ *
+ * Runs several demo kitchens in one process. Kitchen 0 starts with a nearly empty pantry and the
+ * others are well stocked. The same order stream runs once with isolated kitchens and once per
+ * routing policy with federation transfers. The benchmark reports the fill rate, throughput,
+ * the stock moved between kitchens, and the heap allocations per order of the routing and
+ * dispatch phases (counted by AllocationCounter, warm-up included).
+ */
+
+#include "AllocationCounter.hpp"
+#include "DemoKitchen.hpp"
+#include "KitchenFederation.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+namespace {
+struct RunResult {
+    long prepared;
+    double seconds;
+    unsigned long transfers;
+    unsigned long units;
+    uint64_t routing_allocations;
+    uint64_t dispatch_allocations;
+};
+
+RunResult run(int kitchen_count, long orders, int batch_quantity, bool federated, KitchenFederation::RoutingPolicy policy) {
+    std::vector<std::unique_ptr<DemoKitchen>> kitchens;
+    KitchenFederation federation(policy, batch_quantity);
+    for (int i = 0; i < kitchen_count; ++i) {
+        kitchens.emplace_back(new DemoKitchen(i == 0 ? 50 : static_cast<int>(orders)));
+        if (federated) {
+            federation.addKitchen("Kitchen " + std::to_string(i), &kitchens[i]->getManager());
+        }
+    }
+
+    std::vector<std::vector<Dish*>> menus;
+    for (auto& kitchen : kitchens) {
+        menus.push_back(kitchen->getManager().getMenu());
+    }
+
+    std::ostream discard(nullptr);
+    std::vector<bool> results;
+    results.reserve(orders);
+    const long BATCH = 256;
+    uint64_t routing_allocations = 0;
+    uint64_t dispatch_allocations = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (long base = 0; base < orders; base += BATCH) {
+        AllocationCounter counter;
+        for (long i = base; i < base + BATCH && i < orders; ++i) {
+            int home = i % kitchen_count;
+            Dish* dish = menus[home][i % menus[home].size()];
+            if (federated) {
+                federation.routeOrder(dish, home);
+            } else {
+                kitchens[home]->getManager().addDishToQueue(dish);
+            }
+        }
+        routing_allocations += counter.getAllocations();
+        counter.restart();
+        for (auto& kitchen : kitchens) {
+            kitchen->getManager().processAllDishes(discard, &results);
+        }
+        dispatch_allocations += counter.getAllocations();
+        for (auto& kitchen : kitchens) {
+            kitchen->getManager().setDishQueue(std::queue<Dish*>()); // A failed order is a lost sale
+        }
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    long prepared = 0;
+    for (bool result : results) {
+        prepared += result ? 1 : 0;
+    }
+    return RunResult{prepared, seconds, federation.getTransferCount(), federation.getUnitsTransferred(),
+                     routing_allocations, dispatch_allocations};
+}
+
+void report(const char* label, long orders, const RunResult& result) {
+    std::printf("%-26s fill %6.2f%%  %9.0f orders/s  %6lu transfers  %9lu units moved"
+                "  allocations/order: routing %.3f, dispatch %.3f\n", label,
+                100.0 * result.prepared / orders, orders / result.seconds, result.transfers, result.units,
+                static_cast<double>(result.routing_allocations) / orders,
+                static_cast<double>(result.dispatch_allocations) / orders);
+}
+}
+
+int main(int argc, char* argv[]) {
+    int kitchens = argc > 1 ? std::atoi(argv[1]) : 4;
+    long orders = argc > 2 ? std::atol(argv[2]) : 200000;
+    int batch_quantity = argc > 3 ? std::atoi(argv[3]) : 64;
+    if (kitchens < 2 || orders <= 0 || batch_quantity <= 0) {
+        std::fprintf(stderr, "usage: federation_bench [kitchens >= 2] [orders] [batch_quantity]\n");
+        return 2;
+    }
+
+    std::printf("%d kitchens, %ld orders, transfer batch %d units\n", kitchens, orders, batch_quantity);
+    report("isolated kitchens", orders, run(kitchens, orders, batch_quantity, false, KitchenFederation::HOME_FIRST));
+    report("federated, home first", orders, run(kitchens, orders, batch_quantity, true, KitchenFederation::HOME_FIRST));
+    report("federated, round robin", orders, run(kitchens, orders, batch_quantity, true, KitchenFederation::ROUND_ROBIN));
+    report("federated, least loaded", orders, run(kitchens, orders, batch_quantity, true, KitchenFederation::LEAST_LOADED));
+    return 0;
+}
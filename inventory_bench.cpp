@@ -0,0 +1,102 @@
+/**
+ * @file inventory_bench.cpp
+ * @brief Compares the Inventory lookup and locking policies on a stock-like workload.
+ *
+ * Usage: inventory_bench [operations] [seed]
+ *        (defaults: 2000000 1)
+ *
+ * For stocks of several sizes, the same seeded operations (half quantity lookups, a quarter adds,
+ * a quarter partial takes, so lines are often erased at zero and added again) run against every
+ * policy. Prints the time per operation, and checks that every policy read the same quantities and
+ * ended with the same lines in the same order; exits with status 1 if one did not.
+ */
+
+#include "Inventory.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+const int STOCK_SIZES[] = {4, 16, 64, 256};
+
+struct Operation {
+    enum Kind { LOOKUP, ADD, TAKE } kind;
+    uint32_t key;
+    int quantity;
+};
+
+std::vector<Operation> makeOperations(int count, int keys, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::vector<Operation> operations;
+    operations.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        int roll = static_cast<int>(rng() % 4);
+        Operation::Kind kind = roll < 2 ? Operation::LOOKUP : roll == 2 ? Operation::ADD : Operation::TAKE;
+        operations.push_back(Operation{kind, static_cast<uint32_t>(rng() % keys), static_cast<int>(rng() % 3) + 1});
+    }
+    return operations;
+}
+
+// Runs the operations; returns a checksum of the quantities read and the final lines
+template <typename Stock>
+uint64_t run(Stock& stock, const std::vector<Operation>& operations, int keys, double& seconds) {
+    for (int key = 0; key < keys; ++key) {
+        stock.add(static_cast<uint32_t>(key), 5, Money::fromCents(100 + key));
+    }
+    uint64_t checksum = 0;
+    typename Stock::Change change;
+    auto start = std::chrono::steady_clock::now();
+    for (const Operation& operation : operations) {
+        if (operation.kind == Operation::LOOKUP) {
+            checksum += static_cast<uint64_t>(stock.getQuantity(operation.key));
+        } else if (operation.kind == Operation::ADD) {
+            checksum += static_cast<uint64_t>(stock.add(operation.key, operation.quantity, Money::fromCents(100)).before);
+        } else if (stock.takeUpTo(operation.key, operation.quantity, change)) {
+            checksum += static_cast<uint64_t>(change.after);
+        }
+    }
+    seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (const typename Stock::Line& line : stock.getLines()) {
+        checksum = checksum * 1000003u + line.id * 31u + static_cast<uint64_t>(line.quantity);
+    }
+    return checksum;
+}
+
+template <template <typename> class Lookup, typename Locking>
+bool measure(const char* name, const std::vector<Operation>& operations, int keys, uint64_t& expected) {
+    Inventory<uint32_t, int, Lookup, Locking> stock;
+    double seconds = 0.0;
+    uint64_t checksum = run(stock, operations, keys, seconds);
+    if (expected == 0) {
+        expected = checksum;
+    }
+    std::printf("  %-22s %8.2f ns/op  %6zu bytes  %s\n", name, 1e9 * seconds / operations.size(), stock.getHeapBytes(),
+                checksum == expected ? "" : "DIFFERS");
+    return checksum == expected;
+}
+}
+
+int main(int argc, char* argv[]) {
+    int count = argc > 1 ? std::atoi(argv[1]) : 2000000;
+    unsigned seed = argc > 2 ? static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10)) : 1;
+    if (count < 1) {
+        std::fprintf(stderr, "usage: inventory_bench [operations] [seed]\n");
+        return 2;
+    }
+
+    bool same = true;
+    for (int keys : STOCK_SIZES) {
+        std::vector<Operation> operations = makeOperations(count, keys, seed);
+        uint64_t expected = 0;
+        std::printf("%d keys, %d operations\n", keys, count);
+        same &= measure<LinearLookup, NoLocking>("linear", operations, keys, expected);
+        same &= measure<DenseLookup, NoLocking>("dense", operations, keys, expected);
+        same &= measure<OpenHashLookup, NoLocking>("open hash", operations, keys, expected);
+        same &= measure<SortedLookup, NoLocking>("sorted", operations, keys, expected);
+        same &= measure<LinearLookup, MutexLocking>("linear + mutex", operations, keys, expected);
+        same &= measure<DenseLookup, MutexLocking>("dense + mutex", operations, keys, expected);
+    }
+    return same ? 0 : 1;
+}
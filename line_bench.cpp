@@ -0,0 +1,180 @@
+/**
+ * @file line_bench.cpp
+ * @brief Memory and cache-miss comparison of Ingredient lines against the compact RecipeLine and
+ * StockLine types.
+ *
+ * Usage: line_bench [lines] [distinct_ingredients]
+ *        (defaults: 1000000 1000)
+ *
+ * Builds the same stock three ways: Ingredient lines (name, quantity, required quantity and
+ * price), StockLine lines and RecipeLine lines. Each is scanned for one ingredient, the way a
+ * station looks up its stock, and summed by value. The benchmark reports the bytes per line, the
+ * time per line and the last-level cache misses per line, read through perf_event_open (n/a when
+ * the kernel does not allow it).
+ */
+
+#include "Dish.hpp"
+#include "MemoryUsage.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+const int ROUNDS = 5;
+
+// Counts last-level cache misses of this thread; reads -1 when perf events are unavailable
+class CacheMissCounter {
+public:
+    CacheMissCounter() {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+    }
+    ~CacheMissCounter() {
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+    void start() {
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+    long long stop() {
+        long long count = -1;
+        if (fd_ >= 0) {
+            ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd_, &count, sizeof(count)) != sizeof(count)) {
+                count = -1;
+            }
+        }
+        return count;
+    }
+
+private:
+    int fd_;
+};
+
+// Runs the scan ROUNDS times and prints the best time and the misses of that round, per line
+void measure(const char* label, size_t lines, size_t bytes, const std::function<long long()>& scan) {
+    CacheMissCounter counter;
+    double best_ns = 0.0;
+    long long best_misses = -1;
+    long long checksum = 0;
+    for (int round = 0; round < ROUNDS; ++round) {
+        counter.start();
+        auto start = std::chrono::steady_clock::now();
+        checksum += scan();
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        long long misses = counter.stop();
+        if (round == 0 || ns < best_ns) {
+            best_ns = ns;
+            best_misses = misses;
+        }
+    }
+    char misses[32];
+    if (best_misses < 0) {
+        std::snprintf(misses, sizeof(misses), "%s", "n/a");
+    } else {
+        std::snprintf(misses, sizeof(misses), "%.4f", static_cast<double>(best_misses) / lines);
+    }
+    std::printf("%-26s %7.1f bytes/line  %6.2f ns/line  %8s LLC misses/line  (checksum %lld)\n", label,
+                static_cast<double>(bytes) / lines, best_ns / lines, misses, checksum);
+}
+}
+
+int main(int argc, char* argv[]) {
+    long line_count = argc > 1 ? std::atol(argv[1]) : 1000000;
+    int distinct = argc > 2 ? std::atoi(argv[2]) : 1000;
+    if (line_count < 1 || distinct < 1) {
+        std::fprintf(stderr, "usage: line_bench [lines] [distinct_ingredients]\n");
+        return 1;
+    }
+    size_t lines = static_cast<size_t>(line_count);
+
+    std::vector<std::string> names;
+    for (int i = 0; i < distinct; ++i) {
+        names.push_back("Ingredient number " + std::to_string(i));   // Longer than the inline buffer
+    }
+    std::vector<Ingredient> ingredients;
+    std::vector<StockLine> stock;
+    std::vector<RecipeLine> recipe;
+    ingredients.reserve(lines);
+    stock.reserve(lines);
+    recipe.reserve(lines);
+    for (size_t i = 0; i < lines; ++i) {
+        Ingredient ingredient(names[(i * 7919) % distinct], static_cast<int>(i % 47) + 1, static_cast<int>(i % 7) + 1,
+                              Money::fromCents(static_cast<int64_t>(25 + i % 100)));
+        ingredients.push_back(ingredient);
+        stock.push_back(toStockLine(ingredient));
+        recipe.push_back(toRecipeLine(ingredient));
+    }
+
+    size_t ingredient_bytes = heapBytes(ingredients);
+    for (const Ingredient& ingredient : ingredients) {
+        ingredient_bytes += heapBytes(ingredient.name);
+    }
+    const std::string& target_name = names[distinct / 2];
+    IngredientId target = IngredientRegistry::instance().intern(target_name);
+
+    std::printf("%zu lines, %d distinct ingredients (sizeof Ingredient %zu, StockLine %zu, RecipeLine %zu)\n",
+                lines, distinct, sizeof(Ingredient), sizeof(StockLine), sizeof(RecipeLine));
+    std::printf("lookup: quantity of one ingredient\n");
+    measure("  Ingredient by name", lines, ingredient_bytes, [&]() {
+        long long quantity = 0;
+        for (const Ingredient& ingredient : ingredients) {
+            if (ingredient.name == target_name) {
+                quantity += ingredient.quantity;
+            }
+        }
+        return quantity;
+    });
+    measure("  StockLine by id", lines, heapBytes(stock), [&]() {
+        long long quantity = 0;
+        for (const StockLine& line : stock) {
+            if (line.id == target) {
+                quantity += line.quantity;
+            }
+        }
+        return quantity;
+    });
+    measure("  RecipeLine by id", lines, heapBytes(recipe), [&]() {
+        long long required = 0;
+        for (const RecipeLine& line : recipe) {
+            if (line.id == target) {
+                required += line.required;
+            }
+        }
+        return required;
+    });
+    std::printf("valuation: sum of quantity * price\n");
+    measure("  Ingredient", lines, ingredient_bytes, [&]() {
+        Money value;
+        for (const Ingredient& ingredient : ingredients) {
+            value += ingredient.getPriceMoney() * ingredient.quantity;
+        }
+        return static_cast<long long>(value.getCents());
+    });
+    measure("  StockLine", lines, heapBytes(stock), [&]() {
+        Money value;
+        for (const StockLine& line : stock) {
+            value += line.price * line.quantity;
+        }
+        return static_cast<long long>(value.getCents());
+    });
+    return 0;
+}
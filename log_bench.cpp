@@ -0,0 +1,103 @@
+/**
+ * @file log_bench.cpp
+ * @brief Compares formatting the preparation log on the dispatch thread with handing it to an
+ * AsyncEventSink writer thread.
+ *
+ * Usage: log_bench [orders] [batch] [drop_ring]
+ *        (defaults: 100000 256 1024)
+ *
+ * Dispatches the demo kitchen's menu in batches three times, each time into its own string stream:
+ * through a TextEventSink, through an AsyncEventSink that blocks when its ring is full, and through
+ * an AsyncEventSink with a small ring (drop_ring events) that drops on overflow. For each it prints
+ * the dispatch thread's time per order and the time until the log is fully written. The blocking
+ * log must match the TextEventSink log byte for byte; exits with status 1 if it does not.
+ */
+
+#include "AsyncEventSink.hpp"
+#include "DemoKitchen.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <vector>
+
+namespace {
+struct Timing {
+    double dispatch;   // seconds spent in processAllDishes()
+    double total;      // seconds until the log was fully written
+};
+
+// Queues `orders` orders in batches and dispatches each batch into `events`
+Timing run(StationManager& manager, long orders, long batch, EventSink& events, AsyncEventSink* async) {
+    std::vector<Dish*> menu = manager.getMenu();
+    manager.reserveDishQueue(batch);
+    std::vector<bool> results;
+    results.reserve(batch);
+    std::chrono::steady_clock::duration dispatch(0);
+    auto start = std::chrono::steady_clock::now();
+    for (long base = 0; base < orders; base += batch) {
+        for (long i = base; i < base + batch && i < orders; ++i) {
+            manager.addDishToQueue(menu[i % menu.size()]);
+        }
+        results.clear();
+        auto batch_start = std::chrono::steady_clock::now();
+        manager.processAllDishes(events, &results);
+        dispatch += std::chrono::steady_clock::now() - batch_start;
+    }
+    if (async != nullptr) {
+        async->flush();
+    }
+    Timing timing;
+    timing.dispatch = std::chrono::duration<double>(dispatch).count();
+    timing.total = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return timing;
+}
+
+void report(const char* label, const Timing& timing, long orders, size_t bytes) {
+    std::printf("%-22s %10.1f ns/order dispatch %10.1f ns/order written %10zu bytes\n", label,
+                1e9 * timing.dispatch / orders, 1e9 * timing.total / orders, bytes);
+}
+}
+
+int main(int argc, char* argv[]) {
+    long orders = argc > 1 ? std::atol(argv[1]) : 100000;
+    long batch = argc > 2 ? std::atol(argv[2]) : 256;
+    long drop_ring = argc > 3 ? std::atol(argv[3]) : 1024;
+    if (orders < 1 || batch < 1 || drop_ring < 1) {
+        std::fprintf(stderr, "usage: log_bench [orders] [batch] [drop_ring]\n");
+        return 2;
+    }
+
+    std::ostringstream text_log;
+    DemoKitchen text_kitchen;
+    TextEventSink text_sink(text_log);
+    Timing text = run(text_kitchen.getManager(), orders, batch, text_sink, nullptr);
+
+    std::ostringstream block_log;
+    DemoKitchen block_kitchen;
+    AsyncEventSink block_sink(block_log);
+    Timing block = run(block_kitchen.getManager(), orders, batch, block_sink, &block_sink);
+
+    std::ostringstream drop_log;
+    DemoKitchen drop_kitchen;
+    AsyncEventSink drop_sink(drop_log, drop_ring, AsyncEventSink::DROP);
+    Timing drop = run(drop_kitchen.getManager(), orders, batch, drop_sink, &drop_sink);
+
+    std::printf("%ld orders, batches of %ld\n", orders, batch);
+    report("text sink", text, orders, text_log.str().size());
+    report("async sink (block)", block, orders, block_log.str().size());
+    std::printf("%-22s %10llu events, %llu waited for room (ring %zu)\n", "",
+                static_cast<unsigned long long>(block_sink.getRecordedCount()),
+                static_cast<unsigned long long>(block_sink.getBlockedCount()), block_sink.getCapacity());
+    report("async sink (drop)", drop, orders, drop_log.str().size());
+    std::printf("%-22s %10llu events, %llu dropped (ring %zu)\n", "",
+                static_cast<unsigned long long>(drop_sink.getRecordedCount()),
+                static_cast<unsigned long long>(drop_sink.getDroppedCount()), drop_sink.getCapacity());
+
+    if (block_log.str() != text_log.str()) {
+        std::printf("FAIL: the async log differs from the text log\n");
+        return 1;
+    }
+    std::printf("PASS: the async log matches the text log\n");
+    return 0;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file memory_bench.cpp
+ * @brief Memory footprint report for StationManager::memoryUsage().
+ *
+ * Usage: memory_bench [stations] [dishes_per_station] [queued_orders]
+ *        (defaults: 50 20 10000)
+ *
+ * Builds a kitchen in three steps: empty stations, then dishes of three ingredients each with the
+ * stations stocked for them, then a queue of orders. The benchmark reports the breakdown of the
+ * full kitchen and the bytes each step adds per station, per dish and per queued order, so that
+ * layout changes show up as a change in these figures.
+ */
+
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include "StationManager.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+// Dish names may only hold letters and spaces
+std::string letters(int number) {
+    std::string word;
+    do {
+        word += static_cast<char>('a' + number % 26);
+        number /= 26;
+    } while (number > 0);
+    return word;
+}
+
+void printBreakdown(const MemoryUsage& usage) {
+    const struct {
+        const char* label;
+        size_t bytes;
+    } rows[] = {
+        {"objects", usage.objects}, {"list nodes", usage.nodes}, {"strings", usage.strings},
+        {"ingredient vectors", usage.ingredients}, {"queue", usage.queue}, {"pantry", usage.pantry},
+        {"indexes", usage.indexes},
+    };
+    for (const auto& row : rows) {
+        std::printf("  %-20s %12zu bytes  %5.1f%%\n", row.label, row.bytes,
+                    usage.total() > 0 ? 100.0 * row.bytes / usage.total() : 0.0);
+    }
+    std::printf("  %-20s %12zu bytes\n", "total", usage.total());
+}
+}
+
+int main(int argc, char* argv[]) {
+    int station_count = argc > 1 ? std::atoi(argv[1]) : 50;
+    int dishes_per_station = argc > 2 ? std::atoi(argv[2]) : 20;
+    int queued_orders = argc > 3 ? std::atoi(argv[3]) : 10000;
+    if (station_count < 1 || dishes_per_station < 1 || queued_orders < 1) {
+        std::fprintf(stderr, "usage: memory_bench [stations] [dishes_per_station] [queued_orders]\n");
+        return 1;
+    }
+
+    StationManager manager;
+    for (const char* ingredient : {"Flour", "Butter", "Sugar", "Tomato", "Basil"}) {
+        manager.addBackupIngredient(Ingredient(ingredient, 1000, 0, 0.5));
+    }
+    size_t empty = manager.memoryUsage().total();
+
+    std::vector<KitchenStation*> stations;
+    for (int s = 0; s < station_count; ++s) {
+        KitchenStation* station = new KitchenStation("Station " + std::to_string(s));
+        stations.push_back(station);
+        manager.addStation(station);
+    }
+    size_t with_stations = manager.memoryUsage().total();
+
+    std::vector<Dish*> menu;
+    for (int s = 0; s < station_count; ++s) {
+        for (int d = 0; d < dishes_per_station; ++d) {
+            std::string name = "Dish " + letters(s * dishes_per_station + d);
+            std::vector<Ingredient> recipe = {Ingredient("Flour", 0, 2, 0.5), Ingredient("Butter", 0, 1, 0.5),
+                                              Ingredient("Tomato " + letters(d), 0, 1, 0.25)};
+            Dish* dish = d % 2 == 0
+                ? static_cast<Dish*>(new Appetizer(name, recipe, 10, 7.99, Dish::OTHER, Appetizer::PLATED, 1, true))
+                : static_cast<Dish*>(new MainCourse(name, recipe, 20, 14.99, Dish::OTHER, MainCourse::BAKED, "Chicken",
+                                                    {{"Side Salad", MainCourse::SALAD}}, false));
+            manager.assignDishToStation(stations[s]->getName(), dish);
+            menu.push_back(dish);
+        }
+        manager.replenishIngredientAtStation(stations[s]->getName(), Ingredient("Flour", 100, 0, 0.5));
+        manager.replenishIngredientAtStation(stations[s]->getName(), Ingredient("Butter", 100, 0, 0.5));
+        for (int d = 0; d < dishes_per_station; ++d) {
+            manager.replenishIngredientAtStation(stations[s]->getName(), Ingredient("Tomato " + letters(d), 100, 0, 0.25));
+        }
+    }
+    size_t with_dishes = manager.memoryUsage().total();
+
+    for (int i = 0; i < queued_orders; ++i) {
+        manager.addDishToQueue(menu[i % menu.size()]);
+    }
+    MemoryUsage full = manager.memoryUsage();
+
+    int dish_count = station_count * dishes_per_station;
+    std::printf("%d stations, %d dishes, %d queued orders\n", station_count, dish_count, queued_orders);
+    printBreakdown(full);
+    std::printf("empty manager        %10zu bytes\n", empty);
+    std::printf("per station          %10.1f bytes (empty station)\n", static_cast<double>(with_stations - empty) / station_count);
+    std::printf("per dish             %10.1f bytes (dish, its stock lines and index entries)\n",
+                static_cast<double>(with_dishes - with_stations) / dish_count);
+    std::printf("per queued order     %10.1f bytes\n", static_cast<double>(full.total() - with_dishes) / queued_orders);
+
+    manager.setDishQueue(std::queue<Dish*>());
+    for (KitchenStation* station : stations) {
+        manager.removeStation(station->getName());
+        delete station;   // Also deletes the station's dishes
+    }
+    return 0;
+}
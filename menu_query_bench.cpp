@@ -0,0 +1,180 @@
+/**
+ * @file menu_query_bench.cpp
+ * @brief Filter benchmark for MenuIndex.
+ *
+ * Usage: menu_query_bench [dishes] [queries]
+ *        (defaults: 100000 2000)
+ *
+ * Builds a random menu of appetizers, main courses and desserts, then runs the same random
+ * conjunctive queries twice: once as a linear scan over the dishes (dynamic_cast and virtual
+ * accessors per dish) and once through MenuIndex. The benchmark checks that both return the same
+ * number of matches and reports queries per second for each.
+ */
+
+#include "Appetizer.hpp"
+#include "Dessert.hpp"
+#include "MainCourse.hpp"
+#include "MenuIndex.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+// The same predicates as MenuIndex::Query, kept in plain form for the scan
+struct Filter {
+    int cuisine;         // -1 = any
+    int course;          // -1 = any
+    int vegetarian;      // 0 = any, 1 = yes, 2 = no
+    bool has_price;
+    double price_low, price_high;
+    bool has_prep_time;
+    int prep_low, prep_high;
+    bool has_spiciness;
+    int spicy_low, spicy_high;
+
+    MenuIndex::Query toQuery() const {
+        MenuIndex::Query query;
+        if (cuisine >= 0) {
+            query.cuisine(static_cast<Dish::CuisineType>(cuisine));
+        }
+        if (course >= 0) {
+            query.course(static_cast<MenuIndex::Course>(course));
+        }
+        if (vegetarian != 0) {
+            query.vegetarian(vegetarian == 1);
+        }
+        if (has_price) {
+            query.priceBetween(price_low, price_high);
+        }
+        if (has_prep_time) {
+            query.prepTimeBetween(prep_low, prep_high);
+        }
+        if (has_spiciness) {
+            query.spicinessBetween(spicy_low, spicy_high);
+        }
+        return query;
+    }
+};
+
+const char* CUISINES[] = {"ITALIAN", "MEXICAN", "CHINESE", "INDIAN", "AMERICAN", "FRENCH", "OTHER"};
+
+bool matches(const Dish* dish, const Filter& filter) {
+    if (filter.cuisine >= 0 && dish->getCuisineType() != CUISINES[filter.cuisine]) {
+        return false;
+    }
+    const Appetizer* appetizer = dynamic_cast<const Appetizer*>(dish);
+    int course = appetizer != nullptr ? MenuIndex::APPETIZER
+               : dynamic_cast<const MainCourse*>(dish) != nullptr ? MenuIndex::MAIN_COURSE
+               : dynamic_cast<const Dessert*>(dish) != nullptr ? MenuIndex::DESSERT : MenuIndex::OTHER_COURSE;
+    if (filter.course >= 0 && course != filter.course) {
+        return false;
+    }
+    if (filter.vegetarian != 0 && (appetizer == nullptr || appetizer->isVegetarian() != (filter.vegetarian == 1))) {
+        return false;
+    }
+    if (filter.has_price) {
+        long cents = std::llround(dish->getPrice() * 100.0);
+        if (cents < std::llround(filter.price_low * 100.0) || cents > std::llround(filter.price_high * 100.0)) {
+            return false;
+        }
+    }
+    if (filter.has_prep_time && (dish->getPrepTime() < filter.prep_low || dish->getPrepTime() > filter.prep_high)) {
+        return false;
+    }
+    if (filter.has_spiciness && (appetizer == nullptr || appetizer->getSpicinessLevel() < filter.spicy_low ||
+                                 appetizer->getSpicinessLevel() > filter.spicy_high)) {
+        return false;
+    }
+    return true;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+}
+
+int main(int argc, char* argv[]) {
+    size_t dish_count = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    size_t query_count = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 2000;
+
+    std::mt19937 random(42);
+    std::vector<Dish*> dishes;
+    dishes.reserve(dish_count);
+    std::vector<Ingredient> recipe = {Ingredient("Salt", 1, 1, 0.1)};
+    for (size_t i = 0; i < dish_count; ++i) {
+        std::string name = "Dish " + std::to_string(i);
+        int prep_time = 5 + random() % 56;
+        double price = (100 + random() % 4900) / 100.0;
+        Dish::CuisineType cuisine = static_cast<Dish::CuisineType>(random() % (Dish::OTHER + 1));
+        switch (random() % 3) {
+            case 0:
+                dishes.push_back(new Appetizer(name, recipe, prep_time, price, cuisine, Appetizer::PLATED,
+                                               random() % 11, random() % 2 == 0));
+                break;
+            case 1:
+                dishes.push_back(new MainCourse(name, recipe, prep_time, price, cuisine, MainCourse::GRILLED,
+                                                "Chicken", {}, random() % 2 == 0));
+                break;
+            default:
+                dishes.push_back(new Dessert(name, recipe, prep_time, price, cuisine, Dessert::SWEET,
+                                             random() % 11, random() % 2 == 0));
+                break;
+        }
+    }
+
+    std::vector<Filter> filters(query_count);
+    for (Filter& filter : filters) {
+        filter.cuisine = random() % 2 == 0 ? static_cast<int>(random() % (Dish::OTHER + 1)) : -1;
+        filter.course = random() % 3 == 0 ? static_cast<int>(random() % 3) : -1;
+        filter.vegetarian = random() % 4 == 0 ? 1 + random() % 2 : 0;
+        filter.has_price = random() % 2 == 0;
+        filter.price_low = (100 + random() % 2500) / 100.0;
+        filter.price_high = filter.price_low + (random() % 2500) / 100.0;
+        filter.has_prep_time = random() % 2 == 0;
+        filter.prep_low = 5 + random() % 30;
+        filter.prep_high = filter.prep_low + random() % 30;
+        filter.has_spiciness = random() % 4 == 0;
+        filter.spicy_low = random() % 6;
+        filter.spicy_high = filter.spicy_low + random() % 6;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<size_t> scan_counts;
+    scan_counts.reserve(query_count);
+    for (const Filter& filter : filters) {
+        size_t count = 0;
+        for (const Dish* dish : dishes) {
+            count += matches(dish, filter);
+        }
+        scan_counts.push_back(count);
+    }
+    double scan_seconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    MenuIndex index(dishes);
+    double build_seconds = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t mismatches = 0;
+    size_t total_matches = 0;
+    for (size_t i = 0; i < query_count; ++i) {
+        size_t count = index.select(filters[i].toQuery()).size();
+        total_matches += count;
+        mismatches += count != scan_counts[i];
+    }
+    double index_seconds = secondsSince(start);
+
+    std::printf("%zu dishes, %zu queries, %.1f matches per query\n", dish_count, query_count,
+                query_count > 0 ? static_cast<double>(total_matches) / query_count : 0.0);
+    std::printf("linear scan: %10.0f queries/s\n", query_count / scan_seconds);
+    std::printf("menu index:  %10.0f queries/s (build %.1f ms)\n", query_count / index_seconds, build_seconds * 1000);
+    std::printf("mismatched results: %zu\n", mismatches);
+
+    for (Dish* dish : dishes) {
+        delete dish;
+    }
+    return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,164 @@
+/**
+ * @file mise_bench.cpp
+ * @brief Simulated-time evaluation of mise-en-place planning.
+ *
+ * Usage: mise_bench [peak_minutes] [seed]
+ *        (defaults: 60 1)
+ *
+ * One line cook serves pasta, lasagna and a chicken plate with a rice side. Tomato sauce and rice
+ * are sub-recipes made in batches; each batch run costs a fixed setup time plus a time per batch.
+ * Orders arrive at random, slowly for two hours and then quickly for the peak. The same order
+ * stream is served twice on a simulated clock: once making batches on demand, in the middle of
+ * an order, and once with StationManager::runMiseEnPlace() called whenever the cook is idle at a
+ * planning tick. The benchmark reports order latency (arrival to plate) before and during the
+ * peak, and the batch runs made during service.
+ */
+
+#include "StationManager.hpp"
+#include "Appetizer.hpp"
+#include "MainCourse.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+const int64_t DISH_SECONDS = 90;        // plating one order
+const int64_t SETUP_SECONDS = 240;      // starting a batch run: pots, mise, cleanup
+const int64_t BATCH_SECONDS = 60;       // each batch in a run
+const int64_t TICK_SECONDS = 300;       // how often the planner may run
+const int HORIZON_MINUTES = 30;
+const int64_t OFF_PEAK_SECONDS = 2 * 3600;
+
+struct Order {
+    int64_t arrival;   // seconds
+    int dish;
+};
+
+struct Latency {
+    std::vector<double> off_peak;
+    std::vector<double> peak;
+    unsigned long service_runs;   // batch runs made while an order waited
+    unsigned long planned_runs;
+    long failed;
+};
+
+std::vector<Order> makeOrders(int peak_minutes, unsigned seed) {
+    std::mt19937 random(seed);
+    std::exponential_distribution<double> off_peak(1.0 / 240.0);   // one order every 4 minutes
+    std::exponential_distribution<double> peak(1.0 / 110.0);       // one order every 110 seconds
+    std::uniform_int_distribution<int> dish(0, 2);
+    std::vector<Order> orders;
+    double t = 0.0;
+    int64_t end = OFF_PEAK_SECONDS + peak_minutes * 60;
+    while (true) {
+        t += t < OFF_PEAK_SECONDS ? off_peak(random) : peak(random);
+        if (t >= end) {
+            break;
+        }
+        orders.push_back(Order{static_cast<int64_t>(t), dish(random)});
+    }
+    return orders;
+}
+
+Latency simulate(const std::vector<Order>& orders, bool plan) {
+    int64_t now_ms = 0;
+    StationManager manager;
+    manager.setClock([&now_ms]() { return now_ms; });
+    RecipeBook& book = manager.getRecipeBook();
+    book.addRecipe("Tomato Sauce", {Ingredient("Tomato", 0, 6, 0.25), Ingredient("Garlic", 0, 1, 0.10)}, 8);
+    book.addRecipe("Rice", {Ingredient("Rice Grain", 0, 2, 0.20)}, 6);
+
+    KitchenStation* station = new KitchenStation("Line");
+    manager.addStation(station);
+    manager.assignDishToStation("Line", new Appetizer("Pasta", {Ingredient("Spaghetti", 0, 1, 1.5), Ingredient("Tomato Sauce", 0, 1, 0.0)},
+        8, 12.99, Dish::ITALIAN, Appetizer::PLATED, 1, true));
+    manager.assignDishToStation("Line", new Appetizer("Lasagna", {Ingredient("Noodles", 0, 1, 1.0), Ingredient("Tomato Sauce", 0, 2, 0.0)},
+        10, 14.99, Dish::ITALIAN, Appetizer::PLATED, 1, false));
+    manager.assignDishToStation("Line", new MainCourse("Chicken Plate", {Ingredient("Chicken", 0, 1, 2.0)},
+        12, 15.99, Dish::AMERICAN, MainCourse::GRILLED, "Chicken", {{"Rice", MainCourse::GRAIN}}, true));
+    for (const char* name : {"Tomato", "Garlic", "Rice Grain", "Spaghetti", "Noodles", "Chicken"}) {
+        manager.replenishIngredientAtStation("Line", Ingredient(name, 100000, 0, 0.5));
+    }
+    const char* dish_names[] = {"Pasta", "Lasagna", "Chicken Plate"};
+    std::vector<Dish*> menu;
+    for (const char* name : dish_names) {
+        for (Dish* dish : station->getDishes()) {
+            if (dish->getName() == name) {
+                menu.push_back(dish);
+            }
+        }
+    }
+
+    Latency latency{{}, {}, 0, 0, 0};
+    int64_t free_at = 0;   // when the cook finishes the current work
+    int64_t next_tick = TICK_SECONDS;
+    for (const Order& order : orders) {
+        while (plan && next_tick <= order.arrival) { // Planning ticks before this order arrives
+            if (free_at <= next_tick) {
+                now_ms = next_tick * 1000;
+                unsigned long runs_before = manager.getBatchRunCount();
+                int batches = manager.runMiseEnPlace(HORIZON_MINUTES);
+                unsigned long runs = manager.getBatchRunCount() - runs_before;
+                latency.planned_runs += runs;
+                free_at = next_tick + static_cast<int64_t>(runs) * SETUP_SECONDS + batches * BATCH_SECONDS;
+            }
+            next_tick += TICK_SECONDS;
+        }
+
+        int64_t start = std::max(order.arrival, free_at);
+        now_ms = start * 1000;
+        unsigned long runs_before = manager.getBatchRunCount();
+        manager.addDishToQueue(menu[order.dish]);
+        if (!manager.prepareNextDish()) {
+            manager.clearDishQueue();
+            ++latency.failed;
+        }
+        unsigned long runs = manager.getBatchRunCount() - runs_before;   // On-demand runs make one batch
+        latency.service_runs += runs;
+        free_at = start + DISH_SECONDS + static_cast<int64_t>(runs) * (SETUP_SECONDS + BATCH_SECONDS);
+        double seconds = static_cast<double>(free_at - order.arrival);
+        (order.arrival < OFF_PEAK_SECONDS ? latency.off_peak : latency.peak).push_back(seconds);
+    }
+    return latency;
+}
+
+void report(const char* label, const char* phase, std::vector<double> seconds) {
+    if (seconds.empty()) {
+        return;
+    }
+    std::sort(seconds.begin(), seconds.end());
+    double total = 0.0;
+    for (double s : seconds) {
+        total += s;
+    }
+    size_t p95 = std::min(seconds.size() - 1, static_cast<size_t>(std::ceil(seconds.size() * 0.95)) - 1);
+    std::printf("%-12s %-9s %5zu orders  mean %6.1f s  p95 %6.1f s  max %6.1f s\n", label, phase, seconds.size(),
+                total / seconds.size(), seconds[p95], seconds.back());
+}
+}
+
+int main(int argc, char* argv[]) {
+    int peak_minutes = argc > 1 ? std::atoi(argv[1]) : 60;
+    unsigned seed = argc > 2 ? static_cast<unsigned>(std::atoi(argv[2])) : 1;
+    if (peak_minutes < 1) {
+        std::fprintf(stderr, "usage: mise_bench [peak_minutes] [seed]\n");
+        return 1;
+    }
+    std::vector<Order> orders = makeOrders(peak_minutes, seed);
+    std::printf("%zu orders, %d peak minutes; batch run %llds setup + %llds per batch, %llds per order\n",
+                orders.size(), peak_minutes, static_cast<long long>(SETUP_SECONDS), static_cast<long long>(BATCH_SECONDS),
+                static_cast<long long>(DISH_SECONDS));
+
+    Latency on_demand = simulate(orders, false);
+    Latency planned = simulate(orders, true);
+    report("on demand", "off-peak", on_demand.off_peak);
+    report("on demand", "peak", on_demand.peak);
+    report("mise", "off-peak", planned.off_peak);
+    report("mise", "peak", planned.peak);
+    std::printf("batch runs during service: on demand %lu, mise %lu (+%lu planned ahead); failed orders %ld / %ld\n",
+                on_demand.service_runs, planned.service_runs, planned.planned_runs, on_demand.failed, planned.failed);
+    return 0;
+}
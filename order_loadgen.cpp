@@ -0,0 +1,170 @@
+/**
+ * @file order_loadgen.cpp
+ * @brief Open-loop load generator for the order server.
+ *
+ * Usage: order_loadgen [socket_path] [orders_per_second] [seconds] [connections]
+ *        (defaults: /tmp/bistro.sock 100000 5 4)
+ *
+ * Orders are sent on a fixed schedule regardless of how fast answers come back, spread round robin
+ * over the connections and pipelined on each of them. Latency is measured from the scheduled send
+ * time to the arrival of the matching answer, so queueing delay inside the client is included.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+typedef std::chrono::steady_clock Clock;
+
+const char* DISHES[] = {"Grilled Chicken", "Chicken Wings", "Spaghetti Bolognese", "Bruschetta", "Tiramisu"};
+const int DISH_COUNT = sizeof(DISHES) / sizeof(DISHES[0]);
+
+struct Client {
+    int fd;
+    std::string out;
+    std::string in;
+    std::deque<Clock::time_point> sent;   // scheduled send time of every unanswered order
+};
+
+int connectTo(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0 || connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0) {
+        if (fd >= 0) {
+            close(fd);
+        }
+        return -1;
+    }
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+    return fd;
+}
+
+void flush(Client& client) {
+    while (!client.out.empty()) {
+        ssize_t count = write(client.fd, client.out.data(), client.out.size());
+        if (count <= 0) {
+            return;
+        }
+        client.out.erase(0, count);
+    }
+}
+
+double percentile(std::vector<double>& sorted, double p) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t index = static_cast<size_t>(p * (sorted.size() - 1));
+    return sorted[index];
+}
+}
+
+int main(int argc, char* argv[]) {
+    std::string path = argc > 1 ? argv[1] : "/tmp/bistro.sock";
+    double rate = argc > 2 ? std::atof(argv[2]) : 100000.0;
+    double seconds = argc > 3 ? std::atof(argv[3]) : 5.0;
+    int connection_count = argc > 4 ? std::atoi(argv[4]) : 4;
+    if (rate <= 0 || seconds <= 0 || connection_count <= 0) {
+        std::cerr << "usage: order_loadgen [socket_path] [orders_per_second] [seconds] [connections]" << std::endl;
+        return 2;
+    }
+
+    std::vector<Client> clients(connection_count);
+    int epoll_fd = epoll_create1(0);
+    for (int i = 0; i < connection_count; ++i) {
+        clients[i].fd = connectTo(path);
+        if (clients[i].fd < 0) {
+            std::perror("order_loadgen: connect");
+            return 1;
+        }
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.u32 = i;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, clients[i].fd, &event);
+    }
+
+    const long total = static_cast<long>(rate * seconds);
+    const std::chrono::duration<double> interval(1.0 / rate);
+    std::vector<double> latencies_us;
+    latencies_us.reserve(total);
+    long scheduled = 0;
+    long answered = 0;
+    long failed = 0;
+    Clock::time_point start = Clock::now();
+    Clock::time_point give_up = start + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(seconds + 10.0));
+    epoll_event events[64];
+
+    while (answered < total && Clock::now() < give_up) {
+        // Send every order whose scheduled time has passed
+        Clock::time_point now = Clock::now();
+        long due = std::min(total, static_cast<long>((now - start) / interval) + 1);
+        for (; scheduled < due; ++scheduled) {
+            Client& client = clients[scheduled % connection_count];
+            client.out += "ORDER ";
+            client.out += DISHES[scheduled % DISH_COUNT];
+            client.out += '\n';
+            client.sent.push_back(start + std::chrono::duration_cast<Clock::duration>(interval * scheduled));
+        }
+        for (Client& client : clients) {
+            flush(client);
+        }
+
+        // Collect answers; wake up at least every millisecond to keep the schedule
+        int ready = epoll_wait(epoll_fd, events, 64, 1);
+        for (int i = 0; i < ready; ++i) {
+            Client& client = clients[events[i].data.u32];
+            char buffer[65536];
+            ssize_t count;
+            while ((count = read(client.fd, buffer, sizeof(buffer))) > 0) {
+                client.in.append(buffer, count);
+            }
+            Clock::time_point received = Clock::now();
+            size_t begin = 0;
+            size_t end;
+            while ((end = client.in.find('\n', begin)) != std::string::npos) {
+                if (client.in.compare(begin, 3, "OK ") != 0) {
+                    ++failed;
+                }
+                if (!client.sent.empty()) {
+                    latencies_us.push_back(std::chrono::duration<double, std::micro>(received - client.sent.front()).count());
+                    client.sent.pop_front();
+                }
+                ++answered;
+                begin = end + 1;
+            }
+            client.in.erase(0, begin);
+        }
+    }
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::sort(latencies_us.begin(), latencies_us.end());
+    std::printf("orders sent:     %ld\n", scheduled);
+    std::printf("orders answered: %ld (%ld not OK)\n", answered, failed);
+    std::printf("throughput:      %.0f orders/s (target %.0f)\n", answered / elapsed, rate);
+    std::printf("latency p50:     %.1f us\n", percentile(latencies_us, 0.50));
+    std::printf("latency p99:     %.1f us\n", percentile(latencies_us, 0.99));
+    std::printf("latency p99.9:   %.1f us\n", percentile(latencies_us, 0.999));
+    std::printf("latency max:     %.1f us\n", latencies_us.empty() ? 0.0 : latencies_us.back());
+
+    for (Client& client : clients) {
+        close(client.fd);
+    }
+    close(epoll_fd);
+    return answered == total ? 0 : 1;
+}
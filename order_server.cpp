@@ -0,0 +1,49 @@
+/**
+ * @file order_server.cpp
+ * @brief Runs an OrderServer around a demo kitchen.
+ *
+ * Usage: order_server [socket_path] [queue_capacity]   (defaults: /tmp/bistro.sock 65536)
+ *
+ * The demo kitchen (see DemoKitchen) has a pantry large enough that load tests do not run it
+ * dry. Send SIGINT or SIGTERM to shut down.
+ */
+
+#include "OrderServer.hpp"
+#include "DemoKitchen.hpp"
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+static OrderServer* running_server = nullptr;
+
+static void handleSignal(int) {
+    if (running_server != nullptr) {
+        running_server->stop();
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string socket_path = argc > 1 ? argv[1] : "/tmp/bistro.sock";
+
+    size_t queue_capacity = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 65536;
+
+    DemoKitchen kitchen;
+    kitchen.getManager().setQueueCapacity(queue_capacity);
+    OrderServer server(kitchen.getManager(), socket_path);
+    if (!server.start()) {
+        std::perror("order_server");
+        return 1;
+    }
+    running_server = &server;
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::cout << "Listening on " << socket_path << std::endl;
+    server.run();
+    std::cout << "Served " << server.getOrdersServed() << " orders." << std::endl;
+
+    running_server = nullptr;
+    return 0;
+}
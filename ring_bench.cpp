@@ -0,0 +1,157 @@
+/**
+ * @file ring_bench.cpp
+ * @brief Cross-process latency benchmark for the shared-memory order rings.
+ *
+ * Usage: ring_bench [clients] [orders_per_client] [orders_per_second_per_client]
+ *        (defaults: 4 250000 50000; a rate of 0 pushes as fast as the ring allows)
+ *
+ * Each client is a forked process that attaches to its own ring by name and pushes timestamped
+ * orders. The parent runs the dispatch loop (drain, processAllDishes, retire) and reports the time
+ * from the client's timestamp to intake (drain) and to the end of preparation, and the heap
+ * allocations per order of each of the two phases.
+ */
+
+#include "AllocationCounter.hpp"
+#include "DemoKitchen.hpp"
+#include "OrderRingIntake.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <sched.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+void runClient(const std::string& ring_name, long orders, double rate, uint32_t menu_size) {
+    OrderRing* ring = OrderRing::attach(ring_name);
+    if (ring == nullptr) {
+        std::perror("ring_bench: attach");
+        _exit(1);
+    }
+    uint64_t start = monotonicNanos();
+    double interval_ns = rate > 0 ? 1e9 / rate : 0.0;
+    for (long i = 0; i < orders; ++i) {
+        if (interval_ns > 0) {
+            uint64_t due = start + static_cast<uint64_t>(interval_ns * i);
+            if (monotonicNanos() < due) {
+                timespec wake{static_cast<time_t>(due / 1000000000ull), static_cast<long>(due % 1000000000ull)};
+                clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake, nullptr);
+            }
+        }
+        OrderRecord record{static_cast<uint32_t>(i % menu_size), 0, monotonicNanos()};
+        while (!ring->push(record)) {
+            sched_yield();
+            record.timestamp_ns = monotonicNanos(); // Ring full: the order is placed once it fits
+        }
+    }
+    delete ring;
+    _exit(0);
+}
+
+double percentile(std::vector<double>& sorted, double p) {
+    return sorted.empty() ? 0.0 : sorted[static_cast<size_t>(p * (sorted.size() - 1))];
+}
+
+void report(const char* label, std::vector<double>& latencies_us) {
+    std::sort(latencies_us.begin(), latencies_us.end());
+    std::printf("%-22s p50 %8.2f us   p99 %8.2f us   p99.9 %8.2f us   max %8.2f us\n", label,
+                percentile(latencies_us, 0.50), percentile(latencies_us, 0.99),
+                percentile(latencies_us, 0.999), latencies_us.empty() ? 0.0 : latencies_us.back());
+}
+}
+
+int main(int argc, char* argv[]) {
+    int clients = argc > 1 ? std::atoi(argv[1]) : 4;
+    long orders_per_client = argc > 2 ? std::atol(argv[2]) : 250000;
+    double rate = argc > 3 ? std::atof(argv[3]) : 50000.0;
+    if (clients <= 0 || orders_per_client <= 0 || rate < 0) {
+        std::fprintf(stderr, "usage: ring_bench [clients] [orders_per_client] [orders_per_second_per_client]\n");
+        return 2;
+    }
+
+    DemoKitchen kitchen;
+    StationManager& manager = kitchen.getManager();
+    OrderRingIntake intake(manager);
+    uint32_t menu_size = manager.getMenu().size();
+
+    std::vector<OrderRing*> rings;
+    for (int i = 0; i < clients; ++i) {
+        std::string name = "/bistro-ring-bench-" + std::to_string(getpid()) + "-" + std::to_string(i);
+        OrderRing* ring = OrderRing::create(name, 4096);
+        if (ring == nullptr) {
+            std::perror("ring_bench: create");
+            return 1;
+        }
+        rings.push_back(ring);
+        intake.addRing(ring);
+    }
+
+    std::vector<pid_t> children;
+    for (int i = 0; i < clients; ++i) {
+        pid_t pid = fork();
+        if (pid == 0) {
+            runClient(rings[i]->getName(), orders_per_client, rate, menu_size);
+        }
+        children.push_back(pid);
+    }
+
+    const long total = clients * orders_per_client;
+    std::vector<double> intake_us;
+    std::vector<double> prepared_us;
+    intake_us.reserve(total);
+    prepared_us.reserve(total);
+    std::vector<uint64_t> timestamps;
+    std::vector<bool> results;
+    std::ostream discard(nullptr);
+    long received = 0;
+    long failed = 0;
+    uint64_t intake_allocations = 0;
+    uint64_t dispatch_allocations = 0;
+    uint64_t start = monotonicNanos();
+
+    while (received < total) {
+        timestamps.clear();
+        AllocationCounter counter;
+        size_t queued = intake.drain(&timestamps);
+        if (queued == 0) {
+            sched_yield(); // Leave the CPU to the clients when the host is oversubscribed
+            continue;
+        }
+        intake_allocations += counter.getAllocations();
+        uint64_t drained_at = monotonicNanos();
+        results.clear();
+        counter.restart();
+        manager.processAllDishes(discard, &results);
+        dispatch_allocations += counter.getAllocations();
+        intake.retire(results);
+        manager.clearDishQueue(); // A failed order is dropped; the queue owns its copy
+        uint64_t prepared_at = monotonicNanos();
+        for (size_t i = 0; i < queued; ++i) {
+            intake_us.push_back((drained_at - timestamps[i]) / 1000.0);
+            prepared_us.push_back((prepared_at - timestamps[i]) / 1000.0);
+            failed += results[i] ? 0 : 1;
+        }
+        received += queued;
+    }
+    double elapsed = (monotonicNanos() - start) / 1e9;
+
+    for (pid_t pid : children) {
+        waitpid(pid, nullptr, 0);
+    }
+    for (OrderRing* ring : rings) {
+        delete ring;
+    }
+
+    std::printf("clients:   %d x %ld orders at %s\n", clients, orders_per_client,
+                rate > 0 ? (std::to_string(static_cast<long>(rate)) + " orders/s each").c_str() : "full speed");
+    std::printf("processed: %ld orders in %.2f s (%.0f orders/s, %ld not prepared)\n", received, elapsed,
+                received / elapsed, failed);
+    report("client -> intake", intake_us);
+    report("client -> prepared", prepared_us);
+    std::printf("allocations/order: intake %.3f, dispatch %.3f\n", static_cast<double>(intake_allocations) / received,
+                static_cast<double>(dispatch_allocations) / received);
+    return 0;
+}
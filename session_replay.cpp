@@ -0,0 +1,123 @@
+/**
+ * @file session_replay.cpp
+ * @brief Records a dispatch session to a trace file, or replays a trace as a benchmark and an
+ * equivalence test.
+ *
+ * Usage: session_replay record <trace> [orders] [batch]
+ *        (defaults: 100000 256)
+ *        session_replay replay <trace> [threads] [repeats]
+ *        (defaults: 4 3)
+ *
+ * record attaches a SessionRecorder to the demo kitchen, queues the menu in batches and dispatches
+ * each batch, topping the pantry up every 16 batches, then saves the trace with its final
+ * checksum. replay decodes the trace, replays it `repeats` times on one thread and `repeats` times
+ * on `threads` threads at once, and prints the calls per second of each. Every replay must end with
+ * the recorded checksum; exits with status 1 if one does not.
+ */
+
+#include "DemoKitchen.hpp"
+#include "SessionTrace.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace {
+int record(const char* path, long orders, long batch) {
+    DemoKitchen kitchen;
+    StationManager& manager = kitchen.getManager();
+    std::vector<Dish*> menu = manager.getMenu();
+    const char* pantry[] = {"Chicken", "Spices", "Spaghetti", "Tomato Sauce", "Beef", "Bread", "Tomato",
+                            "Mascarpone", "Coffee", "Ladyfingers"};
+    SessionRecorder recorder(manager);
+    NullEventSink events;
+    long batches = 0;
+    for (long base = 0; base < orders; base += batch) {
+        for (long i = base; i < base + batch && i < orders; ++i) {
+            recorder.addDishToQueue(menu[i % menu.size()]);
+        }
+        recorder.processAllDishes(events);
+        if (++batches % 16 == 0) {
+            for (const char* ingredient : pantry) {
+                recorder.addBackupIngredient(Ingredient(ingredient, static_cast<int>(batch), 0, 1.0));
+            }
+        }
+    }
+    uint64_t checksum = recorder.finish();
+    if (!recorder.save(path)) {
+        std::fprintf(stderr, "cannot write %s\n", path);
+        return 2;
+    }
+    std::printf("recorded %zu calls, %zu bytes (%.2f bytes/call), checksum %016llx\n", recorder.getCallCount(),
+                recorder.getTrace().size(), static_cast<double>(recorder.getTrace().size()) / recorder.getCallCount(),
+                static_cast<unsigned long long>(checksum));
+    return 0;
+}
+
+int replay(const char* path, int threads, int repeats) {
+    std::unique_ptr<SessionReplayer> replayer(SessionReplayer::load(path));
+    if (!replayer) {
+        std::fprintf(stderr, "cannot read %s, or it is not a session trace\n", path);
+        return 2;
+    }
+    if (!replayer->hasExpectedChecksum()) {
+        std::printf("trace has no checksum; replay results are not checked\n");
+    }
+    uint64_t expected = replayer->getExpectedChecksum();
+    bool matched = true;
+    auto check = [&](uint64_t checksum) {
+        if (replayer->hasExpectedChecksum() && checksum != expected) {
+            std::printf("MISMATCH: replay ended with %016llx, trace recorded %016llx\n",
+                        static_cast<unsigned long long>(checksum), static_cast<unsigned long long>(expected));
+            matched = false;
+        }
+    };
+
+    double calls = static_cast<double>(replayer->getCallCount());
+    NullEventSink events;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i) {
+        check(replayer->replay(events));
+    }
+    double serial = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%.0f calls x %d: %.0f calls/s on 1 thread\n", calls, repeats, calls * repeats / serial);
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats; ++i) {
+        for (uint64_t checksum : replayer->replayParallel(threads)) {
+            check(checksum);
+        }
+    }
+    double parallel = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%.0f calls x %d x %d: %.0f calls/s on %d threads\n", calls, repeats, threads,
+                calls * repeats * threads / parallel, threads);
+
+    if (!matched) {
+        return 1;
+    }
+    std::printf(replayer->hasExpectedChecksum() ? "PASS: every replay matched checksum %016llx\n" : "done\n",
+                static_cast<unsigned long long>(expected));
+    return 0;
+}
+}
+
+int main(int argc, char* argv[]) {
+    if (argc >= 3 && std::strcmp(argv[1], "record") == 0) {
+        long orders = argc > 3 ? std::atol(argv[3]) : 100000;
+        long batch = argc > 4 ? std::atol(argv[4]) : 256;
+        if (orders >= 1 && batch >= 1) {
+            return record(argv[2], orders, batch);
+        }
+    } else if (argc >= 3 && std::strcmp(argv[1], "replay") == 0) {
+        int threads = argc > 3 ? std::atoi(argv[3]) : 4;
+        int repeats = argc > 4 ? std::atoi(argv[4]) : 3;
+        if (threads >= 1 && repeats >= 1) {
+            return replay(argv[2], threads, repeats);
+        }
+    }
+    std::fprintf(stderr, "usage: session_replay record <trace> [orders] [batch]\n"
+                         "       session_replay replay <trace> [threads] [repeats]\n");
+    return 2;
+}
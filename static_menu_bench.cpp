@@ -0,0 +1,173 @@
+/**
+ * @file static_menu_bench.cpp
+ * @brief Compares building the demo kitchen with runtime constructor calls against installing the
+ * same menu from compile-time StaticMenu tables.
+ *
+ * Usage: static_menu_bench [kitchens] [orders]
+ *        (defaults: 20000 1000)
+ *
+ * Builds `kitchens` kitchens each way (stations, dishes and a stocked pantry) and prints the time
+ * and heap allocations per kitchen. Then dispatches the same `orders` orders in one kitchen of each
+ * kind and compares the final state with stateChecksum() and the revenue, and each dish's course
+ * fields (serving style, gluten-free, sweetness, ...); exits with status 1 if they differ. The static_asserts below check the menu itself at compile time.
+ */
+
+#include "AllocationCounter.hpp"
+#include "DemoKitchen.hpp"
+#include "SessionTrace.hpp"
+#include "StaticMenu.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+const int PANTRY_UNITS = 1 << 30;   // As DemoKitchen
+
+// The demo kitchen's menu, as DemoKitchen.cpp builds it at runtime
+constexpr auto DEMO_MENU = StaticMenu<10, 3, 5, 12, 5>()
+    .ingredient("Chicken", 100)
+    .ingredient("Spices", 100)
+    .ingredient("Spaghetti", 100)
+    .ingredient("Tomato Sauce", 100)
+    .ingredient("Beef", 100)
+    .ingredient("Bread", 100)
+    .ingredient("Tomato", 100)
+    .ingredient("Mascarpone", 100)
+    .ingredient("Coffee", 100)
+    .ingredient("Ladyfingers", 100)
+    .station("Grill Station")
+    .station("Pasta Station")
+    .station("Pastry Station")
+    .dish("Grilled Chicken", StaticDish::MAIN_COURSE, Dish::AMERICAN, 15, 1099)
+        .mainCourse(MainCourse::GRILLED, "Chicken", false)
+        .uses("Chicken", 1).uses("Spices", 1)
+    .dish("Chicken Wings", StaticDish::APPETIZER, Dish::AMERICAN, 10, 799)
+        .appetizer(Appetizer::FAMILY_STYLE, 3, false)
+        .uses("Chicken", 2).uses("Spices", 1)
+    .dish("Spaghetti Bolognese", StaticDish::MAIN_COURSE, Dish::ITALIAN, 20, 1299)
+        .mainCourse(MainCourse::BOILED, "Beef", false)
+        .uses("Spaghetti", 1).uses("Tomato Sauce", 1).uses("Beef", 1)
+    .dish("Bruschetta", StaticDish::APPETIZER, Dish::ITALIAN, 5, 649)
+        .appetizer(Appetizer::PLATED, 0, true)
+        .uses("Bread", 1).uses("Tomato", 2)
+    .dish("Tiramisu", StaticDish::DESSERT, Dish::ITALIAN, 30, 849)
+        .dessert(Dessert::SWEET, 7, false)
+        .uses("Mascarpone", 1).uses("Coffee", 1).uses("Ladyfingers", 4)
+    .serve("Grill Station", "Grilled Chicken")
+    .serve("Grill Station", "Chicken Wings")
+    .serve("Pasta Station", "Spaghetti Bolognese")
+    .serve("Pasta Station", "Bruschetta")
+    .serve("Pastry Station", "Tiramisu");
+
+static_assert(DEMO_MENU.getDishCount() == 5 && DEMO_MENU.getLineCount() == 12, "demo menu tables are full");
+static_assert(DEMO_MENU.findDish("Tiramisu") == 4, "names resolve at compile time");
+static_assert(DEMO_MENU.getRecipeCostCents("Tiramisu") == 600, "recipe costs evaluate at compile time");
+static_assert(DEMO_MENU.view().dishes[3].flag, "Bruschetta is vegetarian");
+
+/**
+ * A kitchen installed from DEMO_MENU, stocked like DemoKitchen.
+ */
+class StaticKitchen {
+public:
+    StaticKitchen() : stations_(installStaticMenu(DEMO_MENU.view(), manager_)) {
+        StaticMenuView menu = DEMO_MENU.view();
+        for (size_t i = 0; i < menu.ingredient_count; ++i) {
+            manager_.addBackupIngredient(Ingredient(menu.ingredients[i].name, PANTRY_UNITS, 0,
+                                                    Money::fromCents(menu.ingredients[i].price_cents)));
+        }
+    }
+
+    ~StaticKitchen() {
+        for (KitchenStation* station : stations_) {
+            delete station;
+        }
+    }
+
+    StationManager& getManager() {
+        return manager_;
+    }
+
+private:
+    StationManager manager_;
+    std::vector<KitchenStation*> stations_;
+};
+
+template <typename Kitchen>
+void build(const char* label, int kitchens) {
+    AllocationCounter counter;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kitchens; ++i) {
+        Kitchen kitchen;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-22s %9.2f us/kitchen %9.1f allocations/kitchen %10.1f bytes/kitchen\n", label, 1e6 * seconds / kitchens,
+                static_cast<double>(counter.getAllocations()) / kitchens, static_cast<double>(counter.getBytes()) / kitchens);
+}
+
+// True if two dishes are the same course with the same course fields
+bool sameCourse(const Dish* a, const Dish* b) {
+    const Appetizer* appetizer_a = dynamic_cast<const Appetizer*>(a);
+    const Appetizer* appetizer_b = dynamic_cast<const Appetizer*>(b);
+    const MainCourse* main_a = dynamic_cast<const MainCourse*>(a);
+    const MainCourse* main_b = dynamic_cast<const MainCourse*>(b);
+    const Dessert* dessert_a = dynamic_cast<const Dessert*>(a);
+    const Dessert* dessert_b = dynamic_cast<const Dessert*>(b);
+    if (appetizer_a != nullptr && appetizer_b != nullptr) {
+        return appetizer_a->getServingStyle() == appetizer_b->getServingStyle() &&
+               appetizer_a->getSpicinessLevel() == appetizer_b->getSpicinessLevel() &&
+               appetizer_a->isVegetarian() == appetizer_b->isVegetarian();
+    }
+    if (main_a != nullptr && main_b != nullptr) {
+        return main_a->getCookingMethod() == main_b->getCookingMethod() &&
+               main_a->getProteinType() == main_b->getProteinType() && main_a->isGlutenFree() == main_b->isGlutenFree();
+    }
+    if (dessert_a != nullptr && dessert_b != nullptr) {
+        return dessert_a->getFlavorProfile() == dessert_b->getFlavorProfile() &&
+               dessert_a->getSweetnessLevel() == dessert_b->getSweetnessLevel() &&
+               dessert_a->containsNuts() == dessert_b->containsNuts();
+    }
+    return false;
+}
+
+uint64_t dispatch(StationManager& manager, int orders) {
+    std::vector<Dish*> menu = manager.getMenu();
+    for (int i = 0; i < orders; ++i) {
+        manager.addDishToQueue(menu[i % menu.size()]);
+    }
+    NullEventSink events;
+    manager.processAllDishes(events);
+    return stateChecksum(manager);
+}
+}
+
+int main(int argc, char* argv[]) {
+    int kitchens = argc > 1 ? std::atoi(argv[1]) : 20000;
+    int orders = argc > 2 ? std::atoi(argv[2]) : 1000;
+    if (kitchens < 1 || orders < 1) {
+        std::fprintf(stderr, "usage: static_menu_bench [kitchens] [orders]\n");
+        return 2;
+    }
+
+    std::printf("static menu tables: %zu bytes of read-only data, built at compile time\n", sizeof(DEMO_MENU));
+    build<DemoKitchen>("runtime construction", kitchens);
+    build<StaticKitchen>("static menu install", kitchens);
+
+    DemoKitchen runtime;
+    StaticKitchen installed;
+    std::vector<Dish*> runtime_menu = runtime.getManager().getMenu();
+    std::vector<Dish*> installed_menu = installed.getManager().getMenu();
+    for (size_t i = 0; i < runtime_menu.size(); ++i) {
+        if (i >= installed_menu.size() || !sameCourse(runtime_menu[i], installed_menu[i])) {
+            std::printf("FAIL: the installed %s has other course fields than DemoKitchen's\n", runtime_menu[i]->getName().c_str());
+            return 1;
+        }
+    }
+    uint64_t expected = dispatch(runtime.getManager(), orders);
+    uint64_t actual = dispatch(installed.getManager(), orders);
+    if (actual != expected || installed.getManager().getRevenueCents() != runtime.getManager().getRevenueCents()) {
+        std::printf("FAIL: after %d orders the installed kitchen differs from DemoKitchen\n", orders);
+        return 1;
+    }
+    std::printf("PASS: after %d orders both kitchens have checksum %016llx\n", orders, static_cast<unsigned long long>(actual));
+    return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file substitution_bench.cpp
+ * @brief Fill-rate and latency benchmark for ingredient substitution.
+ *
+ * Usage: substitution_bench [orders] [pantry_units]
+ *        (defaults: 10000 1000)
+ *
+ * Runs the demo menu against a pantry that holds pantry_units of every ingredient, which is too
+ * little for the order stream, plus as much of some substitutes (Turkey, Tofu, Penne, Cream
+ * Cheese, and so on; Coffee has none). The same orders run once without and once with a
+ * substitution graph. A dish that cannot be prepared is dropped. The benchmark reports both fill
+ * rates and the time one SubstitutionGraph::resolve() call takes.
+ *
+ * It also checks a substitute the recipe already uses: {Chicken 2, Tofu 1} with Chicken -> Tofu
+ * must take all 3 Tofu, and fail with only 2. Exits with status 1 if it does not.
+ */
+
+#include "DemoKitchen.hpp"
+#include "Appetizer.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+void addSubstitutes(StationManager& manager, int pantry_units) {
+    const char* substitutes[] = {"Turkey", "Tofu", "Penne", "Cream Cheese", "Sourdough", "Paprika", "Marinara",
+                                 "Cherry Tomato", "Sponge Fingers"};
+    for (const char* substitute : substitutes) {
+        manager.addBackupIngredient(Ingredient(substitute, pantry_units, 0, 1.0));
+    }
+}
+
+void buildGraph(SubstitutionGraph& graph) {
+    graph.addSubstitution("Chicken", "Turkey", 1.0);
+    graph.addSubstitution("Chicken", "Tofu", 2.0);
+    graph.addSubstitution("Beef", "Turkey", 1.5);
+    graph.addSubstitution("Turkey", "Tofu", 0.5);
+    graph.addSubstitution("Spaghetti", "Penne", 0.5);
+    graph.addSubstitution("Mascarpone", "Cream Cheese", 1.0);
+    graph.addSubstitution("Bread", "Sourdough", 0.25);
+    graph.addSubstitution("Spices", "Paprika", 0.5);
+    graph.addSubstitution("Tomato Sauce", "Marinara", 0.25);
+    graph.addSubstitution("Tomato", "Cherry Tomato", 0.25);
+    graph.addSubstitution("Ladyfingers", "Sponge Fingers", 0.5);
+}
+
+// Prepares {Chicken 2, Tofu 1} with no Chicken, 1 Tofu at the station and backup_tofu in the backup;
+// returns whether it was prepared and sets the Tofu left in the kitchen
+bool prepareWithHeldSubstitute(int backup_tofu, long& tofu_left) {
+    StationManager manager;
+    KitchenStation* station = new KitchenStation("Wok Station");
+    manager.addStation(station);
+    station->assignDishToStation(new Appetizer("Tofu Chicken", {Ingredient("Chicken", 0, 2, 2.0), Ingredient("Tofu", 0, 1, 1.0)},
+                                               5, 6.5, Dish::OTHER, Appetizer::PLATED, 0, false));
+    station->replenishStationIngredients(Ingredient("Tofu", 1, 0, 1.0));
+    manager.addBackupIngredient(Ingredient("Tofu", backup_tofu, 0, 1.0));
+    manager.getSubstitutionGraph().addSubstitution("Chicken", "Tofu", 1.0);
+    manager.addDishToQueue(station->getDishes()[0]);
+    NullEventSink events;
+    std::vector<bool> results;
+    manager.processAllDishes(events, &results);
+    manager.setDishQueue(std::queue<Dish*>()); // The dish belongs to the station
+    tofu_left = manager.getTotalStock("Tofu");
+    manager.removeStation(station->getName());
+    delete station;
+    return results.size() == 1 && results[0];
+}
+
+double fillRate(long orders, int pantry_units, bool substitute, unsigned long& substituted) {
+    DemoKitchen kitchen(pantry_units);
+    StationManager& manager = kitchen.getManager();
+    addSubstitutes(manager, pantry_units);
+    if (substitute) {
+        buildGraph(manager.getSubstitutionGraph());
+    }
+    std::vector<Dish*> menu = manager.getMenu();
+    std::ostream discard(nullptr);
+    std::vector<bool> results;
+    const long BATCH = 256;
+    for (long base = 0; base < orders; base += BATCH) {
+        for (long i = base; i < base + BATCH && i < orders; ++i) {
+            manager.addDishToQueue(menu[i % menu.size()]);
+        }
+        manager.processAllDishes(discard, &results);
+        manager.setDishQueue(std::queue<Dish*>()); // A failed order is a lost sale
+    }
+    substituted = manager.getSubstitutedDishCount();
+    long prepared = 0;
+    for (bool result : results) {
+        prepared += result ? 1 : 0;
+    }
+    return 100.0 * prepared / orders;
+}
+}
+
+int main(int argc, char* argv[]) {
+    long orders = argc > 1 ? std::atol(argv[1]) : 10000;
+    int pantry_units = argc > 2 ? std::atoi(argv[2]) : 1000;
+    if (orders < 1 || pantry_units < 0) {
+        std::fprintf(stderr, "usage: substitution_bench [orders] [pantry_units]\n");
+        return 1;
+    }
+
+    unsigned long substituted = 0;
+    double without = fillRate(orders, pantry_units, false, substituted);
+    double with = fillRate(orders, pantry_units, true, substituted);
+    std::printf("%ld orders, %d pantry units per ingredient\n", orders, pantry_units);
+    std::printf("without substitutions  fill %6.2f%%\n", without);
+    std::printf("with substitutions     fill %6.2f%%  (%lu dishes used a substitute)\n", with, substituted);
+
+    // Resolution cost: Chicken Wings with no chicken, and only the second-choice substitute left
+    SubstitutionGraph graph;
+    buildGraph(graph);
+    IngredientRegistry& registry = IngredientRegistry::instance();
+    std::unordered_map<IngredientId, int> available;
+    available[registry.intern("Spices")] = 10;
+    available[registry.intern("Tofu")] = 10;
+    std::vector<Ingredient> recipe = {Ingredient("Chicken", 0, 2, 2.0), Ingredient("Spices", 0, 1, 0.5)};
+    std::vector<Ingredient> substituted_recipe;
+    std::vector<SubstitutionGraph::Substitution> made;
+    graph.resolve(recipe, available, substituted_recipe, made);
+    const int ROUNDS = 200000;
+    auto start = std::chrono::steady_clock::now();
+    int resolved = 0;
+    for (int i = 0; i < ROUNDS; ++i) {
+        resolved += graph.resolve(recipe, available, substituted_recipe, made) ? 1 : 0;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("resolve: %.2f us per recipe (%d/%d resolved, %s -> %s)\n", seconds * 1e6 / ROUNDS, resolved, ROUNDS,
+                made.empty() ? "-" : made[0].original.c_str(), made.empty() ? "-" : made[0].substitute.c_str());
+
+    long enough_left = 0;
+    long short_left = 0;
+    bool enough = prepareWithHeldSubstitute(2, enough_left);
+    bool too_few = prepareWithHeldSubstitute(1, short_left);
+    if (!enough || enough_left != 0 || too_few || short_left != 2) {
+        std::printf("FAIL: substitute already in the recipe (3 Tofu: prepared %d, %ld left; 2 Tofu: prepared %d, %ld left)\n",
+                    enough, enough_left, too_few, short_left);
+        return 1;
+    }
+    std::printf("PASS: a substitute already in the recipe takes its whole requirement\n");
+    return 0;
+}